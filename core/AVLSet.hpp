@@ -16,8 +16,16 @@
 #ifndef AVLSET_HPP
 #define AVLSET_HPP
 
+#include "Parallel.hpp"
+#include "Prefetch.hpp"
 #include "Set.hpp"
+#include "SortedRange.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
 #include <string>
+#include <utility>
+#include <vector>
 
 
 
@@ -34,9 +42,20 @@ public:
     // Initializes a new AVLSet to be a copy of an existing one.
     AVLSet(const AVLSet& s);
 
+    // Initializes a new AVLSet by taking over the nodes of an existing one,
+    // which is left empty.  No nodes are copied.
+    AVLSet(AVLSet&& s);
+
     // Assigns an existing AVLSet into another.
     AVLSet& operator=(const AVLSet& s);
 
+    // Moves the nodes of an existing AVLSet into another, in constant time.
+    AVLSet& operator=(AVLSet&& s);
+
+    // swap() exchanges the contents of two AVLSets in constant time, by
+    // exchanging their roots rather than any of their nodes.
+    void swap(AVLSet& s) noexcept;
+
     // isImplemented() should be modified to return true if you've
     // decided to implement an AVLSet, false otherwise.
     virtual bool isImplemented() const;
@@ -46,11 +65,77 @@ public:
     // when there are n elements in the AVL tree.
     virtual void add(const T& element);
 
+    // addAll() adds every element in the range [begin, end) to the set,
+    // using threadCount threads.  Each thread copies and sorts a slice of
+    // the range into a shard of its own; the shards (and the elements
+    // already in the set) are then merged pairwise, in parallel, into one
+    // sorted sequence without duplicates, from which a perfectly balanced
+    // tree is built in linear time.  This runs in O(m log m + n) time for
+    // m new elements and n existing ones, rather than m separate add()s.
+    template <typename RandomIt>
+    void addAll(RandomIt begin, RandomIt end, unsigned int threadCount = defaultThreadCount());
+
+    // unionWith() adds every element of other to the set, taking over its
+    // nodes rather than copying them, and leaves other empty.  It splits
+    // this tree around the root of other and joins the unions of the two
+    // halves back together, working on the halves in parallel while it
+    // has more than one of threadCount threads left.  For m elements in
+    // the smaller tree and n in the larger, this takes O(m log(n/m + 1))
+    // time, so merging a small set into a large one costs little more
+    // than m add()s would and merging two of a size costs linear time.
+    void unionWith(AVLSet&& other, unsigned int threadCount = defaultThreadCount());
+
+    // insertAll() adds every element in the range [begin, end) to the set,
+    // by building a balanced tree of them with addAll() and then merging
+    // it in with unionWith().  Unlike addAll(), it leaves the set's
+    // existing nodes where they are, so its cost depends on the size of
+    // the range much more than on the size of the set.
+    template <typename RandomIt>
+    void insertAll(RandomIt begin, RandomIt end, unsigned int threadCount = defaultThreadCount());
+
+    // buildFromSorted() replaces the contents of the set with the elements
+    // in the range [begin, end), which must be in ascending order; repeated
+    // elements are added once.  It counts the elements in one pass and
+    // builds a perfectly balanced tree from them in a second, so it runs
+    // in O(n) time and never rebalances.  If the range isn't in order, it
+    // throws an std::invalid_argument and leaves the set as it was.
+    template <typename ForwardIt>
+    void buildFromSorted(ForwardIt begin, ForwardIt end);
+
+    // dumpSorted() writes every element of the set to out, in ascending
+    // order, in O(n) time, and returns out past the last of them.  The
+    // elements can be given back to buildFromSorted() to restore the set.
+    template <typename OutputIt>
+    OutputIt dumpSorted(OutputIt out) const;
+
     // contains() returns true if the given element is already in the set,
     // false otherwise.  This function always runs in O(log n) time when
     // there are n elements in the AVL tree.
     virtual bool contains(const T& element) const;
 
+    // containsMany() looks up count elements at once, setting results[i]
+    // to whether elements[i] is in the set.  It works through them in
+    // groups, interleaving the steps of each group's lookups and
+    // prefetching the nodes they'll visit next, so that the cache misses
+    // of a group overlap rather than following one another.
+    void containsMany(const T* elements, unsigned int count, bool* results) const;
+
+    // containsSorted() looks up count elements at once, setting results[i]
+    // to whether elements[i] is in the set.  It's meant for elements in
+    // ascending order, which it checks in one pass with a Finger; any
+    // order gives the right answers, but nearby elements are the fastest.
+    void containsSorted(const T* elements, unsigned int count, bool* results) const;
+
+    // forEachWithPrefix() calls callback(element) for each element in the
+    // set that begins with prefix, in ascending order, until limit of
+    // them have been passed to it; it returns how many were.  It finds
+    // the first such element in O(log n) time and then visits the rest in
+    // order, without allocating any memory, which makes it suitable for
+    // as-you-type autocompletion.  T must support compare(pos, len, other)
+    // the way std::string does.
+    template <typename Callback>
+    unsigned int forEachWithPrefix(const T& prefix, unsigned int limit, Callback callback) const;
+
     // size() returns the number of elements in the set.
     virtual unsigned int size() const;
 
@@ -60,10 +145,95 @@ public:
         Node* left;
         Node* right;
         bool isCurrentNodeAdded;
+        // the height of the subtree rooted at this node, which is 1 for
+        // a leaf; it's kept up to date so balance() needn't recompute it
+        int height;
         //bool isLeftNodeAdded;
         //bool isRightNodeAdded;
     };
 
+    // A Finger remembers the path from the root to where its last search
+    // ended, along with the range of elements below each node on it, so
+    // that the next search can start from the lowest node on the path
+    // whose range covers the element instead of from the root.  A search
+    // for an element d positions away from the last one takes O(log d)
+    // time rather than O(log n).
+    //
+    // Adding elements to the set rebalances or rebuilds it, so a Finger
+    // starts over from the root whenever it sees that the set has been
+    // changed in any way since its last search, including by assigning
+    // into it, moving into or out of it, or swapping it.  Destroying the
+    // set leaves a Finger unusable.
+    class Finger
+    {
+    public:
+        // Initializes a Finger that searches the given set, starting at
+        // its root.
+        explicit Finger(const AVLSet& set);
+
+        // contains() returns true if the given element is in the set,
+        // false otherwise, and leaves the Finger where it looked.
+        bool contains(const T& element);
+
+        // reset() sends the Finger back to the root of the set.
+        void reset();
+
+    private:
+        // one node on the path, along with the nearest nodes above it
+        // that bound its subtree from below and above (NULL if unbounded)
+        struct Step
+        {
+            Node* node;
+            Node* lower;
+            Node* upper;
+        };
+
+        const AVLSet* set;
+        std::vector<Step> path;
+
+        // the set's count of modifications when the path was found
+        unsigned int knownModifications;
+    };
+
+    // An Iterator visits the elements of the set in ascending order.  Adding elements to
+    // the set, or destroying it, invalidates it.
+    class Iterator
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const T*;
+        using reference = const T&;
+
+        const T& operator*() const;
+        const T* operator->() const;
+        Iterator& operator++();
+        Iterator operator++(int);
+        bool operator==(const Iterator& other) const;
+        bool operator!=(const Iterator& other) const;
+
+    private:
+        friend class AVLSet;
+
+        // Initializes an Iterator at the least element below n, which may
+        // be NULL.
+        explicit Iterator(Node* n);
+
+        // the nodes whose elements are still to be visited, apart from
+        // their right subtrees; the back is the current one, and the
+        // Iterator is at the end when it's empty
+        std::vector<Node*> path;
+
+        // pushes n and the nodes down its left edge onto path
+        void descend(Node* n);
+    };
+
+    // begin() returns an Iterator at the set's first element, and end() one
+    // past its last.
+    Iterator begin() const;
+    Iterator end() const;
+
 private:
     // declare a root Node for AVL class
     Node* root;
@@ -71,6 +241,10 @@ private:
     // declare a variable to count the size of AVL
     int numberOfElements;
 
+    // the number of times the set has been changed, which Fingers check
+    // to know when the nodes on their paths may have moved or been freed
+    unsigned int modifications;
+
     // helper function for add()
     void insert(Node*& n, const T& element);
 
@@ -80,14 +254,62 @@ private:
     // helper function for balance() to find the height
     int findHeight(Node* n);
 
+    // recomputes n's height from the heights of its children
+    void updateHeight(Node* n);
+
     // helper function for balance() to find the difference between two sides
     int heightDifference(Node* n);
 
     // helper function for contains()
     const bool find(Node* n, const T& element) const;
 
+    // helper function for forEachWithPrefix(); visits the elements of the
+    // subtree rooted at n that begin with prefix, in order
+    template <typename Callback>
+    void visitPrefix(
+        Node* n, const T& prefix, unsigned int limit, unsigned int& count, Callback& callback) const;
+
     // helper function for deallocate memory
     void deallocate(Node* n);
+
+    // helper function for the copy constructor; returns a deep copy of the
+    // subtree rooted at n
+    Node* copyNode(const Node* n);
+
+    // appends the elements of the subtree rooted at n to out, in order
+    void collect(Node* n, std::vector<T>& out);
+
+    // builds a perfectly balanced subtree from the sorted elements in
+    // [first, last), building the top levels of it in parallel while
+    // threadCount is more than 1
+    Node* buildBalanced(T* first, T* last, unsigned int threadCount);
+
+    // takes the nodes out of the set, leaving it empty, and returns the
+    // root of the tree they form (NULL if there were none)
+    Node* releaseNodes();
+
+    // builds a perfectly balanced subtree from the next count distinct
+    // elements of a range in ascending order, starting at next, and
+    // leaves next past them
+    template <typename ForwardIt>
+    Node* buildInOrder(ForwardIt& next, ForwardIt end, unsigned int count);
+
+    // join() returns the root of a tree holding the elements of left, then
+    // middle, then those of right, where every element of left is less
+    // than middle's and every one of right is greater.  It descends the
+    // spine of the taller tree to where the shorter one fits and
+    // rebalances on the way back up, in O(|h(left) - h(right)| + 1) time.
+    Node* join(Node* left, Node* middle, Node* right);
+
+    // split() divides the tree rooted at n into one with the elements less
+    // than element and one with those greater.  The node holding element
+    // itself, if there is one, is detached and returned in found.
+    void split(Node* n, const T& element, Node*& left, Node*& right, Node*& found);
+
+    // unionTrees() returns the root of a tree holding the elements of both
+    // a and b, freeing the nodes of a whose elements are also in b and
+    // counting them in duplicates
+    Node* unionTrees(Node* a, Node* b, unsigned int threadCount, unsigned int& duplicates);
 };
 
 
@@ -97,6 +319,7 @@ AVLSet<T>::AVLSet()
     // initialize root
     root = new Node;
     root->isCurrentNodeAdded = false;
+    root->height = 0;
     //root->isLeftNodeAdded = false;
     //root->isRightNodeAdded = false;
     root->left = NULL;
@@ -104,6 +327,7 @@ AVLSet<T>::AVLSet()
 
     // initialize numberOfElements as 0, since the AVL is empty
     numberOfElements = 0;
+    modifications = 0;
 }
 
 
@@ -118,25 +342,56 @@ AVLSet<T>::~AVLSet()
 template <typename T>
 AVLSet<T>::AVLSet(const AVLSet& s)
 {
-    //copy class variables from s
-    this->root = new Node(s.root);
+    // copy every node of s, so the two sets share nothing
+    this->root = copyNode(s.root);
     this->numberOfElements = s.numberOfElements;
+    this->modifications = 0;
+}
+
+
+template <typename T>
+AVLSet<T>::AVLSet(AVLSet&& s)
+    : AVLSet{}
+{
+    // start out empty, then trade places with s
+    swap(s);
 }
 
 
 template <typename T>
 AVLSet<T>& AVLSet<T>::operator=(const AVLSet& s)
 {
-    // reallocate to s class variable
+    // copy s on the side, then trade places with the copy, whose
+    // destructor cleans up the old nodes
     if (this != &s)
     {
-        this->root = s.root;
-        this->numberOfElements = s.numberOfElements;
+        AVLSet copy{s};
+        swap(copy);
     }
     return *this;
 }
 
 
+template <typename T>
+AVLSet<T>& AVLSet<T>::operator=(AVLSet&& s)
+{
+    // the old nodes end up in s, which will clean them up
+    swap(s);
+    return *this;
+}
+
+
+template <typename T>
+void AVLSet<T>::swap(AVLSet& s) noexcept
+{
+    std::swap(root, s.root);
+    std::swap(numberOfElements, s.numberOfElements);
+    // both sets now have different nodes than their Fingers knew about
+    modifications++;
+    s.modifications++;
+}
+
+
 template <typename T>
 bool AVLSet<T>::isImplemented() const
 {
@@ -155,6 +410,7 @@ void AVLSet<T>::add(const T& element)
         insert(root, element);
         // numberOfElements +1 when a element is added to the set
         numberOfElements++;
+        modifications++;
     }
 }
 
@@ -167,6 +423,118 @@ bool AVLSet<T>::contains(const T& element) const
 }
 
 
+template <typename T>
+template <typename Callback>
+unsigned int AVLSet<T>::forEachWithPrefix(const T& prefix, unsigned int limit, Callback callback) const
+{
+    unsigned int count = 0;
+    visitPrefix(root, prefix, limit, count, callback);
+    return count;
+}
+
+
+template <typename T>
+template <typename Callback>
+void AVLSet<T>::visitPrefix(
+    Node* n, const T& prefix, unsigned int limit, unsigned int& count, Callback& callback) const
+{
+    if (n == NULL || !n->isCurrentNodeAdded || count >= limit)
+    {
+        return;
+    }
+    if (n->data < prefix)
+    {
+        // everything that begins with prefix is to the right
+        visitPrefix(n->right, prefix, limit, count, callback);
+    }
+    else
+    {
+        visitPrefix(n->left, prefix, limit, count, callback);
+        if (count < limit && n->data.compare(0, prefix.size(), prefix) == 0)
+        {
+            callback(n->data);
+            count++;
+            visitPrefix(n->right, prefix, limit, count, callback);
+        }
+        // otherwise n is past every element that begins with prefix, and so
+        // is everything to its right
+    }
+}
+
+
+template <typename T>
+void AVLSet<T>::containsMany(const T* elements, unsigned int count, bool* results) const
+{
+    if (!root->isCurrentNodeAdded)
+    {
+        for (unsigned int i = 0; i < count; i++)
+        {
+            results[i] = false;
+        }
+        return;
+    }
+
+    Node* cursors[PREFETCH_GROUP_SIZE];
+    for (unsigned int first = 0; first < count; first += PREFETCH_GROUP_SIZE)
+    {
+        unsigned int groupSize = std::min(PREFETCH_GROUP_SIZE, count - first);
+        for (unsigned int j = 0; j < groupSize; j++)
+        {
+            cursors[j] = root;
+        }
+
+        // take one step down the tree for every lookup still going, until
+        // they've all either found their element or fallen off the tree
+        unsigned int active = groupSize;
+        while (active > 0)
+        {
+            for (unsigned int j = 0; j < groupSize; j++)
+            {
+                Node* n = cursors[j];
+                if (n == NULL)
+                {
+                    continue;
+                }
+                int comparison = n->data.compare(elements[first + j]);
+                if (comparison == 0)
+                {
+                    results[first + j] = true;
+                    n = NULL;
+                }
+                else
+                {
+                    n = (comparison > 0) ? n->left : n->right;
+                    if (n == NULL)
+                    {
+                        results[first + j] = false;
+                    }
+                    else
+                    {
+                        prefetch(n);
+                    }
+                }
+                if (n == NULL)
+                {
+                    active--;
+                }
+                cursors[j] = n;
+            }
+        }
+    }
+}
+
+
+template <typename T>
+void AVLSet<T>::containsSorted(const T* elements, unsigned int count, bool* results) const
+{
+    Finger finger{*this};
+    for (unsigned int i = 0; i < count; i++)
+    {
+        results[i] = finger.contains(elements[i]);
+    }
+}
+
+
 template <typename T>
 unsigned int AVLSet<T>::size() const
 {
@@ -183,6 +551,7 @@ void AVLSet<T>::insert(Node*& n, const T& element)
     {
         n->data = element;
         n->isCurrentNodeAdded = true;
+        n->height = 1;
     }
     else
     {
@@ -200,6 +569,7 @@ void AVLSet<T>::insert(Node*& n, const T& element)
                 //n->left->isRightNodeAdded = false;
                 n->left->left = NULL;
                 n->left->right = NULL;
+                n->left->height = 1;
                 balance(n);
             }
             else
@@ -221,12 +591,13 @@ void AVLSet<T>::insert(Node*& n, const T& element)
                 //n->right->isRightNodeAdded = false;
                 n->right->left = NULL;
                 n->right->right = NULL;
+                n->right->height = 1;
                 balance(n);
             }
             else
             {
                 insert(n->right, element);
-                balance(root);
+                balance(n);
             }
         }
     }
@@ -236,6 +607,7 @@ void AVLSet<T>::insert(Node*& n, const T& element)
 template <typename T>
 void AVLSet<T>::balance(Node*& n)
 {
+    updateHeight(n);
     int balanceHeight = heightDifference(n);
     if (balanceHeight > 1)
     {
@@ -247,6 +619,8 @@ void AVLSet<T>::balance(Node*& n)
             temp = n->left;
             n->left = temp->right;
             temp->right = n;
+            updateHeight(n);
+            updateHeight(temp);
             n = temp;
         }
         else
@@ -259,10 +633,13 @@ void AVLSet<T>::balance(Node*& n)
             temp1->right = temp2->left;
             temp2->left = temp1;
             n->left = temp2;
+            updateHeight(temp1);
             Node* temp3;
             temp3 = n->left;
             n->left = temp3->right;
             temp3->right = n;
+            updateHeight(n);
+            updateHeight(temp3);
             n = temp3;
         }
     }
@@ -279,10 +656,13 @@ void AVLSet<T>::balance(Node*& n)
             temp1->left = temp2->right;
             temp2->right = temp1;
             n->right = temp2;
+            updateHeight(temp1);
             Node* temp3;
             temp3 = n->right;
             n->right = temp3->left;
             temp3->left = n;
+            updateHeight(n);
+            updateHeight(temp3);
             n = temp3;
         }
         else
@@ -292,6 +672,8 @@ void AVLSet<T>::balance(Node*& n)
             temp = n->right;
             n->right = temp->left;
             temp->left = n;
+            updateHeight(n);
+            updateHeight(temp);
             n = temp;
         }
     }
@@ -301,15 +683,18 @@ void AVLSet<T>::balance(Node*& n)
 template <typename T>
 int AVLSet<T>::findHeight(Node* n)
 {
-    int height = 0;
-    if (n != NULL)
-    {
-        int leftHeight = findHeight(n->left);
-        int rightHeight = findHeight(n->right);
-        int max_height = (leftHeight > rightHeight) ? leftHeight : rightHeight;
-        height = max_height + 1;
-    }
-    return height;
+    // every node keeps its own height, so this is constant time
+    return (n != NULL) ? n->height : 0;
+}
+
+
+template <typename T>
+void AVLSet<T>::updateHeight(Node* n)
+{
+    int leftHeight = findHeight(n->left);
+    int rightHeight = findHeight(n->right);
+    int max_height = (leftHeight > rightHeight) ? leftHeight : rightHeight;
+    n->height = max_height + 1;
 }
 
 
@@ -366,6 +751,518 @@ void AVLSet<T>::deallocate(Node* n)
 }
 
 
+template <typename T>
+typename AVLSet<T>::Node* AVLSet<T>::copyNode(const Node* n)
+{
+    if (n == NULL)
+    {
+        return NULL;
+    }
+    Node* copy = new Node(*n);
+    copy->left = copyNode(n->left);
+    copy->right = copyNode(n->right);
+    return copy;
+}
+
+
+template <typename T>
+template <typename RandomIt>
+void AVLSet<T>::addAll(RandomIt begin, RandomIt end, unsigned int threadCount)
+{
+    unsigned int count = end - begin;
+    if (threadCount == 0)
+    {
+        threadCount = 1;
+    }
+    if (count < threadCount)
+    {
+        threadCount = (count == 0) ? 1 : count;
+    }
+
+    // one shard per thread, plus one for the elements already in the set
+    std::vector<std::vector<T>> shards(threadCount + 1);
+    collect(root, shards[threadCount]);
+    runInParallel(threadCount,
+        [&](unsigned int t)
+        {
+            std::vector<T>& shard = shards[t];
+            shard.assign(begin + sliceBegin(count, threadCount, t),
+                         begin + sliceBegin(count, threadCount, t + 1));
+            std::sort(shard.begin(), shard.end());
+            shard.erase(std::unique(shard.begin(), shard.end()), shard.end());
+        });
+
+    // merge neighboring shards in pairs until only one is left
+    for (unsigned int width = 1; width < shards.size(); width *= 2)
+    {
+        unsigned int pairs = (shards.size() + 2 * width - 1) / (2 * width);
+        runInParallel(pairs,
+            [&](unsigned int p)
+            {
+                unsigned int left = p * 2 * width;
+                unsigned int right = left + width;
+                if (right >= shards.size())
+                {
+                    return;
+                }
+                std::vector<T> merged;
+                merged.reserve(shards[left].size() + shards[right].size());
+                std::set_union(
+                    std::make_move_iterator(shards[left].begin()),
+                    std::make_move_iterator(shards[left].end()),
+                    std::make_move_iterator(shards[right].begin()),
+                    std::make_move_iterator(shards[right].end()),
+                    std::back_inserter(merged));
+                shards[left].swap(merged);
+                std::vector<T>().swap(shards[right]);
+            });
+    }
+
+    std::vector<T>& sorted = shards[0];
+    if (sorted.empty())
+    {
+        return;
+    }
+    Node* newRoot = buildBalanced(sorted.data(), sorted.data() + sorted.size(), threadCount);
+    deallocate(root);
+    root = newRoot;
+    numberOfElements = sorted.size();
+    modifications++;
+}
+
+
+template <typename T>
+void AVLSet<T>::collect(Node* n, std::vector<T>& out)
+{
+    if (n != NULL && n->isCurrentNodeAdded)
+    {
+        collect(n->left, out);
+        out.push_back(n->data);
+        collect(n->right, out);
+    }
+}
+
+
+template <typename T>
+typename AVLSet<T>::Node* AVLSet<T>::buildBalanced(T* first, T* last, unsigned int threadCount)
+{
+    if (first == last)
+    {
+        return NULL;
+    }
+    T* middle = first + (last - first) / 2;
+    Node* n = new Node;
+    n->data = std::move(*middle);
+    n->isCurrentNodeAdded = true;
+    if (threadCount > 1)
+    {
+        // build the left subtree on another thread while building the right
+        // one on this thread, splitting the remaining threads between them
+        unsigned int leftThreads = threadCount / 2;
+        std::thread leftBuilder{
+            [&]()
+            {
+                n->left = buildBalanced(first, middle, leftThreads);
+            }};
+        n->right = buildBalanced(middle + 1, last, threadCount - leftThreads);
+        leftBuilder.join();
+    }
+    else
+    {
+        n->left = buildBalanced(first, middle, 1);
+        n->right = buildBalanced(middle + 1, last, 1);
+    }
+    updateHeight(n);
+    return n;
+}
+
+
+template <typename T>
+void AVLSet<T>::unionWith(AVLSet&& other, unsigned int threadCount)
+{
+    if (&other == this)
+    {
+        return;
+    }
+    if (threadCount == 0)
+    {
+        threadCount = 1;
+    }
+
+    int count = numberOfElements + other.numberOfElements;
+    Node* theirs = other.releaseNodes();
+    Node* mine = releaseNodes();
+    unsigned int duplicates = 0;
+    Node* merged = unionTrees(mine, theirs, threadCount, duplicates);
+    if (merged != NULL)
+    {
+        deallocate(root);
+        root = merged;
+        numberOfElements = count - duplicates;
+    }
+}
+
+
+template <typename T>
+template <typename RandomIt>
+void AVLSet<T>::insertAll(RandomIt begin, RandomIt end, unsigned int threadCount)
+{
+    AVLSet batch;
+    batch.addAll(begin, end, threadCount);
+    unionWith(std::move(batch), threadCount);
+}
+
+
+template <typename T>
+template <typename ForwardIt>
+void AVLSet<T>::buildFromSorted(ForwardIt begin, ForwardIt end)
+{
+    // check the order before touching the set
+    unsigned int count = countDistinctSorted(begin, end);
+    Node* newRoot = buildInOrder(begin, end, count);
+    if (newRoot == NULL)
+    {
+        deallocate(releaseNodes());
+        return;
+    }
+    deallocate(root);
+    root = newRoot;
+    numberOfElements = count;
+    modifications++;
+}
+
+
+template <typename T>
+template <typename OutputIt>
+OutputIt AVLSet<T>::dumpSorted(OutputIt out) const
+{
+    return std::copy(begin(), end(), out);
+}
+
+
+template <typename T>
+template <typename ForwardIt>
+typename AVLSet<T>::Node* AVLSet<T>::buildInOrder(ForwardIt& next, ForwardIt end, unsigned int count)
+{
+    if (count == 0)
+    {
+        return NULL;
+    }
+
+    // the elements arrive in order, so build the left subtree, then take
+    // the middle element, then build the right subtree
+    unsigned int leftCount = count / 2;
+    Node* left = buildInOrder(next, end, leftCount);
+    Node* n = new Node;
+    n->data = *next;
+    n->isCurrentNodeAdded = true;
+    n->left = left;
+    next = nextDistinct(next, end);
+    n->right = buildInOrder(next, end, count - leftCount - 1);
+    updateHeight(n);
+    return n;
+}
+
+
+template <typename T>
+typename AVLSet<T>::Node* AVLSet<T>::releaseNodes()
+{
+    Node* n = root;
+    if (!n->isCurrentNodeAdded)
+    {
+        // an empty set's root holds no element
+        delete n;
+        n = NULL;
+    }
+
+    root = new Node;
+    root->isCurrentNodeAdded = false;
+    root->height = 0;
+    root->left = NULL;
+    root->right = NULL;
+    numberOfElements = 0;
+    modifications++;
+    return n;
+}
+
+
+template <typename T>
+typename AVLSet<T>::Node* AVLSet<T>::join(Node* left, Node* middle, Node* right)
+{
+    int leftHeight = findHeight(left);
+    int rightHeight = findHeight(right);
+    if (leftHeight > rightHeight + 1)
+    {
+        // hang middle and right off the right spine of left, at the first
+        // node no more than one level taller than right
+        left->right = join(left->right, middle, right);
+        balance(left);
+        return left;
+    }
+    else if (rightHeight > leftHeight + 1)
+    {
+        right->left = join(left, middle, right->left);
+        balance(right);
+        return right;
+    }
+    else
+    {
+        middle->left = left;
+        middle->right = right;
+        updateHeight(middle);
+        return middle;
+    }
+}
+
+
+template <typename T>
+void AVLSet<T>::split(Node* n, const T& element, Node*& left, Node*& right, Node*& found)
+{
+    if (n == NULL)
+    {
+        left = NULL;
+        right = NULL;
+        found = NULL;
+        return;
+    }
+
+    int comparison = n->data.compare(element);
+    if (comparison > 0)
+    {
+        // n and its right subtree are all greater than element
+        Node* lessRight;
+        split(n->left, element, left, lessRight, found);
+        right = join(lessRight, n, n->right);
+    }
+    else if (comparison < 0)
+    {
+        Node* greaterLeft;
+        split(n->right, element, greaterLeft, right, found);
+        left = join(n->left, n, greaterLeft);
+    }
+    else
+    {
+        left = n->left;
+        right = n->right;
+        n->left = NULL;
+        n->right = NULL;
+        n->height = 1;
+        found = n;
+    }
+}
+
+
+template <typename T>
+typename AVLSet<T>::Node* AVLSet<T>::unionTrees(
+    Node* a, Node* b, unsigned int threadCount, unsigned int& duplicates)
+{
+    if (a == NULL)
+    {
+        return b;
+    }
+    if (b == NULL)
+    {
+        return a;
+    }
+
+    // split a around b's root, which keeps its own node
+    Node* aLeft;
+    Node* aRight;
+    Node* found;
+    split(a, b->data, aLeft, aRight, found);
+    if (found != NULL)
+    {
+        delete found;
+        duplicates++;
+    }
+
+    Node* bLeft = b->left;
+    Node* bRight = b->right;
+    Node* left;
+    Node* right;
+    if (threadCount > 1)
+    {
+        // merge the left halves on another thread while merging the right
+        // ones on this thread, splitting the remaining threads between them
+        unsigned int leftThreads = threadCount / 2;
+        unsigned int leftDuplicates = 0;
+        std::thread leftMerger{
+            [&]()
+            {
+                left = unionTrees(aLeft, bLeft, leftThreads, leftDuplicates);
+            }};
+        right = unionTrees(aRight, bRight, threadCount - leftThreads, duplicates);
+        leftMerger.join();
+        duplicates += leftDuplicates;
+    }
+    else
+    {
+        left = unionTrees(aLeft, bLeft, 1, duplicates);
+        right = unionTrees(aRight, bRight, 1, duplicates);
+    }
+    return join(left, b, right);
+}
+
+
+template <typename T>
+AVLSet<T>::Finger::Finger(const AVLSet& set)
+    : set{&set}
+{
+    reset();
+}
+
+
+template <typename T>
+bool AVLSet<T>::Finger::contains(const T& element)
+{
+    if (knownModifications != set->modifications)
+    {
+        reset();
+    }
+    if (!set->root->isCurrentNodeAdded)
+    {
+        return false;
+    }
+    if (path.empty())
+    {
+        path.push_back(Step{set->root, NULL, NULL});
+    }
+
+    // climb until the element is within the range of the node on top of
+    // the path; the root's range covers everything
+    while (path.size() > 1)
+    {
+        const Step& step = path.back();
+        if ((step.lower == NULL || step.lower->data < element)
+            && (step.upper == NULL || element < step.upper->data))
+        {
+            break;
+        }
+        path.pop_back();
+    }
+
+    // then search down from there as contains() would, extending the path
+    Step step = path.back();
+    while (true)
+    {
+        Node* n = step.node;
+        int comparison = n->data.compare(element);
+        if (comparison == 0)
+        {
+            return true;
+        }
+        if (comparison > 0)
+        {
+            step = Step{n->left, step.lower, n};
+        }
+        else
+        {
+            step = Step{n->right, n, step.upper};
+        }
+        if (step.node == NULL)
+        {
+            return false;
+        }
+        path.push_back(step);
+    }
+}
+
+
+template <typename T>
+void AVLSet<T>::Finger::reset()
+{
+    path.clear();
+    knownModifications = set->modifications;
+}
+
+
+// swap() lets AVLSets be exchanged with an unqualified call to swap()
+template <typename T>
+void swap(AVLSet<T>& a, AVLSet<T>& b) noexcept
+{
+    a.swap(b);
+}
+
+
+template <typename T>
+typename AVLSet<T>::Iterator AVLSet<T>::begin() const
+{
+    return Iterator{root->isCurrentNodeAdded ? root : NULL};
+}
+
+
+template <typename T>
+typename AVLSet<T>::Iterator AVLSet<T>::end() const
+{
+    return Iterator{NULL};
+}
+
+
+template <typename T>
+AVLSet<T>::Iterator::Iterator(Node* n)
+{
+    descend(n);
+}
+
+
+template <typename T>
+const T& AVLSet<T>::Iterator::operator*() const
+{
+    return path.back()->data;
+}
+
+
+template <typename T>
+const T* AVLSet<T>::Iterator::operator->() const
+{
+    return &path.back()->data;
+}
+
+
+template <typename T>
+typename AVLSet<T>::Iterator& AVLSet<T>::Iterator::operator++()
+{
+    Node* n = path.back();
+    path.pop_back();
+    descend(n->right);
+    return *this;
+}
+
+
+template <typename T>
+typename AVLSet<T>::Iterator AVLSet<T>::Iterator::operator++(int)
+{
+    Iterator old = *this;
+    ++*this;
+    return old;
+}
+
+
+template <typename T>
+bool AVLSet<T>::Iterator::operator==(const Iterator& other) const
+{
+    return path.empty() ? other.path.empty()
+        : (!other.path.empty() && path.back() == other.path.back());
+}
+
+
+template <typename T>
+bool AVLSet<T>::Iterator::operator!=(const Iterator& other) const
+{
+    return !(*this == other);
+}
+
+
+template <typename T>
+void AVLSet<T>::Iterator::descend(Node* n)
+{
+    for (; n != NULL; n = n->left)
+    {
+        path.push_back(n);
+    }
+}
+
+
 
 #endif // AVLSET_HPP
 
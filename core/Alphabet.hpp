@@ -0,0 +1,135 @@
+// Alphabet.hpp
+//
+// ICS 46 Spring 2015
+// Project #3: Set the Controls for the Heart of the Sun
+//
+// An alphabet policy tells a BasicWordChecker which letters to try when it
+// inserts a letter into a word or replaces one of its letters.  Like a
+// HashSet's hash policy, it's a template parameter, so the letters are
+// known at compile time: forEachLetter() expands into one call per letter,
+// with each letter a constant, and the compiler generates a separate,
+// fully unrolled insertion and replacement loop for each alphabet, with
+// no table to read and no branch on which alphabet is in use.
+//
+// An Alphabet is made of CharacterRanges, each a run of consecutive
+// characters.  Ready-made alphabets are provided for dictionaries in
+// uppercase (the original A-Z), lowercase, mixed case and Latin-1, whose
+// accented letters are the single bytes 0xC0-0xFF other than the
+// multiplication and division signs.
+
+#ifndef ALPHABET_HPP
+#define ALPHABET_HPP
+
+#include <utility>
+
+
+
+namespace alphabetDetail
+{
+    constexpr unsigned int sum()
+    {
+        return 0;
+    }
+
+
+    template <typename... Rest>
+    constexpr unsigned int sum(unsigned int first, Rest... rest)
+    {
+        return first + sum(rest...);
+    }
+
+
+    constexpr bool any()
+    {
+        return false;
+    }
+
+
+    template <typename... Rest>
+    constexpr bool any(bool first, Rest... rest)
+    {
+        return first || any(rest...);
+    }
+}
+
+
+
+// CharacterRange<First, Last> is the characters First through Last.
+template <unsigned char First, unsigned char Last>
+struct CharacterRange
+{
+    static_assert(First <= Last, "a CharacterRange can't be empty");
+
+    static constexpr unsigned int SIZE = Last - First + 1;
+
+    // returns true if c is in the range
+    static constexpr bool contains(char c)
+    {
+        return static_cast<unsigned char>(c) >= First && static_cast<unsigned char>(c) <= Last;
+    }
+
+    // calls function(c) for each character c in the range, in order
+    template <typename Function>
+    static void forEachLetter(Function& function)
+    {
+        forEachLetter(function, std::make_integer_sequence<unsigned int, SIZE>{});
+    }
+
+private:
+    template <typename Function, unsigned int... Offsets>
+    static void forEachLetter(Function& function, std::integer_sequence<unsigned int, Offsets...>)
+    {
+        // expands into one call per character; the array only gives the
+        // expansion somewhere to happen
+        int expansion[] = {(function(static_cast<char>(First + Offsets)), 0)...};
+        (void)expansion;
+    }
+};
+
+
+
+// Alphabet<Ranges...> is the characters in all of the given ranges.
+template <typename... Ranges>
+struct Alphabet
+{
+    // the number of letters in the alphabet
+    static constexpr unsigned int SIZE = alphabetDetail::sum(Ranges::SIZE...);
+
+    // returns true if c is one of the alphabet's letters
+    static constexpr bool contains(char c)
+    {
+        return alphabetDetail::any(Ranges::contains(c)...);
+    }
+
+    // calls function(c) for each letter c in the alphabet, in order
+    template <typename Function>
+    static void forEachLetter(Function function)
+    {
+        int expansion[] = {0, (Ranges::forEachLetter(function), 0)...};
+        (void)expansion;
+    }
+};
+
+
+template <unsigned char First, unsigned char Last>
+constexpr unsigned int CharacterRange<First, Last>::SIZE;
+
+
+template <typename... Ranges>
+constexpr unsigned int Alphabet<Ranges...>::SIZE;
+
+
+
+using UppercaseAlphabet = Alphabet<CharacterRange<'A', 'Z'>>;
+
+using LowercaseAlphabet = Alphabet<CharacterRange<'a', 'z'>>;
+
+using MixedCaseAlphabet = Alphabet<CharacterRange<'A', 'Z'>, CharacterRange<'a', 'z'>>;
+
+using Latin1Alphabet = Alphabet<
+    CharacterRange<'A', 'Z'>, CharacterRange<'a', 'z'>,
+    CharacterRange<0xC0, 0xD6>, CharacterRange<0xD8, 0xF6>, CharacterRange<0xF8, 0xFF>>;
+
+
+
+#endif // ALPHABET_HPP
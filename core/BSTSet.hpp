@@ -12,12 +12,39 @@
 // (such as std::set, std::map, or std::vector).  Instead, you'll need
 // to implement your binary search tree using your own dynamically-allocated
 // nodes, with pointers connecting them.
+//
+// A BSTSet can optionally adjust itself as it's used, splaying every
+// element it adds or looks up to the root (see BSTAdjustment).  That isn't
+// balancing in the AVL sense -- the tree can still be tall at times -- but
+// it bounds the amortized cost of each operation to O(log n) and keeps
+// the elements that are looked up most often near the root.
 
 #ifndef BSTSET_HPP
 #define BSTSET_HPP
 
+#include "Prefetch.hpp"
 #include "Set.hpp"
+#include "SortedRange.hpp"
+#include <algorithm>
 #include <string>
+#include <utility>
+#include <vector>
+
+
+
+// BSTAdjustment says how a BSTSet reshapes itself as it's used.
+//
+//   None   the tree keeps the shape that the order of add()s gave it
+//   Splay  every add() and contains() splays the element it looked for
+//          (or the last node it visited, if the element isn't there) to
+//          the root, with top-down splaying.  This makes contains() modify
+//          the tree, so a BSTSet in this mode mustn't be read by several
+//          threads at once.
+enum class BSTAdjustment
+{
+    None,
+    Splay
+};
 
 
 
@@ -34,15 +61,35 @@ public:
     // Initializes a new BSTSet to be a copy of an existing one.
     BSTSet(const BSTSet& s);
 
+    // Initializes a new BSTSet by taking over the nodes of an existing one,
+    // which is left empty.  No nodes are copied.
+    BSTSet(BSTSet&& s);
+
     // Assigns an existing BSTSet into another.
     BSTSet& operator=(const BSTSet& s);
 
+    // Moves the nodes of an existing BSTSet into another, in constant time.
+    BSTSet& operator=(BSTSet&& s);
+
+    // swap() exchanges the contents of two BSTSets in constant time, by
+    // exchanging their roots rather than any of their nodes.
+    void swap(BSTSet& s) noexcept;
+
 
     // isImplemented() should be modified to return true if you've
     // decided to implement a BSTSet, false otherwise.
     virtual bool isImplemented() const;
 
 
+    // setAdjustment() changes how the tree reshapes itself from now on.
+    // The tree keeps its current shape until the next add() or contains().
+    void setAdjustment(BSTAdjustment adjustment);
+
+
+    // adjustment() returns how the tree reshapes itself.
+    BSTAdjustment adjustment() const;
+
+
     // add() adds an element to the set.  If the element is already in the set,
     // this function has no effect.  This function runs in O(n) time when there
     // are n elements in the binary search tree, and is sometimes as fast as
@@ -56,6 +103,46 @@ public:
     // O(log n) (when the tree is relatively balanced).
     virtual bool contains(const T& element) const;
 
+    // containsMany() looks up count elements at once, setting results[i]
+    // to whether elements[i] is in the set.  It works through them in
+    // groups, interleaving the steps of each group's lookups and
+    // prefetching the nodes they'll visit next, so that the cache misses
+    // of a group overlap rather than following one another.  When the
+    // adjustment is Splay, it calls contains() for each element instead,
+    // since each lookup reshapes the tree for the next one.
+    void containsMany(const T* elements, unsigned int count, bool* results) const;
+
+    // forEachWithPrefix() calls callback(element) for each element in the
+    // set that begins with prefix, in ascending order, until limit of
+    // them have been passed to it; it returns how many were.  It finds
+    // the first such element in O(h) (for a tree of height h) time and then
+    // visits the rest in order, which makes it suitable for as-you-type
+    // autocompletion.  It keeps its place on a stack rather than
+    // recursing, so even a tree as tall as a chain can be scanned.  T must
+    // support compare(pos, len, other) the way std::string does.
+    template <typename Callback>
+    unsigned int forEachWithPrefix(const T& prefix, unsigned int limit, Callback callback) const;
+
+
+    // buildFromSorted() replaces the contents of the set with the elements
+    // in the range [begin, end), which must be in ascending order; repeated
+    // elements are added once.  Adding them one at a time would make a
+    // chain as tall as the set is big, taking O(n^2) time; this counts them
+    // in one pass and builds a perfectly balanced tree from them in a
+    // second, in O(n) time.  If the range isn't in order, it throws an
+    // std::invalid_argument and leaves the set as it was.
+    template <typename ForwardIt>
+    void buildFromSorted(ForwardIt begin, ForwardIt end);
+
+
+    // dumpSorted() writes every element of the set to out, in ascending
+    // order, in O(n) time, and returns out past the last of them.  The
+    // elements can be given back to buildFromSorted() to restore the set.
+    // It walks the tree without recursing, so a tall one is no problem,
+    // and doesn't splay it.
+    template <typename OutputIt>
+    OutputIt dumpSorted(OutputIt out) const;
+
 
     // size() returns the number of elements in the set.
     virtual unsigned int size() const;
@@ -72,8 +159,12 @@ public:
 
 
 private:
-    // declare a root Node for BST class
-    Node* root;
+    // declare a root Node for BST class; it's mutable because splaying
+    // changes which node is the root even when only looking elements up
+    mutable Node* root;
+
+    // how the tree reshapes itself as it's used
+    BSTAdjustment adjusting;
 
     // declare a variable to count the size of BST
     int numberOfElements;
@@ -84,8 +175,29 @@ private:
     // helper function for contains()
     const bool find(Node* n, const T& element) const;
 
-    // helper function for deallocate memory
+    // splays the node containing element to the root, or the last node
+    // visited in looking for it, if it isn't in the tree; the tree must
+    // not be empty
+    void splay(const T& element) const;
+
+    // makes child the left (or right) child of n, keeping the flags that
+    // say whether n has such a child up to date
+    static void setLeft(Node* n, Node* child);
+    static void setRight(Node* n, Node* child);
+
+    // helper function for deallocate memory; it doesn't recurse, so it
+    // handles trees of any height
     void deallocate(Node* n);
+
+    // helper function for the copy constructor; returns a deep copy of the
+    // subtree rooted at n, without recursing
+    Node* copyNode(const Node* n);
+
+    // builds a perfectly balanced subtree from the next count distinct
+    // elements of a range in ascending order, starting at next, and
+    // leaves next past them
+    template <typename ForwardIt>
+    Node* buildInOrder(ForwardIt& next, ForwardIt end, unsigned int count);
 };
 
 
@@ -97,9 +209,12 @@ BSTSet<T>::BSTSet()
     root->isCurrentNodeAdded = false;
     root->isLeftNodeAdded = false;
     root->isRightNodeAdded = false;
+    root->left = NULL;
+    root->right = NULL;
 
     // initialize numberOfElements as 0, since the BST is empty
     numberOfElements = 0;
+    adjusting = BSTAdjustment::None;
 }
 
 
@@ -114,25 +229,54 @@ BSTSet<T>::~BSTSet()
 template <typename T>
 BSTSet<T>::BSTSet(const BSTSet& s)
 {
-    // copy class variables from s
-    this->root = new Node(s.root);
+    // copy every node of s, so the two sets share nothing
+    this->root = copyNode(s.root);
     this->numberOfElements = s.numberOfElements;
+    this->adjusting = s.adjusting;
+}
+
+
+template <typename T>
+BSTSet<T>::BSTSet(BSTSet&& s)
+    : BSTSet{}
+{
+    // start out empty, then trade places with s
+    swap(s);
 }
 
 
 template <typename T>
 BSTSet<T>& BSTSet<T>::operator=(const BSTSet& s)
 {
-    // reallocate to s class variable
+    // copy s on the side, then trade places with the copy, whose
+    // destructor cleans up the old nodes
     if (this != &s)
     {
-        this->root = s.root;
-        this->numberOfElements = s.numberOfElements;
+        BSTSet copy{s};
+        swap(copy);
     }
     return *this;
 }
 
 
+template <typename T>
+BSTSet<T>& BSTSet<T>::operator=(BSTSet&& s)
+{
+    // the old nodes end up in s, which will clean them up
+    swap(s);
+    return *this;
+}
+
+
+template <typename T>
+void BSTSet<T>::swap(BSTSet& s) noexcept
+{
+    std::swap(root, s.root);
+    std::swap(numberOfElements, s.numberOfElements);
+    std::swap(adjusting, s.adjusting);
+}
+
+
 template <typename T>
 bool BSTSet<T>::isImplemented() const
 {
@@ -141,9 +285,53 @@ bool BSTSet<T>::isImplemented() const
 }
 
 
+template <typename T>
+void BSTSet<T>::setAdjustment(BSTAdjustment adjustment)
+{
+    adjusting = adjustment;
+}
+
+
+template <typename T>
+BSTAdjustment BSTSet<T>::adjustment() const
+{
+    return adjusting;
+}
+
+
 template <typename T>
 void BSTSet<T>::add(const T& element)
 {
+    if (adjusting == BSTAdjustment::Splay && root->isCurrentNodeAdded)
+    {
+        // splay the nearest element to the root, then split the tree
+        // around it, making the new element the root
+        splay(element);
+        int comparison = root->data.compare(element);
+        if (comparison == 0)
+        {
+            return;
+        }
+        Node* n = new Node;
+        n->data = element;
+        n->isCurrentNodeAdded = true;
+        if (comparison > 0)
+        {
+            setLeft(n, root->left);
+            setRight(n, root);
+            setLeft(root, NULL);
+        }
+        else
+        {
+            setRight(n, root->right);
+            setLeft(n, root);
+            setRight(root, NULL);
+        }
+        root = n;
+        numberOfElements++;
+        return;
+    }
+
     // add element to BST if it doesn't contain in the set
     if (!contains(element))
     {
@@ -206,6 +394,12 @@ void BSTSet<T>::add(const T& element)
 template <typename T>
 bool BSTSet<T>::contains(const T& element) const
 {
+    if (adjusting == BSTAdjustment::Splay && root->isCurrentNodeAdded)
+    {
+        splay(element);
+        return root->data == element;
+    }
+
     // call the helper function
     return find(root, element);
 
@@ -251,6 +445,178 @@ bool BSTSet<T>::contains(const T& element) const
 }
 
 
+template <typename T>
+template <typename Callback>
+unsigned int BSTSet<T>::forEachWithPrefix(const T& prefix, unsigned int limit, Callback callback) const
+{
+    unsigned int count = 0;
+    if (!root->isCurrentNodeAdded || limit == 0)
+    {
+        return count;
+    }
+
+    // find the first element that isn't less than prefix; the nodes passed
+    // on the way by going left come after it, nearest first, so the path
+    // holds exactly what an in-order walk from there has left to visit
+    std::vector<Node*> path;
+    for (Node* n = root; n != NULL; )
+    {
+        if (n->data < prefix)
+        {
+            n = n->right;
+        }
+        else
+        {
+            path.push_back(n);
+            n = n->left;
+        }
+    }
+
+    while (!path.empty() && count < limit)
+    {
+        Node* n = path.back();
+        path.pop_back();
+
+        if (n->data.compare(0, prefix.size(), prefix) != 0)
+        {
+            // n is past every element that begins with prefix, and so is
+            // everything after it
+            break;
+        }
+
+        callback(n->data);
+        count++;
+
+        for (n = n->right; n != NULL; n = n->left)
+        {
+            path.push_back(n);
+        }
+    }
+
+    return count;
+}
+
+
+template <typename T>
+void BSTSet<T>::containsMany(const T* elements, unsigned int count, bool* results) const
+{
+    if (adjusting == BSTAdjustment::Splay)
+    {
+        for (unsigned int i = 0; i < count; i++)
+        {
+            results[i] = contains(elements[i]);
+        }
+        return;
+    }
+
+    if (!root->isCurrentNodeAdded)
+    {
+        for (unsigned int i = 0; i < count; i++)
+        {
+            results[i] = false;
+        }
+        return;
+    }
+
+    Node* cursors[PREFETCH_GROUP_SIZE];
+    for (unsigned int first = 0; first < count; first += PREFETCH_GROUP_SIZE)
+    {
+        unsigned int groupSize = std::min(PREFETCH_GROUP_SIZE, count - first);
+        for (unsigned int j = 0; j < groupSize; j++)
+        {
+            cursors[j] = root;
+        }
+
+        // take one step down the tree for every lookup still going, until
+        // they've all either found their element or fallen off the tree
+        unsigned int active = groupSize;
+        while (active > 0)
+        {
+            for (unsigned int j = 0; j < groupSize; j++)
+            {
+                Node* n = cursors[j];
+                if (n == NULL)
+                {
+                    continue;
+                }
+                int comparison = n->data.compare(elements[first + j]);
+                if (comparison == 0)
+                {
+                    results[first + j] = true;
+                    n = NULL;
+                }
+                else
+                {
+                    n = (comparison > 0) ? n->left : n->right;
+                    if (n == NULL)
+                    {
+                        results[first + j] = false;
+                    }
+                    else
+                    {
+                        prefetch(n);
+                    }
+                }
+                if (n == NULL)
+                {
+                    active--;
+                }
+                cursors[j] = n;
+            }
+        }
+    }
+}
+
+
+template <typename T>
+template <typename ForwardIt>
+void BSTSet<T>::buildFromSorted(ForwardIt begin, ForwardIt end)
+{
+    // check the order before touching the set
+    unsigned int count = countDistinctSorted(begin, end);
+    if (count == 0)
+    {
+        BSTSet empty;
+        empty.adjusting = adjusting;
+        swap(empty);
+        return;
+    }
+    Node* newRoot = buildInOrder(begin, end, count);
+    deallocate(root);
+    root = newRoot;
+    numberOfElements = count;
+}
+
+
+template <typename T>
+template <typename OutputIt>
+OutputIt BSTSet<T>::dumpSorted(OutputIt out) const
+{
+    if (!root->isCurrentNodeAdded)
+    {
+        return out;
+    }
+
+    // the nodes still to be written, apart from their right subtrees
+    std::vector<Node*> path;
+    Node* n = root;
+    while (n != NULL || !path.empty())
+    {
+        while (n != NULL)
+        {
+            path.push_back(n);
+            n = n->left;
+        }
+        n = path.back();
+        path.pop_back();
+        *out = n->data;
+        ++out;
+        n = n->right;
+    }
+    return out;
+}
+
+
 template <typename T>
 unsigned int BSTSet<T>::size() const
 {
@@ -282,6 +648,8 @@ void BSTSet<T>::insert(Node*& n, const T& element)
                 n->left->isCurrentNodeAdded = true;
                 n->left->isLeftNodeAdded = false;
                 n->left->isRightNodeAdded = false;
+                n->left->left = NULL;
+                n->left->right = NULL;
             }
             else
             {
@@ -299,6 +667,8 @@ void BSTSet<T>::insert(Node*& n, const T& element)
                 n->right->isCurrentNodeAdded = true;
                 n->right->isLeftNodeAdded = false;
                 n->right->isRightNodeAdded = false;
+                n->right->left = NULL;
+                n->right->right = NULL;
             }
             else
             {
@@ -339,19 +709,187 @@ const bool BSTSet<T>::find(Node* n, const T& element) const
 }
 
 
+template <typename T>
+void BSTSet<T>::splay(const T& element) const
+{
+    // top-down splaying: the nodes known to be less than element are
+    // gathered into a left tree, hanging from header.right, and the nodes
+    // known to be greater into a right tree, hanging from header.left;
+    // leftMax and rightMin are the nodes that the next ones are linked to
+    Node header;
+    header.left = NULL;
+    header.right = NULL;
+    Node* leftMax = &header;
+    Node* rightMin = &header;
+    Node* n = root;
+
+    while (true)
+    {
+        int comparison = n->data.compare(element);
+        if (comparison > 0)
+        {
+            if (n->left == NULL)
+            {
+                break;
+            }
+            if (n->left->data.compare(element) > 0)
+            {
+                // zig-zig: rotate right before moving on
+                Node* child = n->left;
+                setLeft(n, child->right);
+                setRight(child, n);
+                n = child;
+                if (n->left == NULL)
+                {
+                    break;
+                }
+            }
+            setLeft(rightMin, n);
+            rightMin = n;
+            n = n->left;
+        }
+        else if (comparison < 0)
+        {
+            if (n->right == NULL)
+            {
+                break;
+            }
+            if (n->right->data.compare(element) < 0)
+            {
+                // zag-zag: rotate left before moving on
+                Node* child = n->right;
+                setRight(n, child->left);
+                setLeft(child, n);
+                n = child;
+                if (n->right == NULL)
+                {
+                    break;
+                }
+            }
+            setRight(leftMax, n);
+            leftMax = n;
+            n = n->right;
+        }
+        else
+        {
+            break;
+        }
+    }
+
+    // reassemble the left tree, n and the right tree
+    setRight(leftMax, n->left);
+    setLeft(rightMin, n->right);
+    setLeft(n, header.right);
+    setRight(n, header.left);
+    root = n;
+}
+
+
+template <typename T>
+void BSTSet<T>::setLeft(Node* n, Node* child)
+{
+    n->left = child;
+    n->isLeftNodeAdded = (child != NULL);
+}
+
+
+template <typename T>
+void BSTSet<T>::setRight(Node* n, Node* child)
+{
+    n->right = child;
+    n->isRightNodeAdded = (child != NULL);
+}
+
+
 template <typename T>
 void BSTSet<T>::deallocate(Node* n)
 {
-    // go through every node. If it exists, delete it
-    if(n != NULL)
+    // the tree can be a chain as long as the set is big, so rather than
+    // recursing, rotate any left child up until there's none, then delete
+    // the node and move on to its right subtree
+    while (n != NULL)
     {
-        deallocate(n->left);
-        deallocate(n->right);
-        delete n;
+        if (n->left != NULL)
+        {
+            Node* left = n->left;
+            n->left = left->right;
+            left->right = n;
+            n = left;
+        }
+        else
+        {
+            Node* right = n->right;
+            delete n;
+            n = right;
+        }
     }
 }
 
 
+template <typename T>
+typename BSTSet<T>::Node* BSTSet<T>::copyNode(const Node* n)
+{
+    if (n == NULL)
+    {
+        return NULL;
+    }
+
+    // copy the nodes with a stack of our own rather than by recursing,
+    // since the tree can be a chain as long as the set is big; each copy
+    // starts out pointing at the original's children, which are replaced
+    // by their own copies when they're popped
+    Node* copy = new Node(*n);
+    std::vector<Node*> pending{copy};
+    while (!pending.empty())
+    {
+        Node* next = pending.back();
+        pending.pop_back();
+        if (next->left != NULL)
+        {
+            next->left = new Node(*next->left);
+            pending.push_back(next->left);
+        }
+        if (next->right != NULL)
+        {
+            next->right = new Node(*next->right);
+            pending.push_back(next->right);
+        }
+    }
+    return copy;
+}
+
+
+template <typename T>
+template <typename ForwardIt>
+typename BSTSet<T>::Node* BSTSet<T>::buildInOrder(ForwardIt& next, ForwardIt end, unsigned int count)
+{
+    if (count == 0)
+    {
+        return NULL;
+    }
+
+    // the elements arrive in order, so build the left subtree, then take
+    // the middle element, then build the right subtree
+    unsigned int leftCount = count / 2;
+    Node* left = buildInOrder(next, end, leftCount);
+    Node* n = new Node;
+    n->data = *next;
+    n->isCurrentNodeAdded = true;
+    setLeft(n, left);
+    next = nextDistinct(next, end);
+    setRight(n, buildInOrder(next, end, count - leftCount - 1));
+    return n;
+}
+
+
+// swap() lets BSTSets be exchanged with an unqualified call to swap()
+template <typename T>
+void swap(BSTSet<T>& a, BSTSet<T>& b) noexcept
+{
+    a.swap(b);
+}
+
+
 
 #endif // BSTSET_HPP
 
@@ -0,0 +1,933 @@
+// BasicWordChecker.hpp
+//
+// ICS 46 Spring 2015
+// Project #3: Set the Controls for the Heart of the Sun
+//
+// A BasicWordChecker does the work of a WordChecker, but is a template on
+// the type of Set that holds its words.  Given a concrete set type (such
+// as HashSet<std::string> or AVLSet<std::string>), every lookup is bound
+// at compile time to that type's contains(), rather than being dispatched
+// through Set's virtual functions, so the compiler is free to inline it.
+//
+// BasicWordChecker<Set<std::string>> works with any Set, at the cost of a
+// virtual call per lookup; WordChecker is a thin wrapper around it.
+//
+// TimerType says whether the latency of every wordExists() and
+// findSuggestions() call, and of each of the suggestion strategies within
+// findSuggestions(), is recorded in LatencyMetrics.  It's NoLatencyTimer
+// unless it says otherwise, which compiles away to nothing, so that
+// nothing is added to the lookups; a BasicWordChecker with a TimerType of
+// LatencyTimer reads the clock twice and records the difference for each
+// of them.
+//
+// When SetType has a containsMany() function, each strategy's candidates
+// are generated up front and looked up together in one batch, so that
+// the set can overlap the cache misses of the lookups.  If it's a set of
+// WordKeys, the candidates for a word of fewer than 16 characters are
+// made directly as WordKeys, each one a copy of the word's 16 bytes with
+// one edit made to it, rather than as std::strings that would then have
+// to be converted; longer words' candidates are converted a group at a
+// time.
+//
+// findSuggestions() can also write into a SuggestionBuffer owned by the
+// caller, which keeps its memory from one call to the next; checking
+// words in a loop with the same buffer does no heap allocation once the
+// buffer has grown to fit.
+//
+// The letters that the insertion and replacement strategies try are given
+// by AlphabetType (see Alphabet.hpp), A-Z unless it says otherwise.  Each
+// alphabet gets its own copy of those strategies, with the loop over its
+// letters unrolled and each letter a constant.
+//
+// A BasicWordChecker can also be given a WildcardIndex of the same words
+// as its set, in which case the insertion and replacement strategies ask
+// the index for every matching word at each position, rather than looking
+// up a candidate per letter per position in the set.  The index finds words
+// with any character at the wildcard's position, so only those whose
+// character there is one of AlphabetType's letters are suggested, the
+// same ones the set would have found.  The index matches a single byte,
+// so a Utf8Alphabet's characters are still looked up in the set, after
+// the index's matches, once the Utf8Alphabet has said which of them can
+// make a word.
+//
+// Given a PhoneticIndex, findSuggestions() also suggests words that sound
+// like the word, after the ones found by the five single-edit strategies.
+//
+// Given a SuggestionTable, findSuggestions() first looks the word up in
+// it, and only generates suggestions if the word isn't there.
+//
+// Given a Utf8Alphabet, findSuggestions() edits words that aren't pure
+// ASCII a UTF-8 character at a time rather than a byte at a time, trying
+// the alphabet's characters as well as AlphabetType's ASCII letters.
+// Pure ASCII words, which are checked for eight bytes at a time, are
+// still edited a byte at a time, with the Utf8Alphabet's characters tried
+// after AlphabetType's letters.  Either way, only the characters that the
+// Utf8Alphabet says make a word at a position are tried there, which
+// takes one hash lookup per position however many characters it has.
+// An ASCII word's positions rarely have any, and a small filter in the
+// Utf8Alphabet answers nearly all of its lookups without going further,
+// so those words cost about what they would without a Utf8Alphabet.
+
+#ifndef BASICWORDCHECKER_HPP
+#define BASICWORDCHECKER_HPP
+
+#include <algorithm>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "Alphabet.hpp"
+#include "LatencyHistogram.hpp"
+#include "PhoneticIndex.hpp"
+#include "Prefetch.hpp"
+#include "Set.hpp"
+#include "SuggestionTable.hpp"
+#include "SuggestionBuffer.hpp"
+#include "Utf8Alphabet.hpp"
+#include "WildcardIndex.hpp"
+#include "WordKey.hpp"
+
+
+
+// HasContainsMany<SetType> is true if SetType has a batched lookup of the
+// form containsMany(const std::string*, unsigned int, bool*).
+template <typename SetType, typename = void>
+struct HasContainsMany : std::false_type
+{
+};
+
+
+template <typename SetType>
+struct HasContainsMany<SetType, decltype(std::declval<const SetType&>().containsMany(
+    std::declval<const std::string*>(), 0u, std::declval<bool*>()))>
+    : std::true_type
+{
+};
+
+
+// HasWordKeyContainsMany<SetType> is true if SetType has a batched lookup
+// of WordKeys, of the form containsMany(const WordKey*, unsigned int, bool*).
+template <typename SetType, typename = void>
+struct HasWordKeyContainsMany : std::false_type
+{
+};
+
+
+template <typename SetType>
+struct HasWordKeyContainsMany<SetType, decltype(std::declval<const SetType&>().containsMany(
+    std::declval<const WordKey*>(), 0u, std::declval<bool*>()))>
+    : std::true_type
+{
+};
+
+
+
+template <typename SetType, typename AlphabetType = UppercaseAlphabet, typename TimerType = NoLatencyTimer>
+class BasicWordChecker
+{
+public:
+    // The most words that sound like a misspelled word that are suggested
+    // for it.
+    static constexpr unsigned int MAX_SOUND_ALIKES = 10;
+
+public:
+    // The constructor requires a set of words to be passed into it.  The
+    // BasicWordChecker stores a reference to it, so the set must outlive
+    // the checker.
+    BasicWordChecker(const SetType& words);
+
+
+    // This constructor also takes a WildcardIndex, which must contain the
+    // same words as the set.  The BasicWordChecker stores a reference to
+    // it, too, so it must also outlive the checker.
+    BasicWordChecker(const SetType& words, const WildcardIndex& wildcards);
+
+
+    // setPhoneticIndex() has findSuggestions() also suggest up to
+    // MAX_SOUND_ALIKES words that sound like the word, as found by the
+    // given index, which must contain the same words as the set.  The
+    // BasicWordChecker stores a reference to it, so it must outlive the
+    // checker.
+    void setPhoneticIndex(const PhoneticIndex& phonetics);
+
+
+    // setSuggestionTable() has findSuggestions() return the suggestions in
+    // the given table for the misspellings it has, rather than generating
+    // them.  The BasicWordChecker stores a reference to it, so it must
+    // outlive the checker.
+    void setSuggestionTable(const SuggestionTable& table);
+
+
+    // setUtf8Alphabet() has findSuggestions() edit words that aren't pure
+    // ASCII a UTF-8 character at a time, trying the given alphabet's
+    // characters, which must have been gathered from the set's words,
+    // since only those that make one of them are tried.  The
+    // BasicWordChecker stores a reference to it, so it must outlive the
+    // checker.
+    void setUtf8Alphabet(const Utf8Alphabet& utf8);
+
+
+    // wordExists() returns true if the given word is spelled correctly,
+    // false otherwise.
+    bool wordExists(const std::string& word) const;
+
+
+    // findSuggestions() returns a vector containing suggested alternative
+    // spellings for the given word, using the five algorithms described in
+    // the project write-up.  Each suggestion appears only once.
+    std::vector<std::string> findSuggestions(const std::string& word) const;
+
+
+    // findSuggestions() finds the same suggestions, in the same order, but
+    // replaces the contents of result with them rather than returning a
+    // new vector.  result's memory is reused, so once result has grown to
+    // fit the words being checked, no memory is allocated.
+    void findSuggestions(const std::string& word, SuggestionBuffer& result) const;
+
+
+private:
+    const SetType& words;
+
+    // the index used by the insertion and replacement strategies, or NULL
+    // if they look their candidates up in words
+    const WildcardIndex* wildcards;
+
+    // the index of words that sound alike, or NULL if sound-alikes aren't
+    // suggested
+    const PhoneticIndex* phonetics;
+
+    // the precomputed suggestions, or NULL if there are none
+    const SuggestionTable* table;
+
+    // the non-ASCII characters in the words, or NULL if words are edited a
+    // byte at a time
+    const Utf8Alphabet* utf8;
+
+    // finds the suggestions for a word that isn't pure ASCII, a UTF-8
+    // character at a time; utf8 must not be NULL
+    void findCharacterSuggestions(const std::string& word, SuggestionBuffer& result) const;
+
+    // finds the suggestions for a word shorter than WordKey::INLINE_CAPACITY
+    // when SetType has a containsMany() of WordKeys, making the candidates
+    // as WordKeys; it doesn't use the WildcardIndex or the Utf8Alphabet,
+    // so it's only called without them.  It returns false, having done
+    // nothing, if SetType isn't a set of WordKeys.
+    bool findKeySuggestions(const std::string& word, SuggestionBuffer& result, std::true_type) const;
+    bool findKeySuggestions(const std::string& word, SuggestionBuffer& result, std::false_type) const;
+
+    // calls function(characters, length) for each letter tried by the
+    // insertion and replacement strategies of findCharacterSuggestions()
+    // between word[0, prefixLength) and word[suffixStart, end): each of
+    // AlphabetType's ASCII letters, then each of the Utf8Alphabet's
+    // characters that makes a word there
+    template <typename Function>
+    void forEachCharacterLetter(
+        const std::string& word, std::size_t prefixLength, std::size_t suffixStart,
+        Function function) const;
+
+    // looks up a candidate in words, calling SetType's contains() directly
+    // unless SetType is abstract
+    bool lookup(const std::string& candidate) const;
+    bool lookup(const std::string& candidate, std::false_type) const;
+    bool lookup(const std::string& candidate, std::true_type) const;
+
+    // looks up count candidates at once, with SetType's containsMany() if
+    // it has one, or one lookup() at a time if it doesn't
+    void lookupMany(const std::string* candidates, unsigned int count, bool* found) const;
+    void lookupMany(
+        const std::string* candidates, unsigned int count, bool* found, std::true_type) const;
+    void lookupMany(
+        const std::string* candidates, unsigned int count, bool* found, std::false_type) const;
+
+    // does the same for a SetType without a containsMany() of strings, with
+    // its containsMany() of WordKeys if it has one
+    void lookupManyKeys(
+        const std::string* candidates, unsigned int count, bool* found, std::true_type) const;
+    void lookupManyKeys(
+        const std::string* candidates, unsigned int count, bool* found, std::false_type) const;
+
+    // returns candidates[index], growing candidates by one if that's needed;
+    // strings already in candidates are reused, along with their memory
+    static std::string& candidateAt(std::vector<std::string>& candidates, unsigned int index);
+
+    // looks up the first count of result's candidates and adds the ones
+    // that are words to its suggestions, in order
+    void addFound(SuggestionBuffer& result, unsigned int count, bool* found) const;
+
+    // does the same with the first count of result's keys
+    void addFoundKeys(SuggestionBuffer& result, unsigned int count, bool* found) const;
+
+    // adds candidate to result's suggestions if it isn't already there
+    void addSuggestion(SuggestionBuffer& result, const std::string& candidate) const;
+};
+
+
+
+template <typename SetType, typename AlphabetType, typename TimerType>
+BasicWordChecker<SetType, AlphabetType, TimerType>::BasicWordChecker(const SetType& words)
+    : words{words}, wildcards{NULL}, phonetics{NULL}, table{NULL}, utf8{NULL}
+{
+}
+
+
+template <typename SetType, typename AlphabetType, typename TimerType>
+BasicWordChecker<SetType, AlphabetType, TimerType>::BasicWordChecker(const SetType& words, const WildcardIndex& wildcards)
+    : words{words}, wildcards{&wildcards}, phonetics{NULL}, table{NULL}, utf8{NULL}
+{
+}
+
+
+template <typename SetType, typename AlphabetType, typename TimerType>
+void BasicWordChecker<SetType, AlphabetType, TimerType>::setPhoneticIndex(const PhoneticIndex& phonetics)
+{
+    this->phonetics = &phonetics;
+}
+
+
+template <typename SetType, typename AlphabetType, typename TimerType>
+void BasicWordChecker<SetType, AlphabetType, TimerType>::setSuggestionTable(const SuggestionTable& table)
+{
+    this->table = &table;
+}
+
+
+template <typename SetType, typename AlphabetType, typename TimerType>
+void BasicWordChecker<SetType, AlphabetType, TimerType>::setUtf8Alphabet(const Utf8Alphabet& utf8)
+{
+    this->utf8 = &utf8;
+}
+
+
+template <typename SetType, typename AlphabetType, typename TimerType>
+bool BasicWordChecker<SetType, AlphabetType, TimerType>::wordExists(const std::string& word) const
+{
+    TimerType timer{LatencyMetric::WordExists};
+    return lookup(word);
+}
+
+
+template <typename SetType, typename AlphabetType, typename TimerType>
+std::vector<std::string> BasicWordChecker<SetType, AlphabetType, TimerType>::findSuggestions(const std::string& word) const
+{
+    SuggestionBuffer result;
+    findSuggestions(word, result);
+    return result.toVector();
+}
+
+
+template <typename SetType, typename AlphabetType, typename TimerType>
+void BasicWordChecker<SetType, AlphabetType, TimerType>::findSuggestions(
+    const std::string& word, SuggestionBuffer& result) const
+{
+    TimerType timer{LatencyMetric::FindSuggestions};
+    result.clear();
+
+    if (table != NULL)
+    {
+        int count = table->forEachSuggestion(word,
+            [&](const char* characters, std::size_t suggestionLength)
+            {
+                result.append().assign(characters, suggestionLength);
+            });
+        if (count >= 0)
+        {
+            return;
+        }
+    }
+
+    std::string::size_type length = word.length();
+    if (utf8 != NULL && !Utf8Alphabet::isAscii(word.data(), length))
+    {
+        findCharacterSuggestions(word, result);
+        return;
+    }
+    unsigned int extraLetters = (utf8 != NULL) ? utf8->size() : 0;
+
+    if (extraLetters == 0 && wildcards == NULL && length < WordKey::INLINE_CAPACITY
+        && findKeySuggestions(word, result, HasWordKeyContainsMany<SetType>{}))
+    {
+        return;
+    }
+
+    // each strategy writes all of its candidates into result's candidates,
+    // reusing the strings already there, then looks them all up in one
+    // batch
+    std::vector<std::string>& candidates = result.candidates;
+    bool* found = result.reserveFound((AlphabetType::SIZE + extraLetters) * (length + 1) + 1);
+    unsigned int count;
+
+    // Swapping each adjacent pair of characters in the word.
+    {
+        TimerType strategyTimer{LatencyMetric::SwapStrategy};
+        count = 0;
+        for (std::string::size_type i = 0; i + 1 < length; i++)
+        {
+            std::string& candidate = candidateAt(candidates, count++);
+            candidate = word;
+            std::swap(candidate[i], candidate[i + 1]);
+        }
+        addFound(result, count, found);
+    }
+
+    // each word an index finds is copied into the first candidate, whose
+    // memory is reused, so that it can be compared with the suggestions
+    auto addMatch =
+        [&](const char* characters, std::size_t matchLength)
+        {
+            std::string& candidate = candidateAt(candidates, 0);
+            candidate.assign(characters, matchLength);
+            addSuggestion(result, candidate);
+        };
+
+    // Inserting each letter of the alphabet in between each adjacent pair
+    // of characters in the word, as well as at the beginning.  As in the
+    // original, the last position tries the word itself rather than
+    // adding a letter after the end.
+    if (wildcards != NULL)
+    {
+        TimerType strategyTimer{LatencyMetric::InsertStrategy};
+        for (std::string::size_type i = 0; i < length; i++)
+        {
+            wildcards->forEachInsertion(word, i,
+                [&](const char* characters, std::size_t matchLength)
+                {
+                    if (AlphabetType::contains(characters[i]))
+                    {
+                        addMatch(characters, matchLength);
+                    }
+                });
+        }
+        if (extraLetters != 0)
+        {
+            count = 0;
+            for (std::string::size_type i = 0; i < length; i++)
+            {
+                utf8->forEachLetterBetweenAscii(word.data(), i, word.data() + i, length - i,
+                    [&](const char* letter, std::size_t letterLength)
+                    {
+                        std::string& candidate = candidateAt(candidates, count++);
+                        candidate.assign(word, 0, i);
+                        candidate.append(letter, letterLength);
+                        candidate.append(word, i, std::string::npos);
+                    });
+            }
+            addFound(result, count, found);
+        }
+        if (lookup(word))
+        {
+            addSuggestion(result, word);
+        }
+    }
+    else
+    {
+        TimerType strategyTimer{LatencyMetric::InsertStrategy};
+        count = 0;
+        for (std::string::size_type i = 0; i < length; i++)
+        {
+            AlphabetType::forEachLetter(
+                [&](char c)
+                {
+                    std::string& candidate = candidateAt(candidates, count++);
+                    candidate.assign(word, 0, i);
+                    candidate += c;
+                    candidate.append(word, i, std::string::npos);
+                });
+            if (extraLetters != 0)
+            {
+                utf8->forEachLetterBetweenAscii(word.data(), i, word.data() + i, length - i,
+                    [&](const char* letter, std::size_t letterLength)
+                    {
+                        std::string& candidate = candidateAt(candidates, count++);
+                        candidate.assign(word, 0, i);
+                        candidate.append(letter, letterLength);
+                        candidate.append(word, i, std::string::npos);
+                    });
+            }
+        }
+        candidateAt(candidates, count++) = word;
+        addFound(result, count, found);
+    }
+
+    // Deleting each character from the word.
+    {
+        TimerType strategyTimer{LatencyMetric::DeleteStrategy};
+        count = 0;
+        for (std::string::size_type i = 0; i < length; i++)
+        {
+            std::string& candidate = candidateAt(candidates, count++);
+            candidate.assign(word, 0, i);
+            candidate.append(word, i + 1, std::string::npos);
+        }
+        addFound(result, count, found);
+    }
+
+    // Replacing each character in the word with each letter of the alphabet.
+    if (wildcards != NULL)
+    {
+        TimerType strategyTimer{LatencyMetric::ReplaceStrategy};
+        for (std::string::size_type i = 0; i < length; i++)
+        {
+            wildcards->forEachReplacement(word, i,
+                [&](const char* characters, std::size_t matchLength)
+                {
+                    if (AlphabetType::contains(characters[i]))
+                    {
+                        addMatch(characters, matchLength);
+                    }
+                });
+        }
+        if (extraLetters != 0)
+        {
+            count = 0;
+            for (std::string::size_type i = 0; i < length; i++)
+            {
+                utf8->forEachLetterBetweenAscii(word.data(), i, word.data() + i + 1, length - i - 1,
+                    [&](const char* letter, std::size_t letterLength)
+                    {
+                        std::string& candidate = candidateAt(candidates, count++);
+                        candidate.assign(word, 0, i);
+                        candidate.append(letter, letterLength);
+                        candidate.append(word, i + 1, std::string::npos);
+                    });
+            }
+            addFound(result, count, found);
+        }
+    }
+    else
+    {
+        TimerType strategyTimer{LatencyMetric::ReplaceStrategy};
+        count = 0;
+        for (std::string::size_type i = 0; i < length; i++)
+        {
+            AlphabetType::forEachLetter(
+                [&](char c)
+                {
+                    std::string& candidate = candidateAt(candidates, count++);
+                    candidate = word;
+                    candidate[i] = c;
+                });
+            if (extraLetters != 0)
+            {
+                utf8->forEachLetterBetweenAscii(word.data(), i, word.data() + i + 1, length - i - 1,
+                    [&](const char* letter, std::size_t letterLength)
+                    {
+                        std::string& candidate = candidateAt(candidates, count++);
+                        candidate.assign(word, 0, i);
+                        candidate.append(letter, letterLength);
+                        candidate.append(word, i + 1, std::string::npos);
+                    });
+            }
+        }
+        addFound(result, count, found);
+    }
+
+    // Splitting the word into a pair of words by adding a space in between
+    // each adjacent pair of characters; as in the original, the word with
+    // the space in it is looked up as it is.
+    {
+        TimerType strategyTimer{LatencyMetric::SplitStrategy};
+        count = 0;
+        for (std::string::size_type i = 1; i < length; i++)
+        {
+            std::string& candidate = candidateAt(candidates, count++);
+            candidate.assign(word, 0, i);
+            candidate += ' ';
+            candidate.append(word, i, std::string::npos);
+        }
+        addFound(result, count, found);
+    }
+
+    // Words that sound like the word, however they're spelled.
+    if (phonetics != NULL)
+    {
+        TimerType strategyTimer{LatencyMetric::PhoneticStrategy};
+        phonetics->forEachSoundAlike(word, MAX_SOUND_ALIKES, addMatch);
+    }
+}
+
+
+template <typename SetType, typename AlphabetType, typename TimerType>
+void BasicWordChecker<SetType, AlphabetType, TimerType>::findCharacterSuggestions(
+    const std::string& word, SuggestionBuffer& result) const
+{
+    // the same strategies as findSuggestions(), in the same order, but
+    // character k of the word is bytes [starts[k], starts[k + 1]); the
+    // WildcardIndex matches single bytes, so it isn't used here
+    std::vector<unsigned int>& starts = result.characterStarts;
+    unsigned int length = Utf8Alphabet::findCharacters(word, starts);
+
+    std::vector<std::string>& candidates = result.candidates;
+    bool* found = result.reserveFound((AlphabetType::SIZE + utf8->size()) * (length + 1) + 1);
+    unsigned int count;
+
+    // Swapping each adjacent pair of characters in the word.
+    {
+        TimerType strategyTimer{LatencyMetric::SwapStrategy};
+        count = 0;
+        for (unsigned int k = 0; k + 1 < length; k++)
+        {
+            std::string& candidate = candidateAt(candidates, count++);
+            candidate.assign(word, 0, starts[k]);
+            candidate.append(word, starts[k + 1], starts[k + 2] - starts[k + 1]);
+            candidate.append(word, starts[k], starts[k + 1] - starts[k]);
+            candidate.append(word, starts[k + 2], std::string::npos);
+        }
+        addFound(result, count, found);
+    }
+
+    // Inserting each letter in between each adjacent pair of characters in
+    // the word, as well as at the beginning, then trying the word itself.
+    {
+        TimerType strategyTimer{LatencyMetric::InsertStrategy};
+        count = 0;
+        for (unsigned int k = 0; k < length; k++)
+        {
+            forEachCharacterLetter(word, starts[k], starts[k],
+                [&](const char* letter, std::size_t letterLength)
+                {
+                    std::string& candidate = candidateAt(candidates, count++);
+                    candidate.assign(word, 0, starts[k]);
+                    candidate.append(letter, letterLength);
+                    candidate.append(word, starts[k], std::string::npos);
+                });
+        }
+        candidateAt(candidates, count++) = word;
+        addFound(result, count, found);
+    }
+
+    // Deleting each character from the word.
+    {
+        TimerType strategyTimer{LatencyMetric::DeleteStrategy};
+        count = 0;
+        for (unsigned int k = 0; k < length; k++)
+        {
+            std::string& candidate = candidateAt(candidates, count++);
+            candidate.assign(word, 0, starts[k]);
+            candidate.append(word, starts[k + 1], std::string::npos);
+        }
+        addFound(result, count, found);
+    }
+
+    // Replacing each character in the word with each letter.
+    {
+        TimerType strategyTimer{LatencyMetric::ReplaceStrategy};
+        count = 0;
+        for (unsigned int k = 0; k < length; k++)
+        {
+            forEachCharacterLetter(word, starts[k], starts[k + 1],
+                [&](const char* letter, std::size_t letterLength)
+                {
+                    std::string& candidate = candidateAt(candidates, count++);
+                    candidate.assign(word, 0, starts[k]);
+                    candidate.append(letter, letterLength);
+                    candidate.append(word, starts[k + 1], std::string::npos);
+                });
+        }
+        addFound(result, count, found);
+    }
+
+    // Splitting the word into a pair of words by adding a space in between
+    // each adjacent pair of characters, looked up as it is.
+    {
+        TimerType strategyTimer{LatencyMetric::SplitStrategy};
+        count = 0;
+        for (unsigned int k = 1; k < length; k++)
+        {
+            std::string& candidate = candidateAt(candidates, count++);
+            candidate.assign(word, 0, starts[k]);
+            candidate += ' ';
+            candidate.append(word, starts[k], std::string::npos);
+        }
+        addFound(result, count, found);
+    }
+
+    // Words that sound like the word, however they're spelled.
+    if (phonetics != NULL)
+    {
+        TimerType strategyTimer{LatencyMetric::PhoneticStrategy};
+        phonetics->forEachSoundAlike(word, MAX_SOUND_ALIKES,
+            [&](const char* characters, std::size_t matchLength)
+            {
+                std::string& candidate = candidateAt(candidates, 0);
+                candidate.assign(characters, matchLength);
+                addSuggestion(result, candidate);
+            });
+    }
+}
+
+
+template <typename SetType, typename AlphabetType, typename TimerType>
+bool BasicWordChecker<SetType, AlphabetType, TimerType>::findKeySuggestions(
+    const std::string& word, SuggestionBuffer& result, std::true_type) const
+{
+    // the same strategies as findSuggestions(), in the same order, with
+    // each candidate made from the word's WordKey by one edit
+    WordKey key{word};
+    std::string::size_type length = word.length();
+
+    std::vector<WordKey>& keys = result.keys;
+    unsigned int capacity = AlphabetType::SIZE * (length + 1) + 1;
+    if (keys.size() < capacity)
+    {
+        keys.resize(capacity);
+    }
+    bool* found = result.reserveFound(capacity);
+    unsigned int count;
+
+    // Swapping each adjacent pair of characters in the word.
+    {
+        TimerType strategyTimer{LatencyMetric::SwapStrategy};
+        count = 0;
+        for (std::string::size_type i = 0; i + 1 < length; i++)
+        {
+            keys[count++].assignSwap(key, i);
+        }
+        addFoundKeys(result, count, found);
+    }
+
+    // Inserting each letter of the alphabet in between each adjacent pair
+    // of characters in the word, as well as at the beginning, then trying
+    // the word itself.
+    {
+        TimerType strategyTimer{LatencyMetric::InsertStrategy};
+        count = 0;
+        for (std::string::size_type i = 0; i < length; i++)
+        {
+            AlphabetType::forEachLetter(
+                [&](char c)
+                {
+                    keys[count++].assignInsert(key, i, c);
+                });
+        }
+        keys[count++] = key;
+        addFoundKeys(result, count, found);
+    }
+
+    // Deleting each character from the word.
+    {
+        TimerType strategyTimer{LatencyMetric::DeleteStrategy};
+        count = 0;
+        for (std::string::size_type i = 0; i < length; i++)
+        {
+            keys[count++].assignErase(key, i);
+        }
+        addFoundKeys(result, count, found);
+    }
+
+    // Replacing each character in the word with each letter of the alphabet.
+    {
+        TimerType strategyTimer{LatencyMetric::ReplaceStrategy};
+        count = 0;
+        for (std::string::size_type i = 0; i < length; i++)
+        {
+            AlphabetType::forEachLetter(
+                [&](char c)
+                {
+                    keys[count++].assignReplace(key, i, c);
+                });
+        }
+        addFoundKeys(result, count, found);
+    }
+
+    // Splitting the word into a pair of words by adding a space in between
+    // each adjacent pair of characters, looked up as it is.
+    {
+        TimerType strategyTimer{LatencyMetric::SplitStrategy};
+        count = 0;
+        for (std::string::size_type i = 1; i < length; i++)
+        {
+            keys[count++].assignInsert(key, i, ' ');
+        }
+        addFoundKeys(result, count, found);
+    }
+
+    // Words that sound like the word, however they're spelled.
+    if (phonetics != NULL)
+    {
+        TimerType strategyTimer{LatencyMetric::PhoneticStrategy};
+        phonetics->forEachSoundAlike(word, MAX_SOUND_ALIKES,
+            [&](const char* characters, std::size_t matchLength)
+            {
+                std::string& candidate = candidateAt(result.candidates, 0);
+                candidate.assign(characters, matchLength);
+                addSuggestion(result, candidate);
+            });
+    }
+
+    return true;
+}
+
+
+template <typename SetType, typename AlphabetType, typename TimerType>
+bool BasicWordChecker<SetType, AlphabetType, TimerType>::findKeySuggestions(
+    const std::string&, SuggestionBuffer&, std::false_type) const
+{
+    return false;
+}
+
+
+template <typename SetType, typename AlphabetType, typename TimerType>
+template <typename Function>
+void BasicWordChecker<SetType, AlphabetType, TimerType>::forEachCharacterLetter(
+    const std::string& word, std::size_t prefixLength, std::size_t suffixStart,
+    Function function) const
+{
+    // AlphabetType's letters past ASCII (such as Latin-1's) aren't UTF-8;
+    // once the call is unrolled, c is a constant, so the test is decided
+    // at compile time
+    AlphabetType::forEachLetter(
+        [&](char c)
+        {
+            if (static_cast<unsigned char>(c) < 0x80)
+            {
+                function(&c, 1);
+            }
+        });
+    utf8->forEachLetterBetween(
+        word.data(), prefixLength, word.data() + suffixStart, word.size() - suffixStart, function);
+}
+
+
+template <typename SetType, typename AlphabetType, typename TimerType>
+bool BasicWordChecker<SetType, AlphabetType, TimerType>::lookup(const std::string& candidate) const
+{
+    return lookup(candidate, std::is_abstract<SetType>{});
+}
+
+
+template <typename SetType, typename AlphabetType, typename TimerType>
+bool BasicWordChecker<SetType, AlphabetType, TimerType>::lookup(
+    const std::string& candidate, std::false_type) const
+{
+    // a qualified call is bound statically, so it can be inlined
+    return words.SetType::contains(candidate);
+}
+
+
+template <typename SetType, typename AlphabetType, typename TimerType>
+bool BasicWordChecker<SetType, AlphabetType, TimerType>::lookup(
+    const std::string& candidate, std::true_type) const
+{
+    // an abstract SetType's contains() may be pure virtual (as Set's is),
+    // so it has to be called virtually
+    return words.contains(candidate);
+}
+
+
+template <typename SetType, typename AlphabetType, typename TimerType>
+void BasicWordChecker<SetType, AlphabetType, TimerType>::lookupMany(
+    const std::string* candidates, unsigned int count, bool* found) const
+{
+    lookupMany(candidates, count, found, HasContainsMany<SetType>{});
+}
+
+
+template <typename SetType, typename AlphabetType, typename TimerType>
+void BasicWordChecker<SetType, AlphabetType, TimerType>::lookupMany(
+    const std::string* candidates, unsigned int count, bool* found, std::true_type) const
+{
+    words.SetType::containsMany(candidates, count, found);
+}
+
+
+template <typename SetType, typename AlphabetType, typename TimerType>
+void BasicWordChecker<SetType, AlphabetType, TimerType>::lookupMany(
+    const std::string* candidates, unsigned int count, bool* found, std::false_type) const
+{
+    lookupManyKeys(candidates, count, found, HasWordKeyContainsMany<SetType>{});
+}
+
+
+template <typename SetType, typename AlphabetType, typename TimerType>
+void BasicWordChecker<SetType, AlphabetType, TimerType>::lookupManyKeys(
+    const std::string* candidates, unsigned int count, bool* found, std::true_type) const
+{
+    WordKey keys[PREFETCH_GROUP_SIZE];
+    for (unsigned int first = 0; first < count; first += PREFETCH_GROUP_SIZE)
+    {
+        unsigned int groupSize = std::min(PREFETCH_GROUP_SIZE, count - first);
+        for (unsigned int j = 0; j < groupSize; j++)
+        {
+            keys[j].assign(candidates[first + j]);
+        }
+        words.SetType::containsMany(keys, groupSize, found + first);
+    }
+}
+
+
+template <typename SetType, typename AlphabetType, typename TimerType>
+void BasicWordChecker<SetType, AlphabetType, TimerType>::lookupManyKeys(
+    const std::string* candidates, unsigned int count, bool* found, std::false_type) const
+{
+    for (unsigned int i = 0; i < count; i++)
+    {
+        found[i] = lookup(candidates[i]);
+    }
+}
+
+
+template <typename SetType, typename AlphabetType, typename TimerType>
+std::string& BasicWordChecker<SetType, AlphabetType, TimerType>::candidateAt(
+    std::vector<std::string>& candidates, unsigned int index)
+{
+    if (index == candidates.size())
+    {
+        candidates.emplace_back();
+    }
+    return candidates[index];
+}
+
+
+template <typename SetType, typename AlphabetType, typename TimerType>
+void BasicWordChecker<SetType, AlphabetType, TimerType>::addFound(
+    SuggestionBuffer& result, unsigned int count, bool* found) const
+{
+    lookupMany(result.candidates.data(), count, found);
+    for (unsigned int i = 0; i < count; i++)
+    {
+        if (found[i])
+        {
+            addSuggestion(result, result.candidates[i]);
+        }
+    }
+}
+
+
+template <typename SetType, typename AlphabetType, typename TimerType>
+void BasicWordChecker<SetType, AlphabetType, TimerType>::addFoundKeys(
+    SuggestionBuffer& result, unsigned int count, bool* found) const
+{
+    // this is only called by findKeySuggestions(), so SetType has a
+    // containsMany() of WordKeys; each key that's found is copied into the
+    // first candidate, whose memory is reused, to be compared with the
+    // suggestions
+    words.SetType::containsMany(result.keys.data(), count, found);
+    for (unsigned int i = 0; i < count; i++)
+    {
+        if (found[i])
+        {
+            std::string& candidate = candidateAt(result.candidates, 0);
+            candidate.assign(result.keys[i].data(), result.keys[i].size());
+            addSuggestion(result, candidate);
+        }
+    }
+}
+
+
+template <typename SetType, typename AlphabetType, typename TimerType>
+void BasicWordChecker<SetType, AlphabetType, TimerType>::addSuggestion(
+    SuggestionBuffer& result, const std::string& candidate) const
+{
+    for (const std::string& suggestion : result)
+    {
+        if (suggestion == candidate)
+        {
+            return;
+        }
+    }
+    result.append() = candidate;
+}
+
+
+
+#endif // BASICWORDCHECKER_HPP
@@ -0,0 +1,95 @@
+// BloomFilter.cpp
+//
+// ICS 46 Spring 2015
+// Project #3: Set the Controls for the Heart of the Sun
+
+#include "BloomFilter.hpp"
+#include <stdexcept>
+#include "HashPolicy.hpp"
+
+
+
+BloomFilter::BloomFilter(unsigned int blockCount)
+    : bits(static_cast<std::size_t>(blockCount) * WORDS_PER_BLOCK, 0), blocks{blockCount}
+{
+    if (blockCount == 0)
+    {
+        throw std::invalid_argument{"BloomFilter: there must be at least one block"};
+    }
+}
+
+
+unsigned int BloomFilter::blocksFor(unsigned int expectedCount, unsigned int bitsPerElement)
+{
+    unsigned long long totalBits = static_cast<unsigned long long>(expectedCount) * bitsPerElement;
+    unsigned long long blockCount = (totalBits + BLOCK_BITS - 1) / BLOCK_BITS;
+    return blockCount == 0 ? 1 : blockCount;
+}
+
+
+void BloomFilter::add(const std::string& element)
+{
+    std::uint32_t h1;
+    std::uint32_t h2;
+    unsigned int first = locate(element, h1, h2);
+    for (unsigned int i = 0; i < HASH_COUNT; i++)
+    {
+        unsigned int bit = (h1 + i * h2) % BLOCK_BITS;
+        bits[first + bit / 64] |= std::uint64_t{1} << (bit % 64);
+    }
+}
+
+
+bool BloomFilter::mayContain(const std::string& element) const
+{
+    std::uint32_t h1;
+    std::uint32_t h2;
+    unsigned int first = locate(element, h1, h2);
+    for (unsigned int i = 0; i < HASH_COUNT; i++)
+    {
+        unsigned int bit = (h1 + i * h2) % BLOCK_BITS;
+        if ((bits[first + bit / 64] & (std::uint64_t{1} << (bit % 64))) == 0)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+
+void BloomFilter::merge(const BloomFilter& other)
+{
+    if (other.blocks != blocks)
+    {
+        throw std::invalid_argument{"BloomFilter: can't merge filters with different block counts"};
+    }
+    for (std::size_t i = 0; i < bits.size(); i++)
+    {
+        bits[i] |= other.bits[i];
+    }
+}
+
+
+unsigned int BloomFilter::blockCount() const
+{
+    return blocks;
+}
+
+
+std::size_t BloomFilter::bytes() const
+{
+    return bits.size() * sizeof(std::uint64_t);
+}
+
+
+unsigned int BloomFilter::locate(const std::string& element, std::uint32_t& h1, std::uint32_t& h2) const
+{
+    // the high half of the hash picks the block, without a division; the
+    // low half and a remix of the whole hash pick the bits within it, and
+    // h2 is odd so that the HASH_COUNT bits are all different
+    std::uint64_t h = wyhash(element.data(), element.size());
+    unsigned int block = ((h >> 32) * blocks) >> 32;
+    h1 = static_cast<std::uint32_t>(h);
+    h2 = static_cast<std::uint32_t>(wyhashDetail::mix(h, wyhashDetail::SECRET2)) | 1;
+    return block * WORDS_PER_BLOCK;
+}
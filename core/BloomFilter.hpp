@@ -0,0 +1,92 @@
+// BloomFilter.hpp
+//
+// ICS 46 Spring 2015
+// Project #3: Set the Controls for the Heart of the Sun
+//
+// A BloomFilter answers whether a string might have been added to it.
+// It can say yes when the string wasn't added (with a probability that
+// depends on how many bits it has per string), but never says no when
+// the string was, so a "no" lets a lookup skip the set it stands in
+// front of.
+//
+// This is a blocked Bloom filter: its bits are split into 512-bit
+// blocks, the size of a cache line, and all of a string's bits are set
+// in one block chosen by its hash.  Checking a string therefore touches
+// one block, at the cost of a slightly higher false positive rate than
+// spreading the bits over the whole filter would give.
+//
+// Two filters with the same number of blocks can be merged, giving a
+// filter of everything added to either one.
+
+#ifndef BLOOMFILTER_HPP
+#define BLOOMFILTER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+
+
+class BloomFilter
+{
+public:
+    // The number of bits per string that blocksFor() plans for unless
+    // told otherwise, which gives a false positive rate of about 1%.
+    static constexpr unsigned int DEFAULT_BITS_PER_ELEMENT = 10;
+
+    // The number of bits set for each string.
+    static constexpr unsigned int HASH_COUNT = 7;
+
+    // The number of bits in a block.
+    static constexpr unsigned int BLOCK_BITS = 512;
+
+public:
+    // Initializes an empty BloomFilter with the given number of blocks,
+    // which must be at least 1.
+    explicit BloomFilter(unsigned int blockCount);
+
+    // blocksFor() returns the number of blocks a BloomFilter needs to hold
+    // the given number of strings with the given number of bits apiece.
+    static unsigned int blocksFor(
+        unsigned int expectedCount, unsigned int bitsPerElement = DEFAULT_BITS_PER_ELEMENT);
+
+
+    // add() sets the bits of a string.
+    void add(const std::string& element);
+
+
+    // mayContain() returns false if the string was certainly never added,
+    // true if it may have been.
+    bool mayContain(const std::string& element) const;
+
+
+    // merge() adds everything that was added to another filter to this
+    // one.  Throws a std::invalid_argument if the two filters don't have
+    // the same number of blocks.
+    void merge(const BloomFilter& other);
+
+
+    // blockCount() returns the number of blocks in the filter.
+    unsigned int blockCount() const;
+
+
+    // bytes() returns the memory used by the filter's bits.
+    std::size_t bytes() const;
+
+
+private:
+    static constexpr unsigned int WORDS_PER_BLOCK = BLOCK_BITS / 64;
+
+    // the bits, WORDS_PER_BLOCK words per block
+    std::vector<std::uint64_t> bits;
+    unsigned int blocks;
+
+    // returns the first word of a string's block, and the two values that
+    // its bit positions within the block are derived from
+    unsigned int locate(const std::string& element, std::uint32_t& h1, std::uint32_t& h2) const;
+};
+
+
+
+#endif // BLOOMFILTER_HPP
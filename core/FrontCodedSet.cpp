@@ -0,0 +1,220 @@
+// FrontCodedSet.cpp
+//
+// ICS 46 Spring 2015
+// Project #3: Set the Controls for the Heart of the Sun
+
+#include "FrontCodedSet.hpp"
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+
+namespace
+{
+    // reads a varint, advancing p past it; lengths under 128, which is
+    // nearly all of them, take one byte
+    inline std::size_t readLength(const unsigned char*& p)
+    {
+        std::size_t length = *p & 0x7f;
+        unsigned int shift = 7;
+        while (*p++ & 0x80)
+        {
+            length |= static_cast<std::size_t>(*p & 0x7f) << shift;
+            shift += 7;
+        }
+        return length;
+    }
+
+
+    // compares two strings of bytes the way std::string does
+    int compare(
+        const unsigned char* a, std::size_t aLength,
+        const unsigned char* b, std::size_t bLength)
+    {
+        int result = std::memcmp(a, b, std::min(aLength, bLength));
+        if (result != 0)
+        {
+            return result;
+        }
+        return aLength < bLength ? -1 : (aLength > bLength ? 1 : 0);
+    }
+}
+
+
+
+FrontCodedSet::FrontCodedSet(const std::vector<std::string>& words, unsigned int blockSize)
+    : wordsPerBlock{blockSize}
+{
+    if (blockSize < MIN_BLOCK_SIZE || blockSize > MAX_BLOCK_SIZE)
+    {
+        throw std::invalid_argument{"FrontCodedSet: block size out of range"};
+    }
+
+    std::vector<std::string> sorted = words;
+    std::sort(sorted.begin(), sorted.end());
+    sorted.erase(std::unique(sorted.begin(), sorted.end()), sorted.end());
+    numberOfElements = sorted.size();
+
+    for (unsigned int i = 0; i < sorted.size(); i++)
+    {
+        const std::string& word = sorted[i];
+        std::size_t shared = 0;
+        if (i % wordsPerBlock == 0)
+        {
+            blockStarts.push_back(encoded.size());
+        }
+        else
+        {
+            const std::string& previous = sorted[i - 1];
+            while (shared < previous.size() && shared < word.size() && previous[shared] == word[shared])
+            {
+                shared++;
+            }
+        }
+
+        appendLength(shared);
+        appendLength(word.size() - shared);
+        encoded.insert(encoded.end(), word.begin() + shared, word.end());
+    }
+
+    encoded.shrink_to_fit();
+    blockStarts.shrink_to_fit();
+}
+
+
+bool FrontCodedSet::isImplemented() const
+{
+    return true;
+}
+
+
+void FrontCodedSet::add(const std::string&)
+{
+    throw std::logic_error{"FrontCodedSet: cannot add to a read-only set"};
+}
+
+
+bool FrontCodedSet::contains(const std::string& element) const
+{
+    const unsigned char* word = reinterpret_cast<const unsigned char*>(element.data());
+    std::size_t length = element.size();
+
+    int block = findBlock(word, length);
+    if (block < 0)
+    {
+        return false;
+    }
+
+    const unsigned char* p = encoded.data() + blockStarts[block];
+    const unsigned char* end = static_cast<unsigned int>(block) + 1 < blockStarts.size()
+        ? encoded.data() + blockStarts[block + 1]
+        : encoded.data() + encoded.size();
+
+    // matched is the number of leading characters that the entry before
+    // the current one shares with the word; that entry always sorts
+    // before the word, since the scan stops at the first that doesn't
+    std::size_t matched = 0;
+    bool first = true;
+    while (p < end)
+    {
+        std::size_t shared = readLength(p);
+        std::size_t suffixLength = readLength(p);
+        const unsigned char* suffix = p;
+        p += suffixLength;
+
+        if (!first)
+        {
+            if (shared < matched)
+            {
+                // this entry differs from the one before it at a position
+                // where the one before matched the word, and it's larger
+                // there, so it sorts after the word
+                return false;
+            }
+            else if (shared > matched)
+            {
+                // this entry agrees with the one before it where the one
+                // before fell short of the word, so it sorts before the
+                // word too
+                continue;
+            }
+        }
+        first = false;
+
+        std::size_t entryLength = shared + suffixLength;
+        std::size_t i = shared;
+        while (i < entryLength && i < length && suffix[i - shared] == word[i])
+        {
+            i++;
+        }
+        matched = i;
+
+        if (i == length)
+        {
+            // the word is a prefix of this entry, so they're equal or the
+            // entry sorts after it
+            return i == entryLength;
+        }
+        else if (i < entryLength && suffix[i - shared] > word[i])
+        {
+            return false;
+        }
+    }
+
+    return false;
+}
+
+
+unsigned int FrontCodedSet::size() const
+{
+    return numberOfElements;
+}
+
+
+unsigned int FrontCodedSet::blockSize() const
+{
+    return wordsPerBlock;
+}
+
+
+std::size_t FrontCodedSet::bytes() const
+{
+    return encoded.capacity() + blockStarts.capacity() * sizeof(unsigned int);
+}
+
+
+int FrontCodedSet::findBlock(const unsigned char* word, std::size_t length) const
+{
+    // the first entry of a block has a shared length of 0, so its first
+    // byte is 0 and the suffix length follows it
+    int low = 0;
+    int high = static_cast<int>(blockStarts.size()) - 1;
+    int found = -1;
+    while (low <= high)
+    {
+        int middle = low + (high - low) / 2;
+        const unsigned char* p = encoded.data() + blockStarts[middle] + 1;
+        std::size_t firstLength = readLength(p);
+        if (compare(p, firstLength, word, length) <= 0)
+        {
+            found = middle;
+            low = middle + 1;
+        }
+        else
+        {
+            high = middle - 1;
+        }
+    }
+    return found;
+}
+
+
+void FrontCodedSet::appendLength(std::size_t length)
+{
+    while (length >= 0x80)
+    {
+        encoded.push_back(static_cast<unsigned char>(length | 0x80));
+        length >>= 7;
+    }
+    encoded.push_back(static_cast<unsigned char>(length));
+}
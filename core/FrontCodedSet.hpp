@@ -0,0 +1,102 @@
+// FrontCodedSet.hpp
+//
+// ICS 46 Spring 2015
+// Project #3: Set the Controls for the Heart of the Sun
+//
+// A FrontCodedSet is a read-only implementation of a Set of strings that
+// stores its words sorted and compressed.  Sorted words share long
+// prefixes with their neighbors (INTER, INTERNAL, INTERNATIONAL, ...), so
+// the words are grouped into blocks, and within a block each word after
+// the first is stored as the length of the prefix it shares with the word
+// before it, followed by only the characters after that prefix.  The
+// first word of each block is stored in full, and an index records where
+// each block starts.
+//
+// A lookup binary-searches the first words of the blocks to find the one
+// block that could contain the word, then scans that block.  The scan
+// never rebuilds the words it passes: it keeps track of how many leading
+// characters of the word being looked up match the current entry, and
+// the shared-prefix length of each entry is usually enough to tell,
+// without looking at its characters, that it sorts before the word being
+// looked up, or after it (which ends the search).
+
+#ifndef FRONTCODEDSET_HPP
+#define FRONTCODEDSET_HPP
+
+#include <cstddef>
+#include <string>
+#include <vector>
+#include "Set.hpp"
+
+
+
+class FrontCodedSet : public Set<std::string>
+{
+public:
+    // The smallest, largest and default number of words per block.  Larger
+    // blocks save a little more space and make lookups scan further.
+    static constexpr unsigned int MIN_BLOCK_SIZE = 16;
+    static constexpr unsigned int MAX_BLOCK_SIZE = 64;
+    static constexpr unsigned int DEFAULT_BLOCK_SIZE = 32;
+
+public:
+    // Builds a FrontCodedSet containing the given words, which needn't be
+    // sorted.  Duplicate words are allowed and are stored only once.
+    // Throws a std::invalid_argument if blockSize isn't between
+    // MIN_BLOCK_SIZE and MAX_BLOCK_SIZE.
+    explicit FrontCodedSet(
+        const std::vector<std::string>& words,
+        unsigned int blockSize = DEFAULT_BLOCK_SIZE);
+
+
+    // isImplemented() returns true, since FrontCodedSet is implemented.
+    virtual bool isImplemented() const;
+
+
+    // A FrontCodedSet can't be changed after it's built, so add() always
+    // throws a std::logic_error.
+    virtual void add(const std::string& element);
+
+
+    // contains() returns true if the given element is one of the set's
+    // words, false otherwise.  It takes O(log(n / blockSize)) comparisons
+    // to find the block, then a scan of at most blockSize entries.
+    virtual bool contains(const std::string& element) const;
+
+
+    // size() returns the number of elements in the set.
+    virtual unsigned int size() const;
+
+
+    // blockSize() returns the number of words per block.
+    unsigned int blockSize() const;
+
+
+    // bytes() returns the memory used by the encoded words and the block
+    // index, not counting the FrontCodedSet object itself.
+    std::size_t bytes() const;
+
+
+private:
+    unsigned int wordsPerBlock;
+    unsigned int numberOfElements;
+
+    // the blocks, back to back; each entry is a shared-prefix length (0
+    // for the first entry of a block), a suffix length and the suffix,
+    // with the lengths stored as varints
+    std::vector<unsigned char> encoded;
+
+    // blockStarts[b] is the position in encoded where block b begins
+    std::vector<unsigned int> blockStarts;
+
+    // returns the index of the last block whose first word is no greater
+    // than the given one, or -1 if there is no such block
+    int findBlock(const unsigned char* word, std::size_t length) const;
+
+    // appends a varint to encoded
+    void appendLength(std::size_t length);
+};
+
+
+
+#endif // FRONTCODEDSET_HPP
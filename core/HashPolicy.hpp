@@ -0,0 +1,207 @@
+// HashPolicy.hpp
+//
+// ICS 46 Spring 2015
+// Project #3: Set the Controls for the Heart of the Sun
+//
+// Hash policies are small function objects that a HashSet takes as a
+// template parameter.  Because the policy's type is known at compile time,
+// the compiler can inline the call to it in add() and contains(), which
+// isn't possible when the hash function is hidden behind a std::function.
+//
+// DefaultHash<T> is the policy a HashSet uses unless it's told otherwise.
+// For std::string it uses wyhash (https://github.com/wangyi-fudan/wyhash),
+// a fast, well-distributed hash for short keys such as dictionary words;
+// for any other type it falls back to std::hash.
+//
+// FunctionHash<T> is the policy for a hash function that's only chosen at
+// run time, the way the original interface worked.  It pays for an
+// indirect call on every hash, but only the HashSets that use it do.
+
+#ifndef HASHPOLICY_HPP
+#define HASHPOLICY_HPP
+
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <string>
+
+
+
+namespace wyhashDetail
+{
+    // the default secret from the reference implementation
+    constexpr std::uint64_t SECRET0 = 0x2d358dccaa6c78a5ull;
+    constexpr std::uint64_t SECRET1 = 0x8bb84b93962eacc9ull;
+    constexpr std::uint64_t SECRET2 = 0x4b33a62ed433d4a3ull;
+    constexpr std::uint64_t SECRET3 = 0x4d5a2da51de1aa47ull;
+
+
+    // multiplies A and B into a 128-bit product, leaving the low half in A
+    // and the high half in B
+    inline void multiply(std::uint64_t& a, std::uint64_t& b)
+    {
+#if defined(__SIZEOF_INT128__)
+        __uint128_t product = a;
+        product *= b;
+        a = static_cast<std::uint64_t>(product);
+        b = static_cast<std::uint64_t>(product >> 64);
+#else
+        std::uint64_t ha = a >> 32, hb = b >> 32;
+        std::uint64_t la = static_cast<std::uint32_t>(a);
+        std::uint64_t lb = static_cast<std::uint32_t>(b);
+        std::uint64_t rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+        std::uint64_t t = rl + (rm0 << 32);
+        std::uint64_t c = t < rl;
+        std::uint64_t lo = t + (rm1 << 32);
+        c += lo < t;
+        std::uint64_t hi = rh + (rm0 >> 32) + (rm1 >> 32) + c;
+        a = lo;
+        b = hi;
+#endif
+    }
+
+
+    inline std::uint64_t mix(std::uint64_t a, std::uint64_t b)
+    {
+        multiply(a, b);
+        return a ^ b;
+    }
+
+
+    inline std::uint64_t read8(const unsigned char* p)
+    {
+        std::uint64_t v;
+        std::memcpy(&v, p, 8);
+        return v;
+    }
+
+
+    inline std::uint64_t read4(const unsigned char* p)
+    {
+        std::uint32_t v;
+        std::memcpy(&v, p, 4);
+        return v;
+    }
+
+
+    inline std::uint64_t read3(const unsigned char* p, std::size_t k)
+    {
+        return (static_cast<std::uint64_t>(p[0]) << 16)
+            | (static_cast<std::uint64_t>(p[k >> 1]) << 8)
+            | p[k - 1];
+    }
+}
+
+
+// wyhash() hashes len bytes starting at key into a 64-bit value.  Different
+// seeds give independent hash functions over the same keys.
+inline std::uint64_t wyhash(const void* key, std::size_t len, std::uint64_t seed = 0)
+{
+    using namespace wyhashDetail;
+
+    const unsigned char* p = static_cast<const unsigned char*>(key);
+    seed ^= mix(seed ^ SECRET0, SECRET1);
+    std::uint64_t a;
+    std::uint64_t b;
+
+    if (len <= 16)
+    {
+        if (len >= 4)
+        {
+            a = (read4(p) << 32) | read4(p + ((len >> 3) << 2));
+            b = (read4(p + len - 4) << 32) | read4(p + len - 4 - ((len >> 3) << 2));
+        }
+        else if (len > 0)
+        {
+            a = read3(p, len);
+            b = 0;
+        }
+        else
+        {
+            a = 0;
+            b = 0;
+        }
+    }
+    else
+    {
+        std::size_t i = len;
+        if (i > 48)
+        {
+            std::uint64_t see1 = seed;
+            std::uint64_t see2 = seed;
+            do
+            {
+                seed = mix(read8(p) ^ SECRET1, read8(p + 8) ^ seed);
+                see1 = mix(read8(p + 16) ^ SECRET2, read8(p + 24) ^ see1);
+                see2 = mix(read8(p + 32) ^ SECRET3, read8(p + 40) ^ see2);
+                p += 48;
+                i -= 48;
+            }
+            while (i > 48);
+            seed ^= see1 ^ see2;
+        }
+        while (i > 16)
+        {
+            seed = mix(read8(p) ^ SECRET1, read8(p + 8) ^ seed);
+            i -= 16;
+            p += 16;
+        }
+        a = read8(p + i - 16);
+        b = read8(p + i - 8);
+    }
+
+    a ^= SECRET1;
+    b ^= seed;
+    multiply(a, b);
+    return mix(a ^ SECRET0 ^ len, b ^ SECRET1);
+}
+
+
+
+// DefaultHash<T> hashes with std::hash<T>, folded down to the unsigned int
+// that a HashSet expects.
+template <typename T>
+struct DefaultHash
+{
+    unsigned int operator()(const T& element) const
+    {
+        std::uint64_t h = std::hash<T>{}(element);
+        return static_cast<unsigned int>(h ^ (h >> 32));
+    }
+};
+
+
+// DefaultHash<std::string> hashes with wyhash.
+template <>
+struct DefaultHash<std::string>
+{
+    unsigned int operator()(const std::string& element) const
+    {
+        std::uint64_t h = wyhash(element.data(), element.size());
+        return static_cast<unsigned int>(h ^ (h >> 32));
+    }
+};
+
+
+// FunctionHash<T> hashes with the std::function it was given, so a
+// HashSet<T, FunctionHash<T>> can be handed any hash function at run time.
+template <typename T>
+struct FunctionHash
+{
+    FunctionHash(std::function<unsigned int(const T&)> function)
+        : function{function}
+    {
+    }
+
+    unsigned int operator()(const T& element) const
+    {
+        return function(element);
+    }
+
+    std::function<unsigned int(const T&)> function;
+};
+
+
+
+#endif // HASHPOLICY_HPP
+
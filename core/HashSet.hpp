@@ -23,12 +23,45 @@
 #ifndef HASHSET_HPP
 #define HASHSET_HPP
 
+#include <algorithm>
+#include <cstddef>
 #include <functional>
+#include <iterator>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "HashPolicy.hpp"
+#include "Parallel.hpp"
+#include "Prefetch.hpp"
 #include "Set.hpp"
 
 
 
-template <typename T>
+// ChainOrder says how a HashSet orders the elements within each chain.
+// In real text a small number of words make up most of the lookups, so
+// keeping those at the front of their chains means they're found on the
+// first comparison.
+//
+//   Insertion          elements stay in the order they were added
+//   SuppliedFrequency  elements are kept in descending order of the
+//                      frequencies given to add(element, frequency)
+//   ObservedFrequency  as SuppliedFrequency, except that every successful
+//                      contains() also counts as one use of the element
+//                      and moves it ahead of any less-used ones.  This
+//                      makes contains() modify the chains, so a HashSet
+//                      in this mode mustn't be read by several threads
+//                      at once.
+enum class ChainOrder
+{
+    Insertion,
+    SuppliedFrequency,
+    ObservedFrequency
+};
+
+
+
+template <typename T, typename HashPolicy = DefaultHash<T>>
 class HashSet : public Set<T>
 {
 public:
@@ -36,12 +69,30 @@ public:
     // added to it.
     static constexpr unsigned int DEFAULT_CAPACITY = 10;
 
-    // A HashFunction
+    // A HashFunction is a hash function chosen at run time.
     typedef std::function<unsigned int(const T&)> HashFunction;
 
 public:
+    // Initializes a HashSet to be empty, so that it will hash elements
+    // with its HashPolicy.  The policy is part of the HashSet's type, so
+    // calls to it can be inlined.
+    HashSet();
+
+    // Initializes a HashSet to be empty, so that it will hash elements
+    // with the given HashPolicy object.  This is how a policy that carries
+    // state, such as a FunctionHash wrapping a HashFunction, is given its
+    // state: HashSet<T, FunctionHash<T>>{hashFunction} works the way a
+    // HashSet given a hash function did in the original interface.
+    explicit HashSet(HashPolicy hashPolicy);
+
     // Initializes a HashSet to be empty, so that it will use the given
-    // hash function whenever it needs to hash an element.
+    // hash function whenever it needs to hash an element; this is the
+    // original interface, kept so that code written against it still
+    // compiles.  A policy that can hold a HashFunction, such as
+    // FunctionHash, is given it.  Any other policy is set aside, and the
+    // function is kept alongside it and called instead, indirectly; every
+    // HashSet pays for a check of whether it has one, but only the
+    // HashSets that do pay for the call.
     HashSet(HashFunction hashFunction);
 
     // Cleans up the HashSet so that it leaks no memory.
@@ -50,9 +101,26 @@ public:
     // Initializes a new HashSet to be a copy of an existing one.
     HashSet(const HashSet& s);
 
+    // Initializes a new HashSet by taking over the array and nodes of an
+    // existing one, which is left empty.  No nodes are copied, and nothing
+    // is allocated: s is left with a single bucket of its own, which its
+    // next add() outgrows.  Only the HashPolicy is copied, so that s can
+    // still hash; that can't fail unless the policy's copy can.  A hash
+    // function kept alongside the policy is taken over too, so s hashes
+    // with its policy from then on.
+    HashSet(HashSet&& s) noexcept(std::is_nothrow_copy_constructible<HashPolicy>::value);
+
     // Assigns an existing HashSet into another.
     HashSet& operator=(const HashSet& s);
 
+    // Moves the array and nodes of an existing HashSet into another, in
+    // constant time.
+    HashSet& operator=(HashSet&& s) noexcept;
+
+    // swap() exchanges the contents of two HashSets, including their hash
+    // policies, in constant time by exchanging their arrays.
+    void swap(HashSet& s) noexcept;
+
 
     // isImplemented() should be modified to return true if you've
     // decided to implement a HashSet, false otherwise.
@@ -69,12 +137,60 @@ public:
     virtual void add(const T& element);
 
 
+    // add() adds an element to the set, like add(element), and adds
+    // frequency to the number of uses recorded for it.  Unless the chain
+    // order is Insertion, the element is then moved ahead of any element
+    // in its chain that has been used less.
+    void add(const T& element, unsigned int frequency);
+
+
+    // setChainOrder() changes how the elements in each chain are ordered
+    // from now on.  Switching to one of the frequency orders sorts every
+    // chain by the uses recorded so far, in linear time.  Switching back
+    // to Insertion leaves the chains as they are, since the order in which
+    // elements were added isn't recorded.
+    void setChainOrder(ChainOrder order);
+
+
+    // chainOrder() returns how the elements in each chain are ordered.
+    ChainOrder chainOrder() const;
+
+
+    // addAll() adds every element in the range [begin, end) to the set,
+    // using threadCount threads.  The array is resized once, up front,
+    // to fit the whole range.  Then each thread hashes a slice of the
+    // range and sorts its elements by which thread owns their bucket; each
+    // thread owns a contiguous block of buckets.  Finally, each thread
+    // links the elements for its own buckets into place, so no two threads
+    // ever touch the same chain and no locking is needed.  Each chain ends
+    // up in the same order that add() would have produced.
+    template <typename RandomIt>
+    void addAll(RandomIt begin, RandomIt end, unsigned int threadCount = defaultThreadCount());
+
+
     // contains() returns true if the given element is already in the set,
     // false otherwise.  This function runs in constant time (with respect
     // to the number of elements, assuming a good hash function).
     virtual bool contains(const T& element) const;
 
 
+    // probesFor() returns the number of elements that contains() would
+    // compare the given element against, without recording a use of it.
+    unsigned int probesFor(const T& element) const;
+
+
+    // containsMany() looks up count elements at once, setting results[i]
+    // to whether elements[i] is in the set.  It works through them in
+    // groups: it hashes every element of a group and prefetches their
+    // buckets, then reads the buckets and prefetches the first node of
+    // each chain, then walks the chains side by side, prefetching each
+    // chain's next node as it goes.  That way the cache misses of a group
+    // overlap rather than following one another.  When the chain order is
+    // ObservedFrequency, it calls contains() for each element instead, so
+    // that every lookup is counted.
+    void containsMany(const T* elements, unsigned int count, bool* results) const;
+
+
     // size() returns the number of elements in the set.
     virtual unsigned int size() const;
 
@@ -82,11 +198,70 @@ public:
     {
         T data;
         Node* next;
+        // the number of uses recorded for data
+        unsigned int frequency;
     };
 
+    // An Iterator visits the elements of the set bucket by bucket, in no
+    // particular order.  Adding elements to the set, or looking them up
+    // in ObservedFrequency order, invalidates it.
+    class Iterator
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const T*;
+        using reference = const T&;
+
+        const T& operator*() const;
+        const T* operator->() const;
+        Iterator& operator++();
+        Iterator operator++(int);
+        bool operator==(const Iterator& other) const;
+        bool operator!=(const Iterator& other) const;
+
+    private:
+        friend class HashSet;
+
+        Iterator(const HashSet* set, int bucket, Node* node);
+
+        const HashSet* set;
+
+        // the current bucket and node, or the set's capacity and NULL at
+        // the end
+        int bucket;
+        Node* node;
+
+        // moves to the first node in the next nonempty bucket, if there's
+        // no current node
+        void skipEmptyBuckets();
+    };
+
+    // begin() returns an Iterator at the set's first element, and end() one
+    // past its last.
+    Iterator begin() const;
+    Iterator end() const;
+
+    // bucketCount() returns the number of buckets, and forEachInBuckets()
+    // calls callback(element) for each element in buckets [first, last),
+    // so that the buckets can be split among threads.
+    unsigned int bucketCount() const;
+
+    template <typename Callback>
+    void forEachInBuckets(unsigned int first, unsigned int last, Callback callback) const;
+
 
 private:
-    HashFunction hashFunction;
+    // the hash policy, whose type is known at compile time
+    HashPolicy hashPolicy;
+
+    // the hash function given to a HashSet whose policy couldn't hold it,
+    // which is used instead of the policy; otherwise NULL
+    FunctionHash<T>* functionHash;
+
+    // how the elements in each chain are ordered
+    ChainOrder order;
 
     // store the current capacity
     int expandableCapacity;
@@ -97,18 +272,43 @@ private:
     // a Node array for storing element
     Node** hashNode;
 
+    // the one bucket that hashNode points to after the set has been moved
+    // from, so that it needn't allocate an array until it's added to again
+    Node* emptyBucket;
+
+    // hands a HashFunction to a policy that can hold one
+    HashSet(HashFunction hashFunction, std::true_type);
+
+    // keeps a HashFunction alongside a policy that can't hold one
+    HashSet(HashFunction hashFunction, std::false_type);
+
+    // hashes an element with functionHash, if there is one, or hashPolicy
+    unsigned int hash(const T& element) const;
+
+    // doubles the capacity and moves every node into its new bucket
+    void resize();
+
+    // links element onto the end of the chain in the given bucket, unless
+    // it's already in that chain; returns true if it was linked
+    bool insert(unsigned int index, const T& element);
+
+    // records frequency more uses of the node that *link points to, in the
+    // chain in the given bucket, and moves it ahead of every node before it
+    // that has been used less
+    void promote(unsigned int index, Node** link, unsigned int frequency) const;
+
     // helper function for destructor
     void deallocate(Node* n);
 };
 
 
 
-template <typename T>
-HashSet<T>::HashSet(HashFunction hashFunction)
-    : hashFunction{hashFunction}
+template <typename T, typename HashPolicy>
+HashSet<T, HashPolicy>::HashSet()
+    : hashPolicy{}, functionHash{NULL}, order{ChainOrder::Insertion}, emptyBucket{NULL}
 {
-    hashNode = new Node*[10];
-    expandableCapacity = 10;
+    hashNode = new Node*[DEFAULT_CAPACITY];
+    expandableCapacity = DEFAULT_CAPACITY;
     numberOfElements = 0;
     for (int i = 0; i < expandableCapacity; i++)
     {
@@ -117,128 +317,516 @@ HashSet<T>::HashSet(HashFunction hashFunction)
 }
 
 
-template <typename T>
-HashSet<T>::~HashSet()
+template <typename T, typename HashPolicy>
+HashSet<T, HashPolicy>::HashSet(HashPolicy hashPolicy)
+    : hashPolicy{hashPolicy}, functionHash{NULL}, order{ChainOrder::Insertion}, emptyBucket{NULL}
+{
+    hashNode = new Node*[DEFAULT_CAPACITY];
+    expandableCapacity = DEFAULT_CAPACITY;
+    numberOfElements = 0;
+    for (int i = 0; i < expandableCapacity; i++)
+    {
+        hashNode[i] = NULL;
+    }
+}
+
+
+template <typename T, typename HashPolicy>
+HashSet<T, HashPolicy>::HashSet(HashFunction hashFunction)
+    : HashSet{hashFunction, std::is_constructible<HashPolicy, HashFunction>{}}
+{
+}
+
+
+template <typename T, typename HashPolicy>
+HashSet<T, HashPolicy>::HashSet(HashFunction hashFunction, std::true_type)
+    : HashSet{HashPolicy{hashFunction}}
+{
+}
+
+
+template <typename T, typename HashPolicy>
+HashSet<T, HashPolicy>::HashSet(HashFunction hashFunction, std::false_type)
+    : HashSet{}
+{
+    functionHash = new FunctionHash<T>{hashFunction};
+}
+
+
+template <typename T, typename HashPolicy>
+HashSet<T, HashPolicy>::~HashSet()
 {
     for (int i = 0; i < expandableCapacity; i++)
     {
         deallocate(hashNode[i]);
     }
-    delete[] hashNode;
+    if (hashNode != &emptyBucket)
+    {
+        delete[] hashNode;
+    }
+    delete functionHash;
 }
 
 
-template <typename T>
-HashSet<T>::HashSet(const HashSet& s)
-    : hashFunction{s.hashFunction}
+template <typename T, typename HashPolicy>
+HashSet<T, HashPolicy>::HashSet(const HashSet& s)
+    : hashPolicy{s.hashPolicy}, functionHash{NULL}, order{s.order}, emptyBucket{NULL}
 {
+    if (s.functionHash != NULL)
+    {
+        functionHash = new FunctionHash<T>{*s.functionHash};
+    }
+
+    // copy every chain of s, keeping each element in the same bucket and
+    // in the same order, so nothing needs to be rehashed
     this->expandableCapacity = s.expandableCapacity;
-    this->hashNode = s.hashNode;
+    this->numberOfElements = s.numberOfElements;
+    this->hashNode = new Node*[expandableCapacity];
+    for (int i = 0; i < expandableCapacity; i++)
+    {
+        Node** tail = &hashNode[i];
+        for (Node* entry = s.hashNode[i]; entry != NULL; entry = entry->next)
+        {
+            *tail = new Node{entry->data, NULL, entry->frequency};
+            tail = &(*tail)->next;
+        }
+        *tail = NULL;
+    }
+}
+
+
+template <typename T, typename HashPolicy>
+HashSet<T, HashPolicy>::HashSet(HashSet&& s)
+    noexcept(std::is_nothrow_copy_constructible<HashPolicy>::value)
+    : hashPolicy{s.hashPolicy}, functionHash{NULL}, order{s.order},
+      expandableCapacity{1}, numberOfElements{0},
+      hashNode{&emptyBucket}, emptyBucket{NULL}
+{
+    // start out with just the one empty bucket, then trade places with s
+    swap(s);
 }
 
 
-template <typename T>
-HashSet<T>& HashSet<T>::operator=(const HashSet& s)
+template <typename T, typename HashPolicy>
+HashSet<T, HashPolicy>& HashSet<T, HashPolicy>::operator=(const HashSet& s)
 {
+    // copy s on the side, then trade places with the copy, whose
+    // destructor cleans up the old nodes
     if (this != &s)
     {
-        this->hashFunction = s.hashFunction;
-        this->expandableCapacity = s.expandableCapacity;
-        this->hashNode = s.hashNode;
+        HashSet copy{s};
+        swap(copy);
     }
     return *this;
 }
 
 
-template <typename T>
-bool HashSet<T>::isImplemented() const
+template <typename T, typename HashPolicy>
+HashSet<T, HashPolicy>& HashSet<T, HashPolicy>::operator=(HashSet&& s) noexcept
+{
+    // the old nodes end up in s, which will clean them up
+    swap(s);
+    return *this;
+}
+
+
+template <typename T, typename HashPolicy>
+void HashSet<T, HashPolicy>::swap(HashSet& s) noexcept
+{
+    // a set that's using its own empty bucket has to go on using its own
+    // after the swap, so the bucket travels with the contents
+    bool hadEmptyBucket = (hashNode == &emptyBucket);
+    bool sHadEmptyBucket = (s.hashNode == &s.emptyBucket);
+    std::swap(hashPolicy, s.hashPolicy);
+    std::swap(functionHash, s.functionHash);
+    std::swap(order, s.order);
+    std::swap(expandableCapacity, s.expandableCapacity);
+    std::swap(numberOfElements, s.numberOfElements);
+    std::swap(hashNode, s.hashNode);
+    std::swap(emptyBucket, s.emptyBucket);
+    if (sHadEmptyBucket)
+    {
+        hashNode = &emptyBucket;
+    }
+    if (hadEmptyBucket)
+    {
+        s.hashNode = &s.emptyBucket;
+    }
+}
+
+
+template <typename T, typename HashPolicy>
+bool HashSet<T, HashPolicy>::isImplemented() const
 {
     return true;
 }
 
 
-template <typename T>
-void HashSet<T>::add(const T& element)
+template <typename T, typename HashPolicy>
+void HashSet<T, HashPolicy>::add(const T& element)
 {
-    if (!contains(element))
+    // find the element's chain only once; insert() walks it to the end
+    // anyway, so it checks for the element on the way rather than calling
+    // contains() first
+    unsigned int hashCode = hash(element);
+    if (insert(hashCode % expandableCapacity, element))
     {
         numberOfElements++;
-        unsigned int hashCode = hashFunction(element);
-        double exceedCapacity = numberOfElements/expandableCapacity;
-        if (exceedCapacity >= 0.8)
+        double exceedCapacity = static_cast<double>(numberOfElements) / expandableCapacity;
+        if (exceedCapacity > 0.8)
         {
-            expandableCapacity = expandableCapacity*2;
-            Node** newHashNode = new Node*[expandableCapacity];
-            for (int i = 0; i < expandableCapacity; i++)
+            resize();
+        }
+    }
+}
+
+
+template <typename T, typename HashPolicy>
+void HashSet<T, HashPolicy>::add(const T& element, unsigned int frequency)
+{
+    // add the element (with no uses) if it's new, which links it at the
+    // end of its chain, then find it and promote it from there
+    add(element);
+    unsigned int index = hash(element) % expandableCapacity;
+    Node** link = &hashNode[index];
+    while ((*link)->data != element)
+    {
+        link = &(*link)->next;
+    }
+    promote(index, link, frequency);
+}
+
+
+template <typename T, typename HashPolicy>
+void HashSet<T, HashPolicy>::setChainOrder(ChainOrder order)
+{
+    if (order != ChainOrder::Insertion && this->order == ChainOrder::Insertion)
+    {
+        // a stable sort keeps equally-used elements in the order they were
+        // added; chains are short, so insertion sort is the right one
+        for (int i = 0; i < expandableCapacity; i++)
+        {
+            Node* sorted = NULL;
+            Node* entry = hashNode[i];
+            while (entry != NULL)
             {
-                newHashNode[i] = NULL;
+                Node* next = entry->next;
+                Node** place = &sorted;
+                while (*place != NULL && (*place)->frequency >= entry->frequency)
+                {
+                    place = &(*place)->next;
+                }
+                entry->next = *place;
+                *place = entry;
+                entry = next;
             }
-            int index = 0;
-            while (index < expandableCapacity/2)
+            hashNode[i] = sorted;
+        }
+    }
+    this->order = order;
+}
+
+
+template <typename T, typename HashPolicy>
+ChainOrder HashSet<T, HashPolicy>::chainOrder() const
+{
+    return order;
+}
+
+
+template <typename T, typename HashPolicy>
+template <typename RandomIt>
+void HashSet<T, HashPolicy>::addAll(RandomIt begin, RandomIt end, unsigned int threadCount)
+{
+    unsigned int count = end - begin;
+    if (threadCount <= 1 || count < threadCount)
+    {
+        for (RandomIt i = begin; i != end; ++i)
+        {
+            add(*i);
+        }
+        return;
+    }
+
+    // make room for everything at once, as though every element were new
+    while (static_cast<double>(numberOfElements) + count > 0.8 * expandableCapacity)
+    {
+        resize();
+    }
+
+    // outbox[t * threadCount + owner] holds the (position, bucket) pairs that
+    // thread t found in its slice for the buckets owned by thread owner
+    struct Entry
+    {
+        unsigned int position;
+        unsigned int index;
+    };
+    std::vector<std::vector<Entry>> outbox(threadCount * threadCount);
+    unsigned int capacity = expandableCapacity;
+
+    runInParallel(threadCount,
+        [&](unsigned int t)
+        {
+            unsigned int last = sliceBegin(count, threadCount, t + 1);
+            for (unsigned int i = sliceBegin(count, threadCount, t); i < last; i++)
             {
-                newHashNode[index] = hashNode[index];
-                index++;
+                unsigned int index = hash(begin[i]) % capacity;
+                unsigned int owner = static_cast<unsigned long long>(index) * threadCount / capacity;
+                outbox[t * threadCount + owner].push_back(Entry{i, index});
             }
-            delete[] hashNode;
-            hashNode = newHashNode;
-         }
-        Node* prev = NULL;
-        Node* entry = hashNode[hashCode];
-        while (entry != NULL)
+        });
+
+    std::vector<int> added(threadCount, 0);
+    runInParallel(threadCount,
+        [&](unsigned int owner)
+        {
+            for (unsigned int t = 0; t < threadCount; t++)
+            {
+                for (const Entry& entry : outbox[t * threadCount + owner])
+                {
+                    if (insert(entry.index, begin[entry.position]))
+                    {
+                        added[owner]++;
+                    }
+                }
+            }
+        });
+
+    for (int n : added)
+    {
+        numberOfElements += n;
+    }
+}
+
+
+template <typename T, typename HashPolicy>
+bool HashSet<T, HashPolicy>::contains(const T& element) const
+{
+    unsigned int index = hash(element) % expandableCapacity;
+    Node** link = &hashNode[index];
+    while (*link != NULL)
+    {
+        if ((*link)->data == element)
         {
-            prev = entry;
-            entry = entry->next;
+            if (order == ChainOrder::ObservedFrequency)
+            {
+                promote(index, link, 1);
+            }
+            return true;
+        }
+        link = &(*link)->next;
+    }
+    return false;
+}
+
+
+template <typename T, typename HashPolicy>
+unsigned int HashSet<T, HashPolicy>::probesFor(const T& element) const
+{
+    unsigned int probes = 0;
+    for (Node* entry = hashNode[hash(element) % expandableCapacity]; entry != NULL; entry = entry->next)
+    {
+        probes++;
+        if (entry->data == element)
+        {
+            break;
+        }
+    }
+    return probes;
+}
+
+
+template <typename T, typename HashPolicy>
+void HashSet<T, HashPolicy>::containsMany(const T* elements, unsigned int count, bool* results) const
+{
+    if (order == ChainOrder::ObservedFrequency)
+    {
+        for (unsigned int i = 0; i < count; i++)
+        {
+            results[i] = contains(elements[i]);
         }
-        if (entry == NULL)
+        return;
+    }
+
+    Node* cursors[PREFETCH_GROUP_SIZE];
+    unsigned int indexes[PREFETCH_GROUP_SIZE];
+    for (unsigned int first = 0; first < count; first += PREFETCH_GROUP_SIZE)
+    {
+        unsigned int groupSize = std::min(PREFETCH_GROUP_SIZE, count - first);
+
+        for (unsigned int j = 0; j < groupSize; j++)
+        {
+            indexes[j] = hash(elements[first + j]) % expandableCapacity;
+            prefetch(&hashNode[indexes[j]]);
+        }
+
+        unsigned int active = groupSize;
+        for (unsigned int j = 0; j < groupSize; j++)
         {
-            entry = new Node;
-            if (prev == NULL)
+            cursors[j] = hashNode[indexes[j]];
+            if (cursors[j] == NULL)
             {
-                hashNode[hashCode] = entry;
+                results[first + j] = false;
+                active--;
             }
             else
             {
-                prev->next = entry;
+                prefetch(cursors[j]);
             }
         }
-        else
+
+        // compare one node of every chain still being walked per pass
+        while (active > 0)
         {
-            entry->data = element;
+            for (unsigned int j = 0; j < groupSize; j++)
+            {
+                Node* entry = cursors[j];
+                if (entry == NULL)
+                {
+                    continue;
+                }
+                if (entry->data == elements[first + j])
+                {
+                    results[first + j] = true;
+                    entry = NULL;
+                }
+                else
+                {
+                    entry = entry->next;
+                    if (entry == NULL)
+                    {
+                        results[first + j] = false;
+                    }
+                    else
+                    {
+                        prefetch(entry);
+                    }
+                }
+                if (entry == NULL)
+                {
+                    active--;
+                }
+                cursors[j] = entry;
+            }
+        }
+    }
+}
+
+
+template <typename T, typename HashPolicy>
+unsigned int HashSet<T, HashPolicy>::size() const
+{
+    return numberOfElements;
+}
+
+
+template <typename T, typename HashPolicy>
+unsigned int HashSet<T, HashPolicy>::hash(const T& element) const
+{
+    if (functionHash != NULL)
+    {
+        return (*functionHash)(element);
+    }
+    return hashPolicy(element);
+}
+
+
+template <typename T, typename HashPolicy>
+void HashSet<T, HashPolicy>::resize()
+{
+    int newCapacity = expandableCapacity * 2;
+    Node** newHashNode = new Node*[newCapacity];
+    for (int i = 0; i < newCapacity; i++)
+    {
+        newHashNode[i] = NULL;
+    }
+    // relink every node at the tail of its new chain, so that each chain
+    // keeps the order in which its elements were added
+    Node** tails = new Node*[newCapacity];
+    for (int i = 0; i < newCapacity; i++)
+    {
+        tails[i] = NULL;
+    }
+    for (int i = 0; i < expandableCapacity; i++)
+    {
+        Node* entry = hashNode[i];
+        while (entry != NULL)
+        {
+            Node* next = entry->next;
+            unsigned int index = hash(entry->data) % newCapacity;
             entry->next = NULL;
+            if (tails[index] == NULL)
+            {
+                newHashNode[index] = entry;
+            }
+            else
+            {
+                tails[index]->next = entry;
+            }
+            tails[index] = entry;
+            entry = next;
         }
     }
+    delete[] tails;
+    if (hashNode != &emptyBucket)
+    {
+        delete[] hashNode;
+    }
+    else
+    {
+        emptyBucket = NULL;
+    }
+    hashNode = newHashNode;
+    expandableCapacity = newCapacity;
 }
 
 
-template <typename T>
-bool HashSet<T>::contains(const T& element) const
+template <typename T, typename HashPolicy>
+bool HashSet<T, HashPolicy>::insert(unsigned int index, const T& element)
 {
-    bool isContained = false;
-    /*bool check = true;
-    unsigned int hashCode = hashFunction(element);
-    Node* entry = hashNode[hashCode];
-    while (entry != NULL && check)
+    Node** tail = &hashNode[index];
+    while (*tail != NULL)
     {
-        if (entry->data == element)
+        if ((*tail)->data == element)
         {
-            isContained = true;
-            check = false;
+            return false;
         }
-        entry = entry->next;
-    }*/
-    return isContained;
+        tail = &(*tail)->next;
+    }
+    *tail = new Node{element, NULL, 0};
+    return true;
 }
 
 
-template <typename T>
-unsigned int HashSet<T>::size() const
+template <typename T, typename HashPolicy>
+void HashSet<T, HashPolicy>::promote(unsigned int index, Node** link, unsigned int frequency) const
 {
-    return numberOfElements;
+    Node* entry = *link;
+    unsigned int limit = std::numeric_limits<unsigned int>::max();
+    entry->frequency = (frequency > limit - entry->frequency) ? limit : entry->frequency + frequency;
+    if (order == ChainOrder::Insertion)
+    {
+        return;
+    }
+
+    // the chain is in descending order of uses, so the node belongs just
+    // after the last node that has been used at least as much as it has
+    Node** place = &hashNode[index];
+    while (*place != entry && (*place)->frequency >= entry->frequency)
+    {
+        place = &(*place)->next;
+    }
+    if (*place != entry)
+    {
+        *link = entry->next;
+        entry->next = *place;
+        *place = entry;
+    }
 }
 
 
-template <typename T>
-void HashSet<T>::deallocate(Node* n)
+template <typename T, typename HashPolicy>
+void HashSet<T, HashPolicy>::deallocate(Node* n)
 {
     if (n != NULL)
     {
@@ -248,6 +836,115 @@ void HashSet<T>::deallocate(Node* n)
 }
 
 
+// swap() lets HashSets be exchanged with an unqualified call to swap()
+template <typename T, typename HashPolicy>
+void swap(HashSet<T, HashPolicy>& a, HashSet<T, HashPolicy>& b) noexcept
+{
+    a.swap(b);
+}
+
+
+template <typename T, typename HashPolicy>
+typename HashSet<T, HashPolicy>::Iterator HashSet<T, HashPolicy>::begin() const
+{
+    Iterator i{this, 0, hashNode[0]};
+    i.skipEmptyBuckets();
+    return i;
+}
+
+
+template <typename T, typename HashPolicy>
+typename HashSet<T, HashPolicy>::Iterator HashSet<T, HashPolicy>::end() const
+{
+    return Iterator{this, expandableCapacity, NULL};
+}
+
+
+template <typename T, typename HashPolicy>
+unsigned int HashSet<T, HashPolicy>::bucketCount() const
+{
+    return expandableCapacity;
+}
+
+
+template <typename T, typename HashPolicy>
+template <typename Callback>
+void HashSet<T, HashPolicy>::forEachInBuckets(
+    unsigned int first, unsigned int last, Callback callback) const
+{
+    for (unsigned int i = first; i < last; i++)
+    {
+        for (Node* n = hashNode[i]; n != NULL; n = n->next)
+        {
+            callback(n->data);
+        }
+    }
+}
+
+
+template <typename T, typename HashPolicy>
+HashSet<T, HashPolicy>::Iterator::Iterator(const HashSet* set, int bucket, Node* node)
+    : set{set}, bucket{bucket}, node{node}
+{
+}
 
-#endif // HASHSET_HPP
 
+template <typename T, typename HashPolicy>
+const T& HashSet<T, HashPolicy>::Iterator::operator*() const
+{
+    return node->data;
+}
+
+
+template <typename T, typename HashPolicy>
+const T* HashSet<T, HashPolicy>::Iterator::operator->() const
+{
+    return &node->data;
+}
+
+
+template <typename T, typename HashPolicy>
+typename HashSet<T, HashPolicy>::Iterator& HashSet<T, HashPolicy>::Iterator::operator++()
+{
+    node = node->next;
+    skipEmptyBuckets();
+    return *this;
+}
+
+
+template <typename T, typename HashPolicy>
+typename HashSet<T, HashPolicy>::Iterator HashSet<T, HashPolicy>::Iterator::operator++(int)
+{
+    Iterator old = *this;
+    ++*this;
+    return old;
+}
+
+
+template <typename T, typename HashPolicy>
+bool HashSet<T, HashPolicy>::Iterator::operator==(const Iterator& other) const
+{
+    return node == other.node;
+}
+
+
+template <typename T, typename HashPolicy>
+bool HashSet<T, HashPolicy>::Iterator::operator!=(const Iterator& other) const
+{
+    return node != other.node;
+}
+
+
+template <typename T, typename HashPolicy>
+void HashSet<T, HashPolicy>::Iterator::skipEmptyBuckets()
+{
+    while (node == NULL && bucket < set->expandableCapacity)
+    {
+        bucket++;
+        node = (bucket < set->expandableCapacity) ? set->hashNode[bucket] : NULL;
+    }
+}
+
+
+
+#endif // HASHSET_HPP
@@ -0,0 +1,351 @@
+// LatencyHistogram.cpp
+//
+// ICS 46 Spring 2015
+// Project #3: Set the Controls for the Heart of the Sun
+
+#include "LatencyHistogram.hpp"
+#include <algorithm>
+#include <atomic>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <vector>
+
+
+
+LatencyHistogram::LatencyHistogram()
+    : counts{}, total{0}, sum{0}, maximum{0}
+{
+}
+
+
+void LatencyHistogram::record(std::uint64_t nanoseconds)
+{
+    counts[bucketOf(nanoseconds)]++;
+    total++;
+    sum += nanoseconds;
+    maximum = std::max(maximum, nanoseconds);
+}
+
+
+void LatencyHistogram::merge(const LatencyHistogram& other)
+{
+    for (unsigned int b = 0; b < BUCKET_COUNT; b++)
+    {
+        counts[b] += other.counts[b];
+    }
+    total += other.total;
+    sum += other.sum;
+    maximum = std::max(maximum, other.maximum);
+}
+
+
+std::uint64_t LatencyHistogram::count() const
+{
+    return total;
+}
+
+
+double LatencyHistogram::mean() const
+{
+    return total == 0 ? 0.0 : static_cast<double>(sum) / total;
+}
+
+
+std::uint64_t LatencyHistogram::max() const
+{
+    return maximum;
+}
+
+
+std::uint64_t LatencyHistogram::percentile(double percent) const
+{
+    if (total == 0)
+    {
+        return 0;
+    }
+
+    // the rank of the observation we're after, counting from 1
+    std::uint64_t rank = static_cast<std::uint64_t>(percent / 100.0 * total + 0.5);
+    rank = std::max<std::uint64_t>(1, std::min(rank, total));
+
+    std::uint64_t seen = 0;
+    for (unsigned int b = 0; b < BUCKET_COUNT; b++)
+    {
+        seen += counts[b];
+        if (seen >= rank)
+        {
+            return std::min(bucketLimit(b), maximum);
+        }
+    }
+    return maximum;
+}
+
+
+unsigned int LatencyHistogram::bucketOf(std::uint64_t nanoseconds)
+{
+    if (nanoseconds < SUB_BUCKET_COUNT)
+    {
+        return nanoseconds;
+    }
+
+    // exponent is the position of the highest set bit
+#if defined(__GNUC__)
+    unsigned int exponent = 63 - __builtin_clzll(nanoseconds);
+#else
+    unsigned int exponent = SUB_BUCKET_BITS;
+    while ((nanoseconds >> (exponent + 1)) != 0)
+    {
+        exponent++;
+    }
+#endif
+    if (exponent >= MAX_EXPONENT)
+    {
+        return BUCKET_COUNT - 1;
+    }
+
+    // the bits just below the highest one choose the sub-bucket
+    unsigned int subBucket = (nanoseconds >> (exponent - SUB_BUCKET_BITS)) - SUB_BUCKET_COUNT;
+    return SUB_BUCKET_COUNT + (exponent - SUB_BUCKET_BITS) * SUB_BUCKET_COUNT + subBucket;
+}
+
+
+std::uint64_t LatencyHistogram::bucketLimit(unsigned int bucket)
+{
+    if (bucket < SUB_BUCKET_COUNT)
+    {
+        return bucket;
+    }
+    unsigned int exponent = (bucket - SUB_BUCKET_COUNT) / SUB_BUCKET_COUNT + SUB_BUCKET_BITS;
+    std::uint64_t subBucket = (bucket - SUB_BUCKET_COUNT) % SUB_BUCKET_COUNT;
+    unsigned int shift = exponent - SUB_BUCKET_BITS;
+    return ((SUB_BUCKET_COUNT + subBucket + 1) << shift) - 1;
+}
+
+
+
+// ThreadCounters are the counters of one thread.  Only that thread writes
+// them, so a relaxed load and store is enough to count; they're atomic
+// only so that snapshots can read them at the same time.
+struct LatencyMetrics::ThreadCounters
+{
+    std::atomic<std::uint64_t> counts[METRIC_COUNT][LatencyHistogram::BUCKET_COUNT];
+    std::atomic<std::uint64_t> sums[METRIC_COUNT];
+    std::atomic<std::uint64_t> maximums[METRIC_COUNT];
+
+    ThreadCounters();
+    ~ThreadCounters();
+
+    void clear();
+
+    // copies one metric's counters into a histogram
+    LatencyHistogram read(unsigned int metric) const;
+};
+
+
+// The Registry knows every live thread's counters, and holds the merged
+// histograms of the threads that have finished.
+struct LatencyMetrics::Registry
+{
+    std::mutex lock;
+    std::vector<ThreadCounters*> live;
+    LatencyHistogram retired[METRIC_COUNT];
+};
+
+
+namespace
+{
+    const char* const METRIC_NAMES[LatencyMetrics::METRIC_COUNT] =
+    {
+        "wordExists",
+        "findSuggestions",
+        "swap",
+        "insert",
+        "delete",
+        "replace",
+        "split",
+        "phonetic"
+    };
+
+
+    void increment(std::atomic<std::uint64_t>& counter, std::uint64_t amount)
+    {
+        counter.store(counter.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+    }
+}
+
+
+LatencyMetrics::ThreadCounters::ThreadCounters()
+{
+    clear();
+    Registry& r = registry();
+    std::lock_guard<std::mutex> guard{r.lock};
+    r.live.push_back(this);
+}
+
+
+LatencyMetrics::ThreadCounters::~ThreadCounters()
+{
+    // fold this thread's counts into the retired histograms, so they
+    // outlive the thread
+    Registry& r = registry();
+    std::lock_guard<std::mutex> guard{r.lock};
+    for (unsigned int m = 0; m < METRIC_COUNT; m++)
+    {
+        r.retired[m].merge(read(m));
+    }
+    r.live.erase(std::find(r.live.begin(), r.live.end(), this));
+}
+
+
+void LatencyMetrics::ThreadCounters::clear()
+{
+    for (unsigned int m = 0; m < METRIC_COUNT; m++)
+    {
+        for (unsigned int b = 0; b < LatencyHistogram::BUCKET_COUNT; b++)
+        {
+            counts[m][b].store(0, std::memory_order_relaxed);
+        }
+        sums[m].store(0, std::memory_order_relaxed);
+        maximums[m].store(0, std::memory_order_relaxed);
+    }
+}
+
+
+LatencyHistogram LatencyMetrics::ThreadCounters::read(unsigned int metric) const
+{
+    LatencyHistogram histogram;
+    for (unsigned int b = 0; b < LatencyHistogram::BUCKET_COUNT; b++)
+    {
+        std::uint64_t n = counts[metric][b].load(std::memory_order_relaxed);
+        histogram.counts[b] = n;
+        histogram.total += n;
+    }
+    histogram.sum = sums[metric].load(std::memory_order_relaxed);
+    histogram.maximum = maximums[metric].load(std::memory_order_relaxed);
+    return histogram;
+}
+
+
+LatencyMetrics::Registry& LatencyMetrics::registry()
+{
+    // never destroyed, so that threads finishing during shutdown can still
+    // retire their counters into it
+    static Registry* instance = new Registry;
+    return *instance;
+}
+
+
+LatencyMetrics::ThreadCounters& LatencyMetrics::threadCounters()
+{
+    // only the pointer lives in thread-local storage, which every thread
+    // in the program gets a copy of; the counters themselves are only
+    // allocated for threads that record something
+    thread_local std::unique_ptr<ThreadCounters> counters;
+    if (!counters)
+    {
+        counters.reset(new ThreadCounters);
+    }
+    return *counters;
+}
+
+
+void LatencyMetrics::record(LatencyMetric metric, std::uint64_t nanoseconds)
+{
+    ThreadCounters& counters = threadCounters();
+    unsigned int m = static_cast<unsigned int>(metric);
+    increment(counters.counts[m][LatencyHistogram::bucketOf(nanoseconds)], 1);
+    increment(counters.sums[m], nanoseconds);
+    if (nanoseconds > counters.maximums[m].load(std::memory_order_relaxed))
+    {
+        counters.maximums[m].store(nanoseconds, std::memory_order_relaxed);
+    }
+}
+
+
+LatencyHistogram LatencyMetrics::snapshot(LatencyMetric metric)
+{
+    unsigned int m = static_cast<unsigned int>(metric);
+    Registry& r = registry();
+    std::lock_guard<std::mutex> guard{r.lock};
+    LatencyHistogram histogram = r.retired[m];
+    for (ThreadCounters* counters : r.live)
+    {
+        histogram.merge(counters->read(m));
+    }
+    return histogram;
+}
+
+
+void LatencyMetrics::reset()
+{
+    Registry& r = registry();
+    std::lock_guard<std::mutex> guard{r.lock};
+    for (unsigned int m = 0; m < METRIC_COUNT; m++)
+    {
+        r.retired[m] = LatencyHistogram{};
+    }
+    for (ThreadCounters* counters : r.live)
+    {
+        counters->clear();
+    }
+}
+
+
+void LatencyMetrics::dump(std::ostream& out)
+{
+    // the table is formatted into a stream of its own, so the caller's
+    // stream is left with the flags and precision it had
+    std::ostringstream table;
+    table << std::left << std::setw(16) << "metric" << std::right
+        << std::setw(12) << "count"
+        << std::setw(12) << "mean us"
+        << std::setw(12) << "p50 us"
+        << std::setw(12) << "p99 us"
+        << std::setw(12) << "p99.9 us"
+        << std::setw(12) << "max us" << std::endl;
+
+    table << std::fixed << std::setprecision(2);
+    for (unsigned int m = 0; m < METRIC_COUNT; m++)
+    {
+        LatencyHistogram h = snapshot(static_cast<LatencyMetric>(m));
+        table << std::left << std::setw(16) << METRIC_NAMES[m] << std::right
+            << std::setw(12) << h.count()
+            << std::setw(12) << h.mean() / 1000.0
+            << std::setw(12) << h.percentile(50.0) / 1000.0
+            << std::setw(12) << h.percentile(99.0) / 1000.0
+            << std::setw(12) << h.percentile(99.9) / 1000.0
+            << std::setw(12) << h.max() / 1000.0 << std::endl;
+    }
+    out << table.str();
+}
+
+
+std::string LatencyMetrics::toJson()
+{
+    std::ostringstream out;
+    out << "{";
+    for (unsigned int m = 0; m < METRIC_COUNT; m++)
+    {
+        LatencyHistogram h = snapshot(static_cast<LatencyMetric>(m));
+        out << (m == 0 ? "" : ",")
+            << "\"" << METRIC_NAMES[m] << "\":{"
+            << "\"count\":" << h.count()
+            << ",\"mean_ns\":" << static_cast<std::uint64_t>(h.mean())
+            << ",\"p50_ns\":" << h.percentile(50.0)
+            << ",\"p99_ns\":" << h.percentile(99.0)
+            << ",\"p999_ns\":" << h.percentile(99.9)
+            << ",\"max_ns\":" << h.max()
+            << "}";
+    }
+    out << "}";
+    return out.str();
+}
+
+
+const char* LatencyMetrics::name(LatencyMetric metric)
+{
+    return METRIC_NAMES[static_cast<unsigned int>(metric)];
+}
+
@@ -0,0 +1,191 @@
+// LatencyHistogram.hpp
+//
+// ICS 46 Spring 2015
+// Project #3: Set the Controls for the Heart of the Sun
+//
+// A LatencyHistogram counts how many times each latency was observed, in
+// the style of an HDR histogram: latencies are grouped into buckets whose
+// width grows with the latency, so that every bucket is within about 3%
+// of the latencies it holds, from a nanosecond up to about 18 minutes,
+// in a fixed amount of memory.  Percentiles such as p50, p99 and p99.9
+// can then be read back out of it.
+//
+// LatencyMetrics keeps a LatencyHistogram per thread for each of the
+// operations listed in LatencyMetric.  Recording a latency touches only
+// the calling thread's counters, without any locking or atomic
+// read-modify-write; the per-thread histograms are merged only when
+// someone asks for a snapshot.  A thread's counters take about 74 KB (a
+// histogram of 1152 64-bit buckets for each of the eight metrics); they're
+// allocated on the heap the first time the thread records a latency, so
+// threads that never do pay only for a pointer.
+//
+// LatencyTimer records how long a scope took; NoLatencyTimer has the same
+// interface but does nothing, so code that takes its timer as a template
+// parameter can have its timing compiled out.
+
+#ifndef LATENCYHISTOGRAM_HPP
+#define LATENCYHISTOGRAM_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+
+
+class LatencyHistogram
+{
+public:
+    // Latencies below 2^SUB_BUCKET_BITS nanoseconds are counted exactly;
+    // above that, each power of two is split into 2^SUB_BUCKET_BITS
+    // buckets.
+    static constexpr unsigned int SUB_BUCKET_BITS = 5;
+    static constexpr unsigned int SUB_BUCKET_COUNT = 1u << SUB_BUCKET_BITS;
+
+    // Latencies of 2^MAX_EXPONENT nanoseconds or more are counted in the
+    // last bucket.
+    static constexpr unsigned int MAX_EXPONENT = 40;
+
+    static constexpr unsigned int BUCKET_COUNT =
+        SUB_BUCKET_COUNT + (MAX_EXPONENT - SUB_BUCKET_BITS) * SUB_BUCKET_COUNT;
+
+public:
+    // Initializes a LatencyHistogram with nothing recorded in it.
+    LatencyHistogram();
+
+    // record() counts one observation of the given latency.
+    void record(std::uint64_t nanoseconds);
+
+    // merge() adds every count in another histogram to this one.
+    void merge(const LatencyHistogram& other);
+
+    // count() returns the number of latencies recorded.
+    std::uint64_t count() const;
+
+    // mean() returns the average latency recorded, in nanoseconds.
+    double mean() const;
+
+    // max() returns the largest latency recorded, in nanoseconds.
+    std::uint64_t max() const;
+
+    // percentile() returns a latency, in nanoseconds, that is at least as
+    // large as the given percentage (between 0 and 100) of the latencies
+    // recorded, rounded up to the top of its bucket.
+    std::uint64_t percentile(double percent) const;
+
+    // bucketOf() returns the bucket that a latency is counted in.
+    static unsigned int bucketOf(std::uint64_t nanoseconds);
+
+    // bucketLimit() returns the largest latency counted in a bucket.
+    static std::uint64_t bucketLimit(unsigned int bucket);
+
+private:
+    std::uint64_t counts[BUCKET_COUNT];
+    std::uint64_t total;
+    std::uint64_t sum;
+    std::uint64_t maximum;
+
+    friend class LatencyMetrics;
+};
+
+
+
+// The operations that LatencyMetrics keeps histograms for.  The last six
+// are the suggestion strategies within findSuggestions(); the phonetic
+// one only runs when there's a PhoneticIndex.
+enum class LatencyMetric
+{
+    WordExists,
+    FindSuggestions,
+    SwapStrategy,
+    InsertStrategy,
+    DeleteStrategy,
+    ReplaceStrategy,
+    SplitStrategy,
+    PhoneticStrategy
+};
+
+
+
+class LatencyMetrics
+{
+public:
+    // The number of values in LatencyMetric.
+    static constexpr unsigned int METRIC_COUNT = 8;
+
+    // record() counts one observation of a latency, in nanoseconds, in the
+    // calling thread's histogram for the given metric.
+    static void record(LatencyMetric metric, std::uint64_t nanoseconds);
+
+    // snapshot() returns the merged histogram of every thread, including
+    // threads that have since finished, for the given metric.
+    static LatencyHistogram snapshot(LatencyMetric metric);
+
+    // reset() discards everything recorded so far, in every thread.  It
+    // shouldn't be called while other threads are recording.
+    static void reset();
+
+    // dump() writes a table of the count, mean, p50, p99, p99.9 and
+    // maximum of each metric, in microseconds.
+    static void dump(std::ostream& out);
+
+    // toJson() returns the same figures as dump(), in nanoseconds, as a
+    // JSON object with one member per metric.
+    static std::string toJson();
+
+    // name() returns the name used for a metric in dump() and toJson().
+    static const char* name(LatencyMetric metric);
+
+private:
+    // the counters of one thread, and the list of every thread's counters
+    struct ThreadCounters;
+    struct Registry;
+
+    static Registry& registry();
+    static ThreadCounters& threadCounters();
+};
+
+
+
+// A LatencyTimer records, when it's destroyed, how long it has been since
+// it was created, under the given metric.
+class LatencyTimer
+{
+public:
+    explicit LatencyTimer(LatencyMetric metric)
+        : metric{metric}, start{std::chrono::steady_clock::now()}
+    {
+    }
+
+    ~LatencyTimer()
+    {
+        std::chrono::nanoseconds elapsed = std::chrono::steady_clock::now() - start;
+        LatencyMetrics::record(metric, elapsed.count());
+    }
+
+    LatencyTimer(const LatencyTimer&) = delete;
+    LatencyTimer& operator=(const LatencyTimer&) = delete;
+
+private:
+    LatencyMetric metric;
+    std::chrono::steady_clock::time_point start;
+};
+
+
+
+// A NoLatencyTimer records nothing and costs nothing; it stands in for a
+// LatencyTimer where latencies aren't wanted.
+class NoLatencyTimer
+{
+public:
+    explicit NoLatencyTimer(LatencyMetric)
+    {
+    }
+
+    NoLatencyTimer(const NoLatencyTimer&) = delete;
+    NoLatencyTimer& operator=(const NoLatencyTimer&) = delete;
+};
+
+
+
+#endif // LATENCYHISTOGRAM_HPP
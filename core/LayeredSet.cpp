@@ -0,0 +1,84 @@
+// LayeredSet.cpp
+//
+// ICS 46 Spring 2015
+// Project #3: Set the Controls for the Heart of the Sun
+
+#include "LayeredSet.hpp"
+
+
+
+LayeredSet::LayeredSet(unsigned int filterBlocks)
+    : ownFilter{filterBlocks}
+{
+}
+
+
+void LayeredSet::addLayer(const Set<std::string>& words, const BloomFilter& filter)
+{
+    layers.push_back(&words);
+    filters.push_back(&filter);
+}
+
+
+unsigned int LayeredSet::layerCount() const
+{
+    return layers.size();
+}
+
+
+bool LayeredSet::isImplemented() const
+{
+    return true;
+}
+
+
+void LayeredSet::add(const std::string& element)
+{
+    if (!contains(element))
+    {
+        ownWords.add(element);
+        ownFilter.add(element);
+    }
+}
+
+
+bool LayeredSet::contains(const std::string& element) const
+{
+    return layerOf(element) >= 0;
+}
+
+
+int LayeredSet::layerOf(const std::string& element) const
+{
+    // a filter shared by consecutive layers is only probed for the first
+    const BloomFilter* probed = NULL;
+    bool mayContain = false;
+    for (unsigned int i = 0; i < layers.size(); i++)
+    {
+        if (filters[i] != probed)
+        {
+            probed = filters[i];
+            mayContain = probed->mayContain(element);
+        }
+        if (mayContain && layers[i]->contains(element))
+        {
+            return i;
+        }
+    }
+    if (ownFilter.mayContain(element) && ownWords.contains(element))
+    {
+        return layers.size();
+    }
+    return -1;
+}
+
+
+unsigned int LayeredSet::size() const
+{
+    unsigned int total = ownWords.size();
+    for (const Set<std::string>* layer : layers)
+    {
+        total += layer->size();
+    }
+    return total;
+}
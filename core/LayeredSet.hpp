@@ -0,0 +1,100 @@
+// LayeredSet.hpp
+//
+// ICS 46 Spring 2015
+// Project #3: Set the Controls for the Heart of the Sun
+//
+// A LayeredSet is a Set of strings made up of other sets, stacked in
+// layers: a word is in the LayeredSet if it's in any of them.  It lets
+// several dictionaries be checked as one -- say, a base dictionary, a
+// domain dictionary and one tenant's own words -- without copying any of
+// them, so one copy of the base dictionary can serve every tenant.
+//
+// The lower layers are sets that the LayeredSet only refers to; they're
+// added with addLayer(), along with a BloomFilter of each one's words,
+// and aren't changed through it.  Words added to the LayeredSet itself
+// go into a top layer of its own, with a filter of its own.
+//
+// The LayeredSet refers to the lower layers' filters rather than copying
+// them, so the filters can be shared as well.  A filter may cover more
+// than one layer, and consecutive layers given the same filter are
+// probed through it once: a base and a domain dictionary can share one
+// filter built from both, and every tenant's LayeredSet can refer to it.
+// Each tenant then carries only a filter sized for its own words.  A
+// word that's in none of the layers is usually turned away after probing
+// each distinct filter once, without looking in any layer; other words
+// are looked for in each layer whose filter lets them through, starting
+// with the first one added.
+
+#ifndef LAYEREDSET_HPP
+#define LAYEREDSET_HPP
+
+#include <string>
+#include <vector>
+#include "BloomFilter.hpp"
+#include "HashSet.hpp"
+#include "Set.hpp"
+
+
+
+class LayeredSet : public Set<std::string>
+{
+public:
+    // Initializes a LayeredSet with no layers, whose filter of its own
+    // words will have the given number of blocks.
+    explicit LayeredSet(unsigned int filterBlocks);
+
+
+    // addLayer() adds a set beneath the LayeredSet's own words and above
+    // any layers added before it, along with a filter of every word in it;
+    // the filter may hold other layers' words too.  The LayeredSet stores
+    // references to both, so they must outlive it, and words must not be
+    // added to the set afterward, since the filter wouldn't know about
+    // them.
+    void addLayer(const Set<std::string>& words, const BloomFilter& filter);
+
+
+    // layerCount() returns the number of layers added with addLayer().
+    unsigned int layerCount() const;
+
+
+    // isImplemented() returns true, since LayeredSet is implemented.
+    virtual bool isImplemented() const;
+
+
+    // add() adds a word to the LayeredSet's own layer, unless it's already
+    // in one of the layers.
+    virtual void add(const std::string& element);
+
+
+    // contains() returns true if the word is in any layer.  A word that's
+    // in none of them usually costs one probe of each distinct filter.
+    virtual bool contains(const std::string& element) const;
+
+
+    // layerOf() returns the number of the first layer that contains the
+    // word -- the layers added with addLayer() are numbered from 0 in the
+    // order they were added, and the LayeredSet's own words are layer
+    // number layerCount() -- or -1 if no layer contains it.
+    int layerOf(const std::string& element) const;
+
+
+    // size() returns the sum of the sizes of the layers.  A word that's in
+    // more than one of the layers added with addLayer() is counted once
+    // for each of them; the LayeredSet's own layer only holds words that
+    // aren't in any other.
+    virtual unsigned int size() const;
+
+
+private:
+    // the lower layers, in the order they were added, and their filters
+    std::vector<const Set<std::string>*> layers;
+    std::vector<const BloomFilter*> filters;
+
+    // the LayeredSet's own words, and a filter of them
+    HashSet<std::string> ownWords;
+    BloomFilter ownFilter;
+};
+
+
+
+#endif // LAYEREDSET_HPP
@@ -0,0 +1,332 @@
+// LazyShardedSet.cpp
+//
+// ICS 46 Spring 2015
+// Project #3: Set the Controls for the Heart of the Sun
+
+#include "LazyShardedSet.hpp"
+#include <algorithm>
+#include <memory>
+#include <stdexcept>
+#include "HashPolicy.hpp"
+
+
+namespace
+{
+    const std::uint64_t MAGIC = 0x3144524148535a4cull;
+
+    struct FileHeader
+    {
+        std::uint64_t magic;
+        std::uint32_t shardCount;
+        std::uint32_t wordCount;
+    };
+
+    struct DirectoryEntry
+    {
+        std::uint64_t offset;
+        std::uint64_t bytes;
+        std::uint32_t wordCount;
+        std::uint32_t reserved;
+    };
+
+
+    template <typename Value>
+    void readValue(std::istream& in, Value& value)
+    {
+        if (!in.read(reinterpret_cast<char*>(&value), sizeof(value)))
+        {
+            throw std::runtime_error{"LazyShardedSet: file ended early"};
+        }
+    }
+}
+
+
+
+LazyShardedSet::LazyShardedSet(const std::string& path, std::size_t memoryLimit)
+    : shards{NULL}, numberOfShards{0}, file{path, std::ios::binary},
+      memoryLimit{memoryLimit}, resident{0}, loaded{0}, loads{0}, clockHand{0}
+{
+    if (!file)
+    {
+        throw std::runtime_error{"LazyShardedSet: can't open " + path};
+    }
+    FileHeader header;
+    readValue(file, header);
+    if (header.magic != MAGIC || header.shardCount == 0)
+    {
+        throw std::runtime_error{"LazyShardedSet: " + path + " isn't a sharded dictionary"};
+    }
+    numberOfElements = header.wordCount;
+
+    // the whole directory is read before the shards are allocated, so
+    // that a short file can't leak them
+    std::vector<DirectoryEntry> directory(header.shardCount);
+    for (DirectoryEntry& entry : directory)
+    {
+        readValue(file, entry);
+    }
+
+    numberOfShards = header.shardCount;
+    shards = new Shard[numberOfShards];
+    for (unsigned int i = 0; i < numberOfShards; i++)
+    {
+        shards[i].offset = directory[i].offset;
+        shards[i].bytes = directory[i].bytes;
+        shards[i].wordCount = directory[i].wordCount;
+        shards[i].words.store(NULL);
+        shards[i].readers.store(0);
+        shards[i].referenced.store(false);
+    }
+}
+
+
+LazyShardedSet::~LazyShardedSet()
+{
+    for (unsigned int i = 0; i < numberOfShards; i++)
+    {
+        delete shards[i].words.load();
+    }
+    for (const std::pair<unsigned int, const HashSet<std::string>*>& words : retired)
+    {
+        delete words.second;
+    }
+    delete[] shards;
+}
+
+
+void LazyShardedSet::write(
+    std::ostream& out, const std::vector<std::string>& words, unsigned int shardCount)
+{
+    std::vector<std::string> distinct = words;
+    std::sort(distinct.begin(), distinct.end());
+    distinct.erase(std::unique(distinct.begin(), distinct.end()), distinct.end());
+
+    std::vector<std::string> shardText(shardCount);
+    std::vector<DirectoryEntry> directory(shardCount, DirectoryEntry{0, 0, 0, 0});
+    for (const std::string& word : distinct)
+    {
+        unsigned int index = shardOf(word, shardCount);
+        shardText[index] += word;
+        shardText[index] += '\n';
+        directory[index].wordCount++;
+    }
+
+    std::uint64_t offset = sizeof(FileHeader) + shardCount * sizeof(DirectoryEntry);
+    for (unsigned int i = 0; i < shardCount; i++)
+    {
+        directory[i].offset = offset;
+        directory[i].bytes = shardText[i].size();
+        offset += shardText[i].size();
+    }
+
+    FileHeader header{MAGIC, shardCount, static_cast<std::uint32_t>(distinct.size())};
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(directory.data()), directory.size() * sizeof(DirectoryEntry));
+    for (const std::string& text : shardText)
+    {
+        out.write(text.data(), text.size());
+    }
+}
+
+
+bool LazyShardedSet::isImplemented() const
+{
+    return true;
+}
+
+
+void LazyShardedSet::add(const std::string&)
+{
+    throw std::logic_error{"LazyShardedSet: cannot add to a read-only set"};
+}
+
+
+bool LazyShardedSet::contains(const std::string& element) const
+{
+    unsigned int index = shardOf(element, numberOfShards);
+    if (shards[index].wordCount == 0)
+    {
+        return false;
+    }
+
+    bool found;
+    if (lookIn(shards[index], element, found))
+    {
+        return found;
+    }
+    return load(index, element);
+}
+
+
+unsigned int LazyShardedSet::size() const
+{
+    return numberOfElements;
+}
+
+
+unsigned int LazyShardedSet::shardCount() const
+{
+    return numberOfShards;
+}
+
+
+unsigned int LazyShardedSet::loadedShardCount() const
+{
+    std::lock_guard<std::mutex> guard{lock};
+    return loaded;
+}
+
+
+unsigned int LazyShardedSet::loadCount() const
+{
+    std::lock_guard<std::mutex> guard{lock};
+    return loads;
+}
+
+
+std::size_t LazyShardedSet::residentBytes() const
+{
+    std::lock_guard<std::mutex> guard{lock};
+    return resident;
+}
+
+
+unsigned int LazyShardedSet::shardOf(const std::string& word, unsigned int shardCount)
+{
+    // a different seed from the one HashSet uses, so that the words in a
+    // shard are still spread across all of its HashSet's buckets
+    std::uint64_t h = wyhash(word.data(), word.size(), 0x5348415244ull);
+    return ((h >> 32) * shardCount) >> 32;
+}
+
+
+std::size_t LazyShardedSet::estimateBytes(const Shard& shard)
+{
+    // a node per word, plus a little over one bucket per word, plus the
+    // characters, some of which are stored outside the strings
+    return shard.wordCount * (sizeof(HashSet<std::string>::Node) + 2 * sizeof(void*))
+        + shard.bytes;
+}
+
+
+bool LazyShardedSet::lookIn(Shard& shard, const std::string& word, bool& found)
+{
+    // announce the lookup before loading the words; both are sequentially
+    // consistent, so an eviction that drops these words afterward is bound
+    // to see the count and leave them alone
+    shard.readers.fetch_add(1);
+    const HashSet<std::string>* words = shard.words.load();
+    if (words != NULL)
+    {
+        // most lookups find the bit already set, and don't write it
+        if (!shard.referenced.load(std::memory_order_relaxed))
+        {
+            shard.referenced.store(true, std::memory_order_relaxed);
+        }
+        found = words->contains(word);
+    }
+    shard.readers.fetch_sub(1, std::memory_order_release);
+    return words != NULL;
+}
+
+
+bool LazyShardedSet::load(unsigned int index, const std::string& word) const
+{
+    Shard& shard = shards[index];
+    std::lock_guard<std::mutex> loadGuard{shard.loadLock};
+
+    // another thread may have loaded the shard while this one waited
+    bool found;
+    if (lookIn(shard, word, found))
+    {
+        return found;
+    }
+
+    std::string text(shard.bytes, '\0');
+    {
+        std::lock_guard<std::mutex> fileGuard{fileLock};
+        file.clear();
+        file.seekg(shard.offset);
+        if (!file.read(&text[0], text.size()))
+        {
+            throw std::runtime_error{"LazyShardedSet: can't read a shard"};
+        }
+    }
+    std::vector<std::string> words;
+    words.reserve(shard.wordCount);
+    std::string::size_type start = 0;
+    for (std::string::size_type end; (end = text.find('\n', start)) != std::string::npos; start = end + 1)
+    {
+        words.emplace_back(text, start, end - start);
+    }
+
+    // the word is looked up before the shard is published, since the
+    // shard could be dropped as soon as it is
+    std::unique_ptr<HashSet<std::string>> loadedWords{new HashSet<std::string>};
+    loadedWords->addAll(words.begin(), words.end(), 1);
+    found = loadedWords->contains(word);
+
+    std::lock_guard<std::mutex> guard{lock};
+    shard.referenced.store(true, std::memory_order_relaxed);
+    shard.words.store(loadedWords.release());
+    resident += estimateBytes(shard);
+    loaded++;
+    loads++;
+    evict(index);
+    reclaimRetired();
+    return found;
+}
+
+
+void LazyShardedSet::evict(unsigned int keep) const
+{
+    if (memoryLimit == 0)
+    {
+        return;
+    }
+    while (resident > memoryLimit && loaded > 1)
+    {
+        unsigned int index = clockHand;
+        clockHand = (clockHand + 1) % numberOfShards;
+        Shard& victim = shards[index];
+        const HashSet<std::string>* words = victim.words.load(std::memory_order_relaxed);
+        if (words == NULL || index == keep)
+        {
+            continue;
+        }
+
+        // a shard that's been looked in since the clock last passed it gets
+        // another chance
+        if (victim.referenced.exchange(false, std::memory_order_relaxed))
+        {
+            continue;
+        }
+
+        // the store is sequentially consistent so that reclaimRetired() can
+        // trust the shard's reader count
+        victim.words.store(NULL);
+        resident -= estimateBytes(victim);
+        loaded--;
+        retired.push_back(std::make_pair(index, words));
+    }
+}
+
+
+void LazyShardedSet::reclaimRetired() const
+{
+    // a lookup that came in after a shard's count was zero finds its
+    // current words, which aren't retired
+    unsigned int kept = 0;
+    for (const std::pair<unsigned int, const HashSet<std::string>*>& words : retired)
+    {
+        if (shards[words.first].readers.load() == 0)
+        {
+            delete words.second;
+        }
+        else
+        {
+            retired[kept++] = words;
+        }
+    }
+    retired.resize(kept);
+}
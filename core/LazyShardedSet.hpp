@@ -0,0 +1,198 @@
+// LazyShardedSet.hpp
+//
+// ICS 46 Spring 2015
+// Project #3: Set the Controls for the Heart of the Sun
+//
+// A LazyShardedSet is a read-only Set of strings that's stored in a file
+// and loaded a piece at a time, as it's used.  The words are split by
+// hash into shards, and a shard is read from the file and built into a
+// HashSet only the first time contains() is asked about a word that
+// belongs to it.  Opening a LazyShardedSet reads only the file's
+// directory of shards, so it's quick no matter how large the dictionary
+// is, and a process that only ever looks up a few words only ever holds
+// the shards those words belong to.
+//
+// A LazyShardedSet can also be given a memory limit, in which case
+// shards are dropped whenever the shards in memory add up to more than
+// that; a dropped shard is simply loaded again if it's needed again.  The
+// shards to drop are chosen by a clock that sweeps over them, passing
+// over (and forgetting) any that have been looked in since it last went
+// by, which approximates dropping the ones that have gone unused the
+// longest.  The memory a shard uses is estimated from its number of words
+// and characters.
+//
+// contains() may be called by several threads at once.  Looking in a
+// shard that's already loaded takes no lock: the shard's words are
+// published with a single atomic store once they're built, and a lookup
+// counts itself on the shard while it's looking, the way ShardedHashSet's
+// contains() does, so that a dropped shard's words are only freed once
+// no lookup can still be in them.  Loading a shard takes a lock of that
+// shard's own, so one thread reads and builds it while others wanting the
+// same shard wait; the file itself is only locked while the shard's bytes
+// are read, and the set-wide lock only while the memory is accounted for
+// and shards are dropped, so a lookup in a loaded shard never waits for
+// another shard to load.
+//
+// write() creates the file: a header, then a directory giving where each
+// shard's words are and how many there are, then each shard's words,
+// one per line.  Words may not contain newlines.
+
+#ifndef LAZYSHARDEDSET_HPP
+#define LAZYSHARDEDSET_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+#include "HashSet.hpp"
+#include "Set.hpp"
+
+
+
+class LazyShardedSet : public Set<std::string>
+{
+public:
+    // The number of shards that write() splits words into unless it's
+    // told otherwise.
+    static constexpr unsigned int DEFAULT_SHARD_COUNT = 256;
+
+public:
+    // Opens the sharded dictionary in the given file, reading only its
+    // directory.  If memoryLimit isn't 0, shards are dropped as needed to
+    // keep the estimated memory they use to at most memoryLimit bytes,
+    // though the shard most recently loaded is always kept.  Throws a
+    // std::runtime_error if the file can't be read or isn't a sharded
+    // dictionary.
+    explicit LazyShardedSet(const std::string& path, std::size_t memoryLimit = 0);
+
+    // Cleans up the LazyShardedSet so that it leaks no memory.  No other
+    // thread may be using it at this point.
+    virtual ~LazyShardedSet();
+
+    // A LazyShardedSet can't be copied or assigned, since its locks can't.
+    LazyShardedSet(const LazyShardedSet& s) = delete;
+    LazyShardedSet& operator=(const LazyShardedSet& s) = delete;
+
+
+    // write() writes the given words to a stream as a sharded dictionary,
+    // split into the given number of shards.  Duplicate words are allowed
+    // and are written only once.
+    static void write(
+        std::ostream& out, const std::vector<std::string>& words,
+        unsigned int shardCount = DEFAULT_SHARD_COUNT);
+
+
+    // isImplemented() returns true, since LazyShardedSet is implemented.
+    virtual bool isImplemented() const;
+
+
+    // A LazyShardedSet can't be changed, since the words in a shard would
+    // be lost when it was dropped, so add() always throws a
+    // std::logic_error.
+    virtual void add(const std::string& element);
+
+
+    // contains() returns true if the given element is one of the words,
+    // false otherwise, loading the shard it belongs to if that shard isn't
+    // in memory.
+    virtual bool contains(const std::string& element) const;
+
+
+    // size() returns the number of words, whether they're loaded or not.
+    virtual unsigned int size() const;
+
+
+    // shardCount() returns the number of shards the words are split into.
+    unsigned int shardCount() const;
+
+
+    // loadedShardCount() returns the number of shards in memory.
+    unsigned int loadedShardCount() const;
+
+
+    // loadCount() returns the number of times a shard has been loaded,
+    // counting every time a dropped shard was loaded again.
+    unsigned int loadCount() const;
+
+
+    // residentBytes() returns the estimated memory used by the shards in
+    // memory.
+    std::size_t residentBytes() const;
+
+
+private:
+    // where a shard's words are in the file, how many there are, and, if
+    // the shard is loaded, its words
+    struct Shard
+    {
+        std::uint64_t offset;
+        std::uint64_t bytes;
+        std::uint32_t wordCount;
+        // the shard's words, or NULL if it isn't loaded
+        std::atomic<const HashSet<std::string>*> words;
+        // the number of contains() calls looking in the shard's words
+        std::atomic<unsigned int> readers;
+        // set by lookups in the shard's words, and cleared by the clock
+        std::atomic<bool> referenced;
+        // held while the shard is being loaded
+        std::mutex loadLock;
+    };
+
+    // the shards' offsets, sizes and word counts never change once the
+    // file is opened; the rest of each Shard is described above
+    Shard* shards;
+    unsigned int numberOfShards;
+
+    // held while a shard's bytes are read from the file
+    mutable std::mutex fileLock;
+    mutable std::ifstream file;
+
+    // everything below is guarded by lock
+    mutable std::mutex lock;
+
+    std::size_t memoryLimit;
+    mutable std::size_t resident;
+    mutable unsigned int loaded;
+    mutable unsigned int loads;
+
+    // the shard the clock will look at next
+    mutable unsigned int clockHand;
+
+    // the words of dropped shards that a lookup might still be in, with
+    // the number of the shard each came from
+    mutable std::vector<std::pair<unsigned int, const HashSet<std::string>*>> retired;
+
+    unsigned int numberOfElements;
+
+    // returns the shard a word belongs to when there are shardCount shards
+    static unsigned int shardOf(const std::string& word, unsigned int shardCount);
+
+    // returns the estimated memory that a loaded shard uses
+    static std::size_t estimateBytes(const Shard& shard);
+
+    // looks a word up in a shard's words, setting found to the answer, if
+    // the shard is loaded; returns false if it isn't
+    static bool lookIn(Shard& shard, const std::string& word, bool& found);
+
+    // loads a shard, unless another thread loads it first, and returns
+    // whether the word is in it
+    bool load(unsigned int index, const std::string& word) const;
+
+    // drops shards chosen by the clock until the loaded shards fit in
+    // memoryLimit, never dropping the shard numbered keep; lock must be
+    // held
+    void evict(unsigned int keep) const;
+
+    // frees the retired words that no lookup can still be in; lock must
+    // be held
+    void reclaimRetired() const;
+};
+
+
+
+#endif // LAZYSHARDEDSET_HPP
@@ -0,0 +1,58 @@
+// Parallel.hpp
+//
+// ICS 46 Spring 2015
+// Project #3: Set the Controls for the Heart of the Sun
+//
+// A couple of small utilities for splitting work across threads, shared
+// by the sets that know how to build themselves in parallel.
+
+#ifndef PARALLEL_HPP
+#define PARALLEL_HPP
+
+#include <thread>
+#include <vector>
+
+
+
+// defaultThreadCount() returns the number of threads to use when the
+// caller doesn't say: one per hardware thread, or one if that's unknown.
+inline unsigned int defaultThreadCount()
+{
+    unsigned int count = std::thread::hardware_concurrency();
+    return count == 0 ? 1 : count;
+}
+
+
+// runInParallel() calls task(i) once for every i in [0, taskCount), each
+// on its own thread, and returns once they've all finished.  Task 0 runs
+// on the calling thread.
+template <typename Task>
+void runInParallel(unsigned int taskCount, Task task)
+{
+    std::vector<std::thread> threads;
+    for (unsigned int i = 1; i < taskCount; i++)
+    {
+        threads.push_back(std::thread{task, i});
+    }
+    if (taskCount > 0)
+    {
+        task(0u);
+    }
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+}
+
+
+// sliceBegin() returns where slice i of n begins when count items are
+// split into n slices as evenly as possible; slice i ends where slice
+// i + 1 begins.
+inline unsigned int sliceBegin(unsigned int count, unsigned int n, unsigned int i)
+{
+    return static_cast<unsigned int>(static_cast<unsigned long long>(count) * i / n);
+}
+
+
+
+#endif // PARALLEL_HPP
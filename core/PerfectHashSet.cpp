@@ -0,0 +1,429 @@
+// PerfectHashSet.cpp
+//
+// ICS 46 Spring 2015
+// Project #3: Set the Controls for the Heart of the Sun
+
+#include "PerfectHashSet.hpp"
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include "HashPolicy.hpp"
+
+
+namespace
+{
+    // the average number of words per bucket
+    const double BUCKET_SIZE = 5.0;
+
+    // the fraction of table slots that end up holding a word
+    const double LOAD_FACTOR = 0.98;
+
+    // dense buckets make up this fraction of the buckets but receive
+    // DENSE_KEYS of the words
+    const double DENSE_BUCKETS = 0.3;
+    const double DENSE_KEYS = 0.6;
+
+    // how many pilots to try for one bucket before giving up on a seed
+    const std::uint64_t MAX_PILOT = 1u << 20;
+
+    const std::uint64_t MAGIC = 0x3148504c4c455053ull;
+
+    // how many elements of a saved vector to read at a time
+    const std::uint64_t READ_CHUNK = 1u << 16;
+
+
+    std::uint64_t hashPilot(std::uint64_t pilot)
+    {
+        return wyhashDetail::mix(pilot ^ wyhashDetail::SECRET2, wyhashDetail::SECRET3);
+    }
+
+
+    template <typename Value>
+    void writeValue(std::ostream& out, const Value& value)
+    {
+        out.write(reinterpret_cast<const char*>(&value), sizeof(value));
+    }
+
+
+    template <typename Value>
+    void writeVector(std::ostream& out, const std::vector<Value>& values)
+    {
+        writeValue(out, static_cast<std::uint64_t>(values.size()));
+        out.write(reinterpret_cast<const char*>(values.data()), values.size() * sizeof(Value));
+    }
+
+
+    template <typename Value>
+    void readValue(std::istream& in, Value& value)
+    {
+        if (!in.read(reinterpret_cast<char*>(&value), sizeof(value)))
+        {
+            throw std::runtime_error{"PerfectHashSet: stream ended early"};
+        }
+    }
+
+
+    template <typename Value>
+    void readVector(std::istream& in, std::vector<Value>& values)
+    {
+        std::uint64_t size;
+        readValue(in, size);
+        if (size > std::numeric_limits<unsigned int>::max())
+        {
+            throw std::runtime_error{"PerfectHashSet: saved set is inconsistent"};
+        }
+
+        // the vector grows as its elements arrive, rather than being sized
+        // up front, so a corrupt size in a short stream is caught before
+        // anything near that size is allocated
+        values.clear();
+        while (values.size() < size)
+        {
+            std::size_t begin = values.size();
+            std::size_t count = std::min<std::uint64_t>(size - begin, READ_CHUNK);
+            values.resize(begin + count);
+            if (!in.read(reinterpret_cast<char*>(values.data() + begin), count * sizeof(Value)))
+            {
+                throw std::runtime_error{"PerfectHashSet: stream ended early"};
+            }
+        }
+    }
+}
+
+
+
+PerfectHashSet::PerfectHashSet(const std::vector<std::string>& words)
+    : seed{0}, numberOfElements{0}, bucketCount{0}, denseBucketCount{0},
+      tableSize{0}, pilotWidth{0}
+{
+    std::vector<std::string> distinct = words;
+    std::sort(distinct.begin(), distinct.end());
+    distinct.erase(std::unique(distinct.begin(), distinct.end()), distinct.end());
+
+    while (!build(distinct))
+    {
+        seed++;
+    }
+}
+
+
+PerfectHashSet::PerfectHashSet(std::istream& in)
+{
+    std::uint64_t magic;
+    readValue(in, magic);
+    if (magic != MAGIC)
+    {
+        throw std::runtime_error{"PerfectHashSet: not a saved PerfectHashSet"};
+    }
+    readValue(in, seed);
+    readValue(in, numberOfElements);
+    readValue(in, bucketCount);
+    readValue(in, denseBucketCount);
+    readValue(in, tableSize);
+    readValue(in, pilotWidth);
+
+    // bucketOf() divides by the number of buckets that aren't dense and
+    // positionOf() by tableSize, so neither can be zero
+    if (pilotWidth < 1 || pilotWidth > 64
+        || denseBucketCount >= bucketCount
+        || tableSize < numberOfElements || tableSize == 0)
+    {
+        throw std::runtime_error{"PerfectHashSet: saved set is inconsistent"};
+    }
+
+    readVector(in, pilots);
+    readVector(in, freeSlots);
+    readVector(in, offsets);
+    readVector(in, characters);
+
+    if (offsets.size() != numberOfElements + 1ull
+        || freeSlots.size() != tableSize - numberOfElements
+        || pilots.size() != (static_cast<unsigned long long>(bucketCount) * pilotWidth + 63) / 64)
+    {
+        throw std::runtime_error{"PerfectHashSet: saved set is inconsistent"};
+    }
+
+    // contains() trusts every remapped slot to be a word's slot, unless
+    // there are no words and it never looks, and every word to lie within
+    // characters
+    for (unsigned int slot : freeSlots)
+    {
+        if (numberOfElements > 0 && slot >= numberOfElements)
+        {
+            throw std::runtime_error{"PerfectHashSet: saved set is inconsistent"};
+        }
+    }
+    for (unsigned int i = 0; i < numberOfElements; i++)
+    {
+        if (offsets[i] > offsets[i + 1])
+        {
+            throw std::runtime_error{"PerfectHashSet: saved set is inconsistent"};
+        }
+    }
+    if (offsets.back() > characters.size())
+    {
+        throw std::runtime_error{"PerfectHashSet: saved set is inconsistent"};
+    }
+}
+
+
+bool PerfectHashSet::isImplemented() const
+{
+    return true;
+}
+
+
+void PerfectHashSet::add(const std::string&)
+{
+    throw std::logic_error{"PerfectHashSet: cannot add to a read-only set"};
+}
+
+
+bool PerfectHashSet::contains(const std::string& element) const
+{
+    if (numberOfElements == 0)
+    {
+        return false;
+    }
+
+    std::uint64_t hashCode = wyhash(element.data(), element.size(), seed);
+    unsigned int slot = positionOf(hashCode, pilotOf(bucketOf(hashCode)));
+    if (slot >= numberOfElements)
+    {
+        slot = freeSlots[slot - numberOfElements];
+    }
+
+    unsigned int begin = offsets[slot];
+    unsigned int length = offsets[slot + 1] - begin;
+    return length == element.size()
+        && std::memcmp(characters.data() + begin, element.data(), length) == 0;
+}
+
+
+unsigned int PerfectHashSet::size() const
+{
+    return numberOfElements;
+}
+
+
+void PerfectHashSet::write(std::ostream& out) const
+{
+    writeValue(out, MAGIC);
+    writeValue(out, seed);
+    writeValue(out, numberOfElements);
+    writeValue(out, bucketCount);
+    writeValue(out, denseBucketCount);
+    writeValue(out, tableSize);
+    writeValue(out, pilotWidth);
+    writeVector(out, pilots);
+    writeVector(out, freeSlots);
+    writeVector(out, offsets);
+    writeVector(out, characters);
+}
+
+
+unsigned long long PerfectHashSet::indexBits() const
+{
+    return static_cast<unsigned long long>(bucketCount) * pilotWidth
+        + freeSlots.size() * 32ull;
+}
+
+
+bool PerfectHashSet::build(const std::vector<std::string>& words)
+{
+    numberOfElements = words.size();
+    bucketCount = static_cast<unsigned int>(numberOfElements / BUCKET_SIZE) + 1;
+    denseBucketCount = static_cast<unsigned int>(bucketCount * DENSE_BUCKETS) + 1;
+    if (denseBucketCount >= bucketCount)
+    {
+        denseBucketCount = bucketCount - 1;
+    }
+    tableSize = static_cast<unsigned int>(numberOfElements / LOAD_FACTOR) + 1;
+
+    // hash every word, giving up on this seed if two of them collide
+    struct Key
+    {
+        std::uint64_t hashCode;
+        unsigned int bucket;
+        unsigned int word;
+    };
+    std::vector<Key> keys(numberOfElements);
+    for (unsigned int i = 0; i < numberOfElements; i++)
+    {
+        std::uint64_t hashCode = wyhash(words[i].data(), words[i].size(), seed);
+        keys[i] = Key{hashCode, bucketOf(hashCode), i};
+    }
+    std::sort(keys.begin(), keys.end(),
+        [](const Key& a, const Key& b)
+        {
+            return a.bucket < b.bucket || (a.bucket == b.bucket && a.hashCode < b.hashCode);
+        });
+    for (unsigned int i = 1; i < numberOfElements; i++)
+    {
+        if (keys[i].hashCode == keys[i - 1].hashCode)
+        {
+            return false;
+        }
+    }
+
+    // bucketStart[b] is where bucket b's keys begin; place the largest
+    // buckets first, while the table is mostly empty
+    std::vector<unsigned int> bucketStart(bucketCount + 1, 0);
+    for (const Key& key : keys)
+    {
+        bucketStart[key.bucket + 1]++;
+    }
+    for (unsigned int b = 0; b < bucketCount; b++)
+    {
+        bucketStart[b + 1] += bucketStart[b];
+    }
+    std::vector<unsigned int> order(bucketCount);
+    for (unsigned int b = 0; b < bucketCount; b++)
+    {
+        order[b] = b;
+    }
+    std::stable_sort(order.begin(), order.end(),
+        [&](unsigned int a, unsigned int b)
+        {
+            return bucketStart[a + 1] - bucketStart[a] > bucketStart[b + 1] - bucketStart[b];
+        });
+
+    // find a pilot for each bucket that sends all of its keys to free,
+    // distinct positions
+    std::vector<std::uint64_t> bucketPilots(bucketCount, 0);
+    std::vector<bool> taken(tableSize, false);
+    std::vector<unsigned int> position(numberOfElements);
+    std::vector<unsigned int> tried;
+    std::uint64_t maxPilot = 0;
+    for (unsigned int b : order)
+    {
+        unsigned int first = bucketStart[b];
+        unsigned int last = bucketStart[b + 1];
+        if (first == last)
+        {
+            continue;
+        }
+
+        std::uint64_t pilot = 0;
+        while (true)
+        {
+            if (pilot == MAX_PILOT)
+            {
+                return false;
+            }
+            tried.clear();
+            bool fits = true;
+            for (unsigned int i = first; i < last && fits; i++)
+            {
+                unsigned int p = positionOf(keys[i].hashCode, pilot);
+                fits = !taken[p] && std::find(tried.begin(), tried.end(), p) == tried.end();
+                tried.push_back(p);
+            }
+            if (fits)
+            {
+                break;
+            }
+            pilot++;
+        }
+
+        for (unsigned int i = first; i < last; i++)
+        {
+            position[i] = tried[i - first];
+            taken[tried[i - first]] = true;
+        }
+        bucketPilots[b] = pilot;
+        maxPilot = std::max(maxPilot, pilot);
+    }
+
+    // pack the pilots into as few bits apiece as the largest one needs
+    pilotWidth = 1;
+    while (pilotWidth < 64 && (maxPilot >> pilotWidth) != 0)
+    {
+        pilotWidth++;
+    }
+    pilots.assign((static_cast<unsigned long long>(bucketCount) * pilotWidth + 63) / 64, 0);
+    for (unsigned int b = 0; b < bucketCount; b++)
+    {
+        unsigned long long bit = static_cast<unsigned long long>(b) * pilotWidth;
+        pilots[bit / 64] |= bucketPilots[b] << (bit % 64);
+        if (bit % 64 + pilotWidth > 64)
+        {
+            pilots[bit / 64 + 1] |= bucketPilots[b] >> (64 - bit % 64);
+        }
+    }
+
+    // remap the positions past numberOfElements onto the free slots below
+    // it; there are exactly as many of each
+    freeSlots.assign(tableSize - numberOfElements, 0);
+    unsigned int nextFree = 0;
+    for (unsigned int p = numberOfElements; p < tableSize; p++)
+    {
+        if (taken[p])
+        {
+            while (taken[nextFree])
+            {
+                nextFree++;
+            }
+            freeSlots[p - numberOfElements] = nextFree;
+            nextFree++;
+        }
+    }
+
+    // lay out the words in slot order
+    std::vector<unsigned int> wordInSlot(numberOfElements);
+    for (unsigned int i = 0; i < numberOfElements; i++)
+    {
+        unsigned int slot = position[i];
+        if (slot >= numberOfElements)
+        {
+            slot = freeSlots[slot - numberOfElements];
+        }
+        wordInSlot[slot] = keys[i].word;
+    }
+    offsets.assign(1, 0);
+    characters.clear();
+    for (unsigned int slot = 0; slot < numberOfElements; slot++)
+    {
+        const std::string& word = words[wordInSlot[slot]];
+        characters.insert(characters.end(), word.begin(), word.end());
+        offsets.push_back(characters.size());
+    }
+
+    return true;
+}
+
+
+unsigned int PerfectHashSet::bucketOf(std::uint64_t hashCode) const
+{
+    std::uint64_t low = hashCode & 0xffffffffu;
+    std::uint64_t high = hashCode >> 32;
+    if (denseBucketCount > 0 && low < static_cast<std::uint64_t>(DENSE_KEYS * 4294967296.0))
+    {
+        return high % denseBucketCount;
+    }
+    return denseBucketCount + high % (bucketCount - denseBucketCount);
+}
+
+
+unsigned int PerfectHashSet::positionOf(std::uint64_t hashCode, std::uint64_t pilot) const
+{
+    return (hashCode ^ hashPilot(pilot)) % tableSize;
+}
+
+
+std::uint64_t PerfectHashSet::pilotOf(unsigned int bucket) const
+{
+    unsigned long long bit = static_cast<unsigned long long>(bucket) * pilotWidth;
+    std::uint64_t value = pilots[bit / 64] >> (bit % 64);
+    if (bit % 64 + pilotWidth > 64)
+    {
+        value |= pilots[bit / 64 + 1] << (64 - bit % 64);
+    }
+    if (pilotWidth < 64)
+    {
+        value &= (std::uint64_t{1} << pilotWidth) - 1;
+    }
+    return value;
+}
+
@@ -0,0 +1,123 @@
+// PerfectHashSet.hpp
+//
+// ICS 46 Spring 2015
+// Project #3: Set the Controls for the Heart of the Sun
+//
+// A PerfectHashSet is a read-only implementation of a Set of strings,
+// built once from a fixed list of words.  It uses a minimal perfect hash
+// function, which maps each of its n words to a different slot in
+// [0, n), so a lookup hashes the word, reads one slot and compares the
+// word against the one stored there; there are no collisions and no
+// chains to follow.
+//
+// The hash function is built with the PTHash algorithm (Pibiri and
+// Trani, 2021).  Words are hashed into buckets of about five words each,
+// and each bucket is assigned a "pilot" value that, mixed into the hash
+// of each of its words, sends them all to free slots of a table slightly
+// larger than n.  Slots past n are then remapped onto the slots in
+// [0, n) left free.  The pilots are stored bit-packed, which takes about
+// three bits per word; the words themselves are packed end to end in
+// slot order.
+//
+// Building is the expensive part, so a PerfectHashSet can be written to
+// a stream and read back, allowing it to be built offline.
+
+#ifndef PERFECTHASHSET_HPP
+#define PERFECTHASHSET_HPP
+
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <vector>
+#include "Set.hpp"
+
+
+
+class PerfectHashSet : public Set<std::string>
+{
+public:
+    // Builds a PerfectHashSet containing the given words.  Duplicate words
+    // are allowed and are stored only once.
+    PerfectHashSet(const std::vector<std::string>& words);
+
+    // Reads a PerfectHashSet that was previously saved with write().
+    // Throws a std::runtime_error if the stream doesn't contain one.
+    PerfectHashSet(std::istream& in);
+
+
+    // isImplemented() returns true, since PerfectHashSet is implemented.
+    virtual bool isImplemented() const;
+
+
+    // A PerfectHashSet can't be changed after it's built, so add() always
+    // throws a std::logic_error.
+    virtual void add(const std::string& element);
+
+
+    // contains() returns true if the given element is one of the set's
+    // words, false otherwise.  It hashes the element once, reads one
+    // pilot and one slot, and makes one comparison.
+    virtual bool contains(const std::string& element) const;
+
+
+    // size() returns the number of elements in the set.
+    virtual unsigned int size() const;
+
+
+    // write() saves the set to a stream, so it can be read back by the
+    // PerfectHashSet(std::istream&) constructor without being rebuilt.
+    void write(std::ostream& out) const;
+
+
+    // indexBits() returns the number of bits used by the hash function
+    // itself (the pilots and the remapped slots), not counting the words.
+    unsigned long long indexBits() const;
+
+
+private:
+    // the seed of the hash function, changed if a build attempt fails
+    std::uint64_t seed;
+
+    // the number of words
+    unsigned int numberOfElements;
+
+    // the number of buckets, and how many of them are "dense"; a dense
+    // bucket receives more words than the others, which makes the
+    // largest buckets easy to place while the table is empty
+    unsigned int bucketCount;
+    unsigned int denseBucketCount;
+
+    // the size of the table that pilots map into, a little larger than
+    // numberOfElements
+    unsigned int tableSize;
+
+    // the pilot of every bucket, packed pilotWidth bits apiece
+    unsigned int pilotWidth;
+    std::vector<std::uint64_t> pilots;
+
+    // freeSlots[i] is the slot that table position numberOfElements + i
+    // is remapped to
+    std::vector<unsigned int> freeSlots;
+
+    // the word in slot i occupies characters [offsets[i], offsets[i + 1])
+    std::vector<unsigned int> offsets;
+    std::vector<char> characters;
+
+    // tries to build the hash function for the given distinct words with
+    // the current seed; returns false if it needs a different seed
+    bool build(const std::vector<std::string>& words);
+
+    // returns the bucket that a hash value belongs to
+    unsigned int bucketOf(std::uint64_t hashCode) const;
+
+    // returns the table position a hash value is sent to by a pilot
+    unsigned int positionOf(std::uint64_t hashCode, std::uint64_t pilot) const;
+
+    // reads the pilot of a bucket from the packed array
+    std::uint64_t pilotOf(unsigned int bucket) const;
+};
+
+
+
+#endif // PERFECTHASHSET_HPP
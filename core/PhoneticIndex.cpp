@@ -0,0 +1,363 @@
+// PhoneticIndex.cpp
+//
+// ICS 46 Spring 2015
+// Project #3: Set the Controls for the Heart of the Sun
+
+#include "PhoneticIndex.hpp"
+#include <algorithm>
+#include <utility>
+#include "HashPolicy.hpp"
+
+
+namespace
+{
+    bool isVowel(char c)
+    {
+        return c == 'A' || c == 'E' || c == 'I' || c == 'O' || c == 'U';
+    }
+
+
+    bool isFrontVowel(char c)
+    {
+        return c == 'E' || c == 'I' || c == 'Y';
+    }
+
+
+    // returns the upper-case form of c if it's a letter, or '\0' if not
+    char letterOf(char c)
+    {
+        if (c >= 'a' && c <= 'z')
+        {
+            return c - 'a' + 'A';
+        }
+        if (c >= 'A' && c <= 'Z')
+        {
+            return c;
+        }
+        return '\0';
+    }
+
+
+    std::uint64_t keyHash(const char* key, unsigned int length)
+    {
+        return wyhash(key, length);
+    }
+}
+
+
+
+constexpr unsigned int PhoneticIndex::MAX_KEY_LENGTH;
+
+
+PhoneticIndex::PhoneticIndex(const std::vector<std::string>& words)
+{
+    // sort the distinct words by key, then alphabetically
+    std::vector<std::pair<std::string, std::string>> keyed;
+    for (const std::string& word : words)
+    {
+        keyed.emplace_back(encode(word), word);
+    }
+    std::sort(keyed.begin(), keyed.end());
+    keyed.erase(std::unique(keyed.begin(), keyed.end()), keyed.end());
+
+    offsets.push_back(0);
+    keyOffsets.push_back(0);
+    for (unsigned int w = 0; w < keyed.size(); w++)
+    {
+        if (w == 0 || keyed[w].first != keyed[w - 1].first)
+        {
+            groupStarts.push_back(w);
+            keyCharacters.insert(keyCharacters.end(), keyed[w].first.begin(), keyed[w].first.end());
+            keyOffsets.push_back(keyCharacters.size());
+        }
+        characters.insert(characters.end(), keyed[w].second.begin(), keyed[w].second.end());
+        offsets.push_back(characters.size());
+    }
+    groupStarts.push_back(keyed.size());
+
+    unsigned int keyCount = keyOffsets.size() - 1;
+    unsigned int slotCount = 2;
+    while (slotCount < 2 * keyCount)
+    {
+        slotCount *= 2;
+    }
+    slots.assign(slotCount, 0);
+    for (unsigned int k = 0; k < keyCount; k++)
+    {
+        unsigned int slot = keyHash(keyCharacters.data() + keyOffsets[k], keyOffsets[k + 1] - keyOffsets[k]);
+        slot &= slotCount - 1;
+        while (slots[slot] != 0)
+        {
+            slot = (slot + 1) & (slotCount - 1);
+        }
+        slots[slot] = k + 1;
+    }
+}
+
+
+unsigned int PhoneticIndex::size() const
+{
+    return offsets.size() - 1;
+}
+
+
+std::size_t PhoneticIndex::bytes() const
+{
+    return (offsets.size() + groupStarts.size() + keyOffsets.size() + slots.size()) * sizeof(unsigned int)
+        + characters.size() + keyCharacters.size();
+}
+
+
+int PhoneticIndex::findKey(const char* key, unsigned int length) const
+{
+    unsigned int mask = slots.size() - 1;
+    unsigned int slot = keyHash(key, length) & mask;
+    while (slots[slot] != 0)
+    {
+        unsigned int k = slots[slot] - 1;
+        if (keyOffsets[k + 1] - keyOffsets[k] == length
+            && std::memcmp(keyCharacters.data() + keyOffsets[k], key, length) == 0)
+        {
+            return k;
+        }
+        slot = (slot + 1) & mask;
+    }
+    return -1;
+}
+
+
+unsigned int PhoneticIndex::encode(const std::string& word, char* key)
+{
+    // gather the letters into a fixed-size array, so that looking up a
+    // word doesn't allocate; letters past the array can't make it into a
+    // key anyway, since every letter adds at most two characters to it
+    const int MAX_LETTERS = 4 * MAX_KEY_LENGTH;
+    char letters[MAX_LETTERS];
+    int n = 0;
+    for (char c : word)
+    {
+        char letter = letterOf(c);
+        if (letter != '\0' && n < MAX_LETTERS)
+        {
+            letters[n++] = letter;
+        }
+    }
+
+    unsigned int length = 0;
+    auto emit =
+        [&](char c)
+        {
+            if (length < MAX_KEY_LENGTH)
+            {
+                key[length++] = c;
+            }
+        };
+    auto at =
+        [&](int i)
+        {
+            return (i >= 0 && i < n) ? letters[i] : '\0';
+        };
+
+    // some pairs of letters at the beginning of a word have a silent first
+    // letter, and a few others sound like something else
+    int i = 0;
+    char first = at(0);
+    char second = at(1);
+    if ((first == 'A' && second == 'E') || (first == 'G' && second == 'N')
+        || (first == 'K' && second == 'N') || (first == 'P' && second == 'N')
+        || (first == 'W' && second == 'R'))
+    {
+        i = 1;
+    }
+    else if (first == 'X')
+    {
+        emit('S');
+        i = 1;
+    }
+    else if (first == 'W' && second == 'H')
+    {
+        emit('W');
+        i = 2;
+    }
+
+    for (int start = i; i < n; i++)
+    {
+        char c = at(i);
+        char previous = at(i - 1);
+        char next = at(i + 1);
+        char afterNext = at(i + 2);
+
+        // a doubled letter sounds like one, except for CC, as in ACCENT
+        if (i > start && c == previous && c != 'C')
+        {
+            continue;
+        }
+
+        switch (c)
+        {
+        case 'A':
+        case 'E':
+        case 'I':
+        case 'O':
+        case 'U':
+            // vowels only matter at the beginning, and all sound alike there
+            if (i == 0)
+            {
+                emit('A');
+            }
+            break;
+
+        case 'B':
+            // silent at the end after M, as in DUMB
+            if (!(previous == 'M' && next == '\0'))
+            {
+                emit('B');
+            }
+            break;
+
+        case 'C':
+            if (next == 'I' && afterNext == 'A')
+            {
+                emit('X');
+            }
+            else if (next == 'H')
+            {
+                emit(previous == 'S' ? 'K' : 'X');
+                i++;
+            }
+            else if (isFrontVowel(next))
+            {
+                // silent in SCI, SCE and SCY
+                if (previous != 'S')
+                {
+                    emit('S');
+                }
+            }
+            else
+            {
+                emit('K');
+            }
+            break;
+
+        case 'D':
+            if (next == 'G' && isFrontVowel(afterNext))
+            {
+                emit('J');
+                i++;
+            }
+            else
+            {
+                emit('T');
+            }
+            break;
+
+        case 'G':
+            if (next == 'H' && !isVowel(afterNext))
+            {
+                // silent in GH before a consonant or at the end, as in NIGHT
+                i++;
+            }
+            else if (next == 'N' && (afterNext == '\0'
+                || (afterNext == 'E' && at(i + 3) == 'D' && at(i + 4) == '\0')))
+            {
+                // silent in GN and GNED at the end, as in SIGN and SIGNED
+            }
+            else if (isFrontVowel(next) && previous != 'G')
+            {
+                emit('J');
+            }
+            else
+            {
+                emit('K');
+            }
+            break;
+
+        case 'H':
+            // silent after some consonants, and when not before a vowel
+            if (isVowel(next) && previous != 'C' && previous != 'S'
+                && previous != 'P' && previous != 'T' && previous != 'G')
+            {
+                emit('H');
+            }
+            break;
+
+        case 'K':
+            if (previous != 'C')
+            {
+                emit('K');
+            }
+            break;
+
+        case 'P':
+            emit(next == 'H' ? 'F' : 'P');
+            break;
+
+        case 'Q':
+            emit('K');
+            break;
+
+        case 'S':
+            if (next == 'H' || (next == 'I' && (afterNext == 'O' || afterNext == 'A')))
+            {
+                emit('X');
+            }
+            else
+            {
+                emit('S');
+            }
+            break;
+
+        case 'T':
+            if (next == 'I' && (afterNext == 'O' || afterNext == 'A'))
+            {
+                emit('X');
+            }
+            else if (next == 'H')
+            {
+                // the TH sound, written as 0 in Metaphone
+                emit('0');
+                i++;
+            }
+            else if (!(next == 'C' && afterNext == 'H'))
+            {
+                emit('T');
+            }
+            break;
+
+        case 'V':
+            emit('F');
+            break;
+
+        case 'W':
+        case 'Y':
+            if (isVowel(next))
+            {
+                emit(c);
+            }
+            break;
+
+        case 'X':
+            emit('K');
+            emit('S');
+            break;
+
+        case 'Z':
+            emit('S');
+            break;
+
+        default: // F, J, L, M, N and R sound like themselves
+            emit(c);
+            break;
+        }
+    }
+
+    return length;
+}
+
+
+std::string PhoneticIndex::encode(const std::string& word)
+{
+    char key[MAX_KEY_LENGTH];
+    unsigned int length = encode(word, key);
+    return std::string(key, length);
+}
@@ -0,0 +1,118 @@
+// PhoneticIndex.hpp
+//
+// ICS 46 Spring 2015
+// Project #3: Set the Controls for the Heart of the Sun
+//
+// A PhoneticIndex finds the words in a fixed list that sound like a given
+// word, even when they're spelled differently enough that no single edit
+// turns one into the other, as with FONETIK and PHONETIC.
+//
+// Every word is reduced to a phonetic key with a simplified form of
+// Lawrence Philips' Metaphone algorithm: vowels after the first letter are
+// dropped, letters that sound alike are mapped to the same one (PH and F
+// both become F, C becomes K or S depending on what follows it, and so
+// on), and silent letters are left out.  Words with the same key are
+// kept together, so looking a word up means computing its key and
+// finding that key in an open-addressed hash table, which usually takes
+// one probe; the matching words are then read from one contiguous range.
+//
+// Keys are cut off at MAX_KEY_LENGTH characters, and are computed into a
+// fixed-size array, so a lookup allocates no memory.
+
+#ifndef PHONETICINDEX_HPP
+#define PHONETICINDEX_HPP
+
+#include <cstddef>
+#include <cstring>
+#include <string>
+#include <vector>
+
+
+
+class PhoneticIndex
+{
+public:
+    // Keys longer than this are cut off.
+    static constexpr unsigned int MAX_KEY_LENGTH = 8;
+
+public:
+    // Builds a PhoneticIndex of the given words.  Duplicate words are
+    // allowed and are indexed only once.
+    PhoneticIndex(const std::vector<std::string>& words);
+
+
+    // size() returns the number of distinct words in the index.
+    unsigned int size() const;
+
+
+    // bytes() returns the memory used by the index, including its words.
+    std::size_t bytes() const;
+
+
+    // forEachSoundAlike() calls callback(characters, length) for each
+    // word with the same phonetic key as word, in ascending order, until
+    // limit of them have been passed to it; it returns how many were.
+    // The characters are good as long as the index is.
+    template <typename Callback>
+    unsigned int forEachSoundAlike(
+        const std::string& word, unsigned int limit, Callback callback) const;
+
+
+    // encode() computes the phonetic key of word into key, which must have
+    // room for MAX_KEY_LENGTH characters, and returns the key's length.
+    // Letters may be in either case; anything else is ignored.
+    static unsigned int encode(const std::string& word, char* key);
+
+
+    // encode() returns the phonetic key of word as a string.
+    static std::string encode(const std::string& word);
+
+
+private:
+    // the words are sorted by key, then alphabetically; the word numbered
+    // i occupies characters [offsets[i], offsets[i + 1])
+    std::vector<unsigned int> offsets;
+    std::vector<char> characters;
+
+    // the words whose key is numbered k are the ones numbered
+    // [groupStarts[k], groupStarts[k + 1]), and key k itself occupies
+    // keyCharacters[keyOffsets[k], keyOffsets[k + 1])
+    std::vector<unsigned int> groupStarts;
+    std::vector<unsigned int> keyOffsets;
+    std::vector<char> keyCharacters;
+
+    // an open-addressed hash table of key numbers plus one, with 0 in the
+    // empty slots; its size is a power of two, at least twice the number
+    // of keys
+    std::vector<unsigned int> slots;
+
+    // returns the number of the given key, or -1 if no word has it
+    int findKey(const char* key, unsigned int length) const;
+};
+
+
+
+template <typename Callback>
+unsigned int PhoneticIndex::forEachSoundAlike(
+    const std::string& word, unsigned int limit, Callback callback) const
+{
+    char key[MAX_KEY_LENGTH];
+    unsigned int length = encode(word, key);
+    int k = findKey(key, length);
+    if (k < 0)
+    {
+        return 0;
+    }
+
+    unsigned int count = 0;
+    for (unsigned int w = groupStarts[k]; w < groupStarts[k + 1] && count < limit; w++)
+    {
+        callback(characters.data() + offsets[w], offsets[w + 1] - offsets[w]);
+        count++;
+    }
+    return count;
+}
+
+
+
+#endif // PHONETICINDEX_HPP
@@ -0,0 +1,34 @@
+// Prefetch.hpp
+//
+// ICS 46 Spring 2015
+// Project #3: Set the Controls for the Heart of the Sun
+//
+// prefetch() asks the processor to start loading the cache line holding
+// an address, without waiting for it.  The sets' containsMany() functions
+// use it to look up a group of elements at once: they advance each lookup
+// by one step, prefetching the node that the step leads to, and by the
+// time they come back around to that lookup the node is usually in the
+// cache.  That way the cache misses of the whole group overlap, instead
+// of being paid one after another.
+
+#ifndef PREFETCH_HPP
+#define PREFETCH_HPP
+
+
+
+// The number of lookups that containsMany() interleaves at once.
+constexpr unsigned int PREFETCH_GROUP_SIZE = 16;
+
+
+inline void prefetch(const void* address)
+{
+#if defined(__GNUC__)
+    __builtin_prefetch(address);
+#else
+    (void)address;
+#endif
+}
+
+
+
+#endif // PREFETCH_HPP
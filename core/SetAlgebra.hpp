@@ -0,0 +1,307 @@
+// SetAlgebra.hpp
+//
+// ICS 46 Spring 2015
+// Project #3: Set the Controls for the Heart of the Sun
+//
+// unionOf(), intersectionOf() and differenceOf() combine two sets, such
+// as an old and a new release of a dictionary, passing each element of
+// the result to a callback rather than calling contains() on one set for
+// every element of the other from outside.
+//
+// When both sets are ordered (AVLSets or SkipListSets, in any
+// combination), they're merged: both are walked with their Iterators at
+// once, in ascending order, so the operation takes linear time and the
+// results come out in ascending order.
+//
+// Otherwise, one set is walked and each of its elements is looked up in
+// the other.  When the set being walked is a HashSet, its buckets are
+// split into slices, one per thread, and the slices are probed in
+// parallel; each thread keeps its results, which are then passed to the
+// callback on the calling thread, slice by slice, so the callback needn't
+// be thread-safe and the order of the results doesn't depend on the
+// threads.  Intersections walk the smaller set.  Since the set being
+// looked in is read by several threads at once, it mustn't be a HashSet
+// in ObservedFrequency order, whose lookups reorder its chains, unless
+// threadCount is 1.
+
+#ifndef SETALGEBRA_HPP
+#define SETALGEBRA_HPP
+
+#include <type_traits>
+#include <vector>
+#include "AVLSet.hpp"
+#include "HashSet.hpp"
+#include "Parallel.hpp"
+#include "SkipListSet.hpp"
+
+
+
+// IsOrderedSet<SetType> is true if SetType's Iterators visit its elements
+// in ascending order.
+template <typename SetType>
+struct IsOrderedSet : std::false_type
+{
+};
+
+
+template <typename T>
+struct IsOrderedSet<AVLSet<T>> : std::true_type
+{
+};
+
+
+template <typename T>
+struct IsOrderedSet<SkipListSet<T>> : std::true_type
+{
+};
+
+
+
+// unionOf() calls output(element) for each element that's in a, b or
+// both.
+template <typename SetA, typename SetB, typename Output>
+void unionOf(
+    const SetA& a, const SetB& b, Output output,
+    unsigned int threadCount = defaultThreadCount());
+
+
+// intersectionOf() calls output(element) for each element that's in both
+// a and b.
+template <typename SetA, typename SetB, typename Output>
+void intersectionOf(
+    const SetA& a, const SetB& b, Output output,
+    unsigned int threadCount = defaultThreadCount());
+
+
+// differenceOf() calls output(element) for each element that's in a but
+// not in b.
+template <typename SetA, typename SetB, typename Output>
+void differenceOf(
+    const SetA& a, const SetB& b, Output output,
+    unsigned int threadCount = defaultThreadCount());
+
+
+
+namespace setAlgebraDetail
+{
+    // merges two ordered sets, calling output(element) for the elements
+    // only in a if keepA, for those in both if keepBoth, and for those
+    // only in b if keepB
+    template <typename SetA, typename SetB, typename Output>
+    void merge(const SetA& a, const SetB& b, Output& output, bool keepA, bool keepBoth, bool keepB)
+    {
+        auto i = a.begin();
+        auto iEnd = a.end();
+        auto j = b.begin();
+        auto jEnd = b.end();
+        while (i != iEnd && j != jEnd)
+        {
+            if (*i < *j)
+            {
+                if (keepA)
+                {
+                    output(*i);
+                }
+                ++i;
+            }
+            else if (*j < *i)
+            {
+                if (keepB)
+                {
+                    output(*j);
+                }
+                ++j;
+            }
+            else
+            {
+                if (keepBoth)
+                {
+                    output(*i);
+                }
+                ++i;
+                ++j;
+            }
+        }
+        for (; keepA && i != iEnd; ++i)
+        {
+            output(*i);
+        }
+        for (; keepB && j != jEnd; ++j)
+        {
+            output(*j);
+        }
+    }
+
+
+    // returns true if other contains element
+    template <typename Other, typename T>
+    bool lookup(const Other& other, const T& element, std::false_type)
+    {
+        // a qualified call is bound statically, so it can be inlined
+        return other.Other::contains(element);
+    }
+
+
+    template <typename Other, typename T>
+    bool lookup(const Other& other, const T& element, std::true_type)
+    {
+        // an abstract Other's contains() may be pure virtual (as Set's is),
+        // so it has to be called virtually
+        return other.contains(element);
+    }
+
+
+    template <typename Other, typename T>
+    bool lookup(const Other& other, const T& element)
+    {
+        return lookup(other, element, std::is_abstract<Other>{});
+    }
+
+
+    // calls output(element) for each element of source that other contains
+    // if wanted is true, or doesn't contain if it's false; a HashSet source
+    // is probed a slice of buckets per thread
+    template <typename Source, typename Other, typename Output>
+    void probe(
+        const Source& source, const Other& other, Output& output, bool wanted,
+        unsigned int)
+    {
+        for (auto i = source.begin(); i != source.end(); ++i)
+        {
+            if (lookup(other, *i) == wanted)
+            {
+                output(*i);
+            }
+        }
+    }
+
+
+    template <typename T, typename HashPolicy, typename Other, typename Output>
+    void probe(
+        const HashSet<T, HashPolicy>& source, const Other& other, Output& output, bool wanted,
+        unsigned int threadCount)
+    {
+        unsigned int buckets = source.bucketCount();
+        if (threadCount == 0)
+        {
+            threadCount = 1;
+        }
+
+        std::vector<std::vector<const T*>> slices(threadCount);
+        runInParallel(threadCount,
+            [&](unsigned int slice)
+            {
+                source.forEachInBuckets(
+                    sliceBegin(buckets, threadCount, slice),
+                    sliceBegin(buckets, threadCount, slice + 1),
+                    [&](const T& element)
+                    {
+                        if (lookup(other, element) == wanted)
+                        {
+                            slices[slice].push_back(&element);
+                        }
+                    });
+            });
+
+        for (const std::vector<const T*>& slice : slices)
+        {
+            for (const T* element : slice)
+            {
+                output(*element);
+            }
+        }
+    }
+
+
+    template <typename SetA, typename SetB, typename Output>
+    void unionOf(
+        const SetA& a, const SetB& b, Output& output, unsigned int, std::true_type)
+    {
+        merge(a, b, output, true, true, true);
+    }
+
+
+    template <typename SetA, typename SetB, typename Output>
+    void unionOf(
+        const SetA& a, const SetB& b, Output& output, unsigned int threadCount, std::false_type)
+    {
+        for (auto i = a.begin(); i != a.end(); ++i)
+        {
+            output(*i);
+        }
+        probe(b, a, output, false, threadCount);
+    }
+
+
+    template <typename SetA, typename SetB, typename Output>
+    void intersectionOf(
+        const SetA& a, const SetB& b, Output& output, unsigned int, std::true_type)
+    {
+        merge(a, b, output, false, true, false);
+    }
+
+
+    template <typename SetA, typename SetB, typename Output>
+    void intersectionOf(
+        const SetA& a, const SetB& b, Output& output, unsigned int threadCount, std::false_type)
+    {
+        if (a.size() <= b.size())
+        {
+            probe(a, b, output, true, threadCount);
+        }
+        else
+        {
+            probe(b, a, output, true, threadCount);
+        }
+    }
+
+
+    template <typename SetA, typename SetB, typename Output>
+    void differenceOf(
+        const SetA& a, const SetB& b, Output& output, unsigned int, std::true_type)
+    {
+        merge(a, b, output, true, false, false);
+    }
+
+
+    template <typename SetA, typename SetB, typename Output>
+    void differenceOf(
+        const SetA& a, const SetB& b, Output& output, unsigned int threadCount, std::false_type)
+    {
+        probe(a, b, output, false, threadCount);
+    }
+
+
+    template <typename SetA, typename SetB>
+    using BothOrdered = std::integral_constant<bool,
+        IsOrderedSet<SetA>::value && IsOrderedSet<SetB>::value>;
+}
+
+
+
+template <typename SetA, typename SetB, typename Output>
+void unionOf(const SetA& a, const SetB& b, Output output, unsigned int threadCount)
+{
+    setAlgebraDetail::unionOf(
+        a, b, output, threadCount, setAlgebraDetail::BothOrdered<SetA, SetB>{});
+}
+
+
+template <typename SetA, typename SetB, typename Output>
+void intersectionOf(const SetA& a, const SetB& b, Output output, unsigned int threadCount)
+{
+    setAlgebraDetail::intersectionOf(
+        a, b, output, threadCount, setAlgebraDetail::BothOrdered<SetA, SetB>{});
+}
+
+
+template <typename SetA, typename SetB, typename Output>
+void differenceOf(const SetA& a, const SetB& b, Output output, unsigned int threadCount)
+{
+    setAlgebraDetail::differenceOf(
+        a, b, output, threadCount, setAlgebraDetail::BothOrdered<SetA, SetB>{});
+}
+
+
+
+#endif // SETALGEBRA_HPP
@@ -0,0 +1,353 @@
+// ShardedHashSet.hpp
+//
+// ICS 46 Spring 2015
+// Project #3: Set the Controls for the Heart of the Sun
+//
+// A ShardedHashSet is an implementation of a Set that many threads can
+// use at once.  It's split into a fixed number of shards, each of which
+// is a separately-chained hash table of its own with its own lock.  An
+// element's hash decides which shard it belongs to, so threads adding
+// elements that land in different shards never wait on one another.
+//
+// Only add() takes a lock.  contains() takes none: new nodes are linked
+// in at the front of their chain and published with a single atomic
+// store, after which they never change, so a reader always sees either
+// the old chain or the new one.  When a shard grows past a load factor
+// of 0.8, it builds a new array twice as large out of copies of its
+// nodes and publishes that, rather than relinking nodes that readers
+// might be walking.
+//
+// The old array and its nodes are retired rather than deleted, and freed
+// as soon as no reader can still be walking them.  Each shard counts the
+// contains() calls in progress on it; a writer holding the shard's lock
+// frees the shard's retired arrays whenever it finds that count at zero,
+// which it checks after every resize and every add() while there are any.
+// A reader that loads the table after the count went up is guaranteed to
+// see the new table, so a count of zero means nobody holds an old one.
+// The cost is an atomic increment and decrement on the shard for every
+// contains(), which threads reading the same shard contend on.  Under a
+// steady stream of readers of one shard, its retired arrays can live
+// until the readers pause, so the set's memory can briefly reach about
+// twice what its live tables need, but it drops back once they do.
+
+#ifndef SHARDEDHASHSET_HPP
+#define SHARDEDHASHSET_HPP
+
+#include <atomic>
+#include <mutex>
+#include "HashPolicy.hpp"
+#include "Set.hpp"
+
+
+
+template <typename T, typename HashPolicy = DefaultHash<T>>
+class ShardedHashSet : public Set<T>
+{
+public:
+    // The default number of shards, which is also the number of writers
+    // that can add elements without contending for a lock.
+    static constexpr unsigned int DEFAULT_SHARD_COUNT = 64;
+
+    // The capacity of each shard before anything has been added to it.
+    static constexpr unsigned int DEFAULT_SHARD_CAPACITY = 16;
+
+public:
+    // Initializes a ShardedHashSet to be empty, split into the given number
+    // of shards.
+    ShardedHashSet(unsigned int shardCount = DEFAULT_SHARD_COUNT);
+
+    // Cleans up the ShardedHashSet so that it leaks no memory.  No other
+    // thread may be using it at this point.
+    virtual ~ShardedHashSet();
+
+    // A ShardedHashSet can't be copied or assigned, since its locks can't.
+    ShardedHashSet(const ShardedHashSet& s) = delete;
+    ShardedHashSet& operator=(const ShardedHashSet& s) = delete;
+
+
+    // isImplemented() returns true, since ShardedHashSet is implemented.
+    virtual bool isImplemented() const;
+
+
+    // add() adds an element to the set.  If the element is already in the set,
+    // this function has no effect.  It's safe to call from many threads at
+    // once; it locks only the element's shard.  It runs in constant time,
+    // except when the shard is resized, which takes time linear in the
+    // size of the shard.
+    virtual void add(const T& element);
+
+
+    // contains() returns true if the given element is already in the set,
+    // false otherwise.  It's safe to call from many threads at once,
+    // including while other threads call add(), and never waits on a
+    // lock.  It runs in constant time (assuming a good hash function).
+    virtual bool contains(const T& element) const;
+
+
+    // size() returns the number of elements in the set.  While other
+    // threads are adding elements, it may not count the newest ones.
+    virtual unsigned int size() const;
+
+
+private:
+    struct Node
+    {
+        T data;
+        Node* next;
+    };
+
+    // a Table is one generation of a shard's array of chains
+    struct Table
+    {
+        unsigned int capacity;
+        std::atomic<Node*>* buckets;
+        // the next older retired generation, once this one is retired
+        Table* nextRetired;
+    };
+
+    // each Shard is padded out past a cache line, so that writers working
+    // on neighboring shards don't slow each other down
+    struct Shard
+    {
+        std::mutex lock;
+        std::atomic<Table*> table;
+        std::atomic<unsigned int> numberOfElements;
+        // the number of contains() calls walking this shard's chains,
+        // which even a const ShardedHashSet counts
+        mutable std::atomic<unsigned int> readers;
+        // the tables this one has replaced that might still have readers,
+        // newest first; only touched with the lock held
+        Table* retired;
+        char padding[64];
+    };
+
+    HashPolicy hashPolicy;
+
+    // store the number of shards
+    unsigned int shardCount;
+
+    // a Shard array
+    Shard* shards;
+
+    // creates an empty Table with the given capacity
+    static Table* newTable(unsigned int capacity);
+
+    // replaces a shard's table with one twice as large and retires the
+    // old one; the shard's lock must be held
+    void resize(Shard& shard);
+
+    // frees a shard's retired tables if no reader is walking the shard;
+    // the shard's lock must be held
+    static void reclaimRetired(Shard& shard);
+
+    // helper function for destructor; deletes one table and its nodes
+    static void deallocate(Table* table);
+};
+
+
+
+template <typename T, typename HashPolicy>
+ShardedHashSet<T, HashPolicy>::ShardedHashSet(unsigned int shardCount)
+    : hashPolicy{}, shardCount{shardCount == 0 ? 1 : shardCount}
+{
+    shards = new Shard[this->shardCount];
+    for (unsigned int i = 0; i < this->shardCount; i++)
+    {
+        shards[i].table.store(newTable(DEFAULT_SHARD_CAPACITY));
+        shards[i].numberOfElements.store(0);
+        shards[i].readers.store(0);
+        shards[i].retired = NULL;
+    }
+}
+
+
+template <typename T, typename HashPolicy>
+ShardedHashSet<T, HashPolicy>::~ShardedHashSet()
+{
+    for (unsigned int i = 0; i < shardCount; i++)
+    {
+        deallocate(shards[i].table.load());
+        Table* table = shards[i].retired;
+        while (table != NULL)
+        {
+            Table* nextRetired = table->nextRetired;
+            deallocate(table);
+            table = nextRetired;
+        }
+    }
+    delete[] shards;
+}
+
+
+template <typename T, typename HashPolicy>
+bool ShardedHashSet<T, HashPolicy>::isImplemented() const
+{
+    return true;
+}
+
+
+template <typename T, typename HashPolicy>
+void ShardedHashSet<T, HashPolicy>::add(const T& element)
+{
+    unsigned int hashCode = hashPolicy(element);
+    Shard& shard = shards[hashCode % shardCount];
+    unsigned int bucketCode = hashCode / shardCount;
+
+    std::lock_guard<std::mutex> guard{shard.lock};
+    if (shard.retired != NULL)
+    {
+        reclaimRetired(shard);
+    }
+
+    // only writers change the table, and they hold the lock, so a relaxed
+    // load sees the latest one
+    Table* table = shard.table.load(std::memory_order_relaxed);
+    std::atomic<Node*>& bucket = table->buckets[bucketCode % table->capacity];
+    Node* head = bucket.load(std::memory_order_relaxed);
+    for (Node* entry = head; entry != NULL; entry = entry->next)
+    {
+        if (entry->data == element)
+        {
+            return;
+        }
+    }
+
+    // the node is complete before the release store makes it visible
+    bucket.store(new Node{element, head}, std::memory_order_release);
+
+    unsigned int count = shard.numberOfElements.load(std::memory_order_relaxed) + 1;
+    shard.numberOfElements.store(count, std::memory_order_relaxed);
+    if (count > 0.8 * table->capacity)
+    {
+        resize(shard);
+    }
+}
+
+
+template <typename T, typename HashPolicy>
+bool ShardedHashSet<T, HashPolicy>::contains(const T& element) const
+{
+    unsigned int hashCode = hashPolicy(element);
+    const Shard& shard = shards[hashCode % shardCount];
+    unsigned int bucketCode = hashCode / shardCount;
+
+    // announce the read before loading the table; both are sequentially
+    // consistent, so a writer that retires this table afterward is bound
+    // to see the count and leave it alone
+    shard.readers.fetch_add(1);
+    const Table* table = shard.table.load();
+    Node* entry = table->buckets[bucketCode % table->capacity].load(std::memory_order_acquire);
+    bool found = false;
+    while (entry != NULL)
+    {
+        if (entry->data == element)
+        {
+            found = true;
+            break;
+        }
+        entry = entry->next;
+    }
+    shard.readers.fetch_sub(1, std::memory_order_release);
+    return found;
+}
+
+
+template <typename T, typename HashPolicy>
+unsigned int ShardedHashSet<T, HashPolicy>::size() const
+{
+    unsigned int total = 0;
+    for (unsigned int i = 0; i < shardCount; i++)
+    {
+        total += shards[i].numberOfElements.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+
+template <typename T, typename HashPolicy>
+typename ShardedHashSet<T, HashPolicy>::Table*
+ShardedHashSet<T, HashPolicy>::newTable(unsigned int capacity)
+{
+    Table* table = new Table;
+    table->capacity = capacity;
+    table->buckets = new std::atomic<Node*>[capacity];
+    table->nextRetired = NULL;
+    for (unsigned int i = 0; i < capacity; i++)
+    {
+        table->buckets[i].store(NULL, std::memory_order_relaxed);
+    }
+    return table;
+}
+
+
+template <typename T, typename HashPolicy>
+void ShardedHashSet<T, HashPolicy>::resize(Shard& shard)
+{
+    Table* oldTable = shard.table.load(std::memory_order_relaxed);
+    Table* table = newTable(oldTable->capacity * 2);
+
+    // readers may still be walking the old chains, so copy the nodes into
+    // the new table instead of moving them
+    for (unsigned int i = 0; i < oldTable->capacity; i++)
+    {
+        Node* entry = oldTable->buckets[i].load(std::memory_order_relaxed);
+        for (; entry != NULL; entry = entry->next)
+        {
+            unsigned int bucketCode = hashPolicy(entry->data) / shardCount;
+            std::atomic<Node*>& bucket = table->buckets[bucketCode % table->capacity];
+            bucket.store(
+                new Node{entry->data, bucket.load(std::memory_order_relaxed)},
+                std::memory_order_relaxed);
+        }
+    }
+
+    // publishing the table also publishes every node linked into it; the
+    // store is sequentially consistent so that reclaimRetired() can trust
+    // the reader count it loads afterward
+    shard.table.store(table);
+    oldTable->nextRetired = shard.retired;
+    shard.retired = oldTable;
+    reclaimRetired(shard);
+}
+
+
+template <typename T, typename HashPolicy>
+void ShardedHashSet<T, HashPolicy>::reclaimRetired(Shard& shard)
+{
+    // a reader that came in after the count was zero loads the current
+    // table, which isn't retired
+    if (shard.readers.load() != 0)
+    {
+        return;
+    }
+    Table* table = shard.retired;
+    shard.retired = NULL;
+    while (table != NULL)
+    {
+        Table* nextRetired = table->nextRetired;
+        deallocate(table);
+        table = nextRetired;
+    }
+}
+
+
+template <typename T, typename HashPolicy>
+void ShardedHashSet<T, HashPolicy>::deallocate(Table* table)
+{
+    for (unsigned int i = 0; i < table->capacity; i++)
+    {
+        Node* entry = table->buckets[i].load(std::memory_order_relaxed);
+        while (entry != NULL)
+        {
+            Node* next = entry->next;
+            delete entry;
+            entry = next;
+        }
+    }
+    delete[] table->buckets;
+    delete table;
+}
+
+
+
+#endif // SHARDEDHASHSET_HPP
@@ -24,9 +24,15 @@
 #ifndef SKIPLISTSET_HPP
 #define SKIPLISTSET_HPP
 
+#include "Prefetch.hpp"
 #include "Set.hpp"
+#include "SortedRange.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
 #include <random>
 #include <string>
+#include <utility>
 // for storing skip list levels
 #include <vector>
 
@@ -116,9 +122,21 @@ public:
     // Initializes a new SkipListSet to be a copy of an existing one.
     SkipListSet(const SkipListSet& s);
 
+    // Initializes a new SkipListSet by taking over the levels of an existing
+    // one, which is left empty.  No nodes are copied.
+    SkipListSet(SkipListSet&& s);
+
     // Assigns an existing SkipListSet into another.
     SkipListSet& operator=(const SkipListSet& s);
 
+    // Moves the levels of an existing SkipListSet into another, in constant
+    // time.
+    SkipListSet& operator=(SkipListSet&& s);
+
+    // swap() exchanges the contents of two SkipListSets in constant time,
+    // by exchanging their vectors of head pointers rather than any nodes.
+    void swap(SkipListSet& s) noexcept;
+
     // isImplemented() should be modified to return true if you've
     // decided to implement a SkipListSet, false otherwise.
     virtual bool isImplemented() const;
@@ -135,6 +153,47 @@ public:
     // with very high probability.
     virtual bool contains(const T& element) const;
 
+    // containsMany() looks up count elements at once, setting results[i]
+    // to whether elements[i] is in the set.  It works through them in
+    // groups, interleaving the steps of each group's lookups and
+    // prefetching the nodes they'll visit next, so that the cache misses
+    // of a group overlap rather than following one another.
+    void containsMany(const T* elements, unsigned int count, bool* results) const;
+
+    // containsSorted() looks up count elements at once, setting results[i]
+    // to whether elements[i] is in the set.  It's meant for elements in
+    // ascending order, which it checks in one pass with a Finger; any
+    // order gives the right answers, but only ascending order is fast.
+    void containsSorted(const T* elements, unsigned int count, bool* results) const;
+
+    // forEachWithPrefix() calls callback(element) for each element in the
+    // set that begins with prefix, in ascending order, until limit of
+    // them have been passed to it; it returns how many were.  It finds
+    // the first such element in expected O(log n) time and then visits the rest in
+    // order, without allocating any memory, which makes it suitable for
+    // as-you-type autocompletion.  T must support compare(pos, len, other)
+    // the way std::string does.
+    template <typename Callback>
+    unsigned int forEachWithPrefix(const T& prefix, unsigned int limit, Callback callback) const;
+
+    // buildFromSorted() replaces the contents of the set with the elements
+    // in the range [begin, end), which must be in ascending order; repeated
+    // elements are added once.  Rather than flipping coins, it promotes
+    // elements deterministically: the ith one (counting from 1) goes up
+    // one level for every time 2 divides i, so every second element is on
+    // the second level, every fourth on the third, and so on.  Each
+    // element is appended to the end of its levels, so this takes O(n)
+    // time.  If the range isn't in order, it throws an
+    // std::invalid_argument and leaves the set as it was.
+    template <typename ForwardIt>
+    void buildFromSorted(ForwardIt begin, ForwardIt end);
+
+    // dumpSorted() writes every element of the set to out, in ascending
+    // order, in O(n) time, and returns out past the last of them.  The
+    // elements can be given back to buildFromSorted() to restore the set.
+    template <typename OutputIt>
+    OutputIt dumpSorted(OutputIt out) const;
+
     // size() returns the number of elements in the set.
     virtual unsigned int size() const;
 
@@ -147,44 +206,129 @@ public:
         Node* below;
     };
 
+    // A Finger remembers where its last search ended, so that a search for
+    // a larger element can start from there instead of from the top-left.
+    // It climbs only as high as it needs to in order to pass over the
+    // elements in between, so a search for an element d positions after
+    // the last one takes expected O(log d) time rather than O(log n).  A
+    // search for a smaller element starts over from the top.
+    //
+    // Adding elements to the set leaves a Finger's path usable.  Anything
+    // that replaces the set's nodes -- buildFromSorted(), assigning into
+    // the set, moving into or out of it, or swapping it -- sends a Finger
+    // back to the beginning on its next search.  Destroying the set leaves
+    // a Finger unusable.
+    class Finger
+    {
+    public:
+        // Initializes a Finger that searches the given set, starting at
+        // its beginning.
+        explicit Finger(const SkipListSet& set);
+
+        // contains() returns true if the given element is in the set,
+        // false otherwise, and leaves the Finger where it looked.
+        bool contains(const T& element);
+
+        // reset() sends the Finger back to the beginning of the set.
+        void reset();
+
+    private:
+        const SkipListSet* set;
+
+        // the last node before the last element searched for, on every
+        // level from the top down, like the predecessors add() finds
+        std::vector<Node*> path;
+
+        // the set's count of replacements when the path was found
+        unsigned int knownReplacements;
+    };
+
+    // An Iterator visits the elements of the set in ascending order.  Adding elements to
+    // the set doesn't invalidate it, but destroying the set does.
+    class Iterator
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const T*;
+        using reference = const T&;
+
+        const T& operator*() const;
+        const T* operator->() const;
+        Iterator& operator++();
+        Iterator operator++(int);
+        bool operator==(const Iterator& other) const;
+        bool operator!=(const Iterator& other) const;
+
+    private:
+        friend class SkipListSet;
+
+        // Initializes an Iterator at the given node on the bottom level,
+        // or at the end if it's the tail.
+        explicit Iterator(Node* node);
+
+        // the current node on the bottom level, or NULL at the end
+        Node* node;
+    };
+
+    // begin() returns an Iterator at the set's first element, and end() one
+    // past its last.
+    Iterator begin() const;
+    Iterator end() const;
+
 
 private:
-    // create a vector for storing head pointers
+    // create a vector for storing head pointers; the front is the top
+    // level, which is always empty, and the back is the bottom level,
+    // which contains every element
     std::vector<Node*> headPointers;
 
-    // store the height of the skip list
+    // store the height of the skip list (the number of levels below the
+    // empty top level)
     int height;
 
     // store the size of the skip list
     int numberOfElements;
 
+    // the number of times the set's nodes have been replaced wholesale,
+    // which Fingers check to know when the nodes on their paths are gone;
+    // add() only links new nodes in, so it doesn't count
+    unsigned int replacements;
+
+    // source of the coin flips that decide how far a key is promoted
+    std::default_random_engine engine;
+
+    // the most levels an element is ever promoted to, which is plenty for
+    // 2^32 elements; it lets add() keep its path on the stack
+    static constexpr int MAX_HEIGHT = 32;
+
     // coinFlip() function for deciding promote a key or not
     bool coinFlip();
 
+    // creates a level containing only a head and a tail, on top of the
+    // level whose head is below (or at the bottom, if below is NULL)
+    Node* newLevel(Node* below);
+
     // helper function for destructor
     void deallocate(Node* n);
 };
 
 
+template <typename T>
+constexpr int SkipListSet<T>::MAX_HEIGHT;
+
+
 template <typename T>
 SkipListSet<T>::SkipListSet()
+    : engine{std::random_device{}()}
 {
-    // creating head and tail node for the level
-    Node* head = new Node;
-    Node* tail = new Node;
-    // assign SkipListKind to head and tail nodes
-    head->kind = SkipListKind::NegInf;
-    tail->kind = SkipListKind::PosInf;
-    // connect tail to head
-    head->folow = tail;
-    head->below = NULL;
-    tail->folow = NULL;
-    tail->below = NULL;
-    // add the head pointer to vector
-    headPointers.push_back(head);
+    // add the head pointer of an empty level to vector
+    headPointers.push_back(newLevel(NULL));
     // initialize height and the size
     height = 0;
     numberOfElements = 0;
+    replacements = 0;
 }
 
 
@@ -192,7 +336,7 @@ template <typename T>
 SkipListSet<T>::~SkipListSet()
 {
     // passing one level per time to destructor helper function
-    for (int i = 0; i < headPointers.size(); i++)
+    for (std::size_t i = 0; i < headPointers.size(); i++)
     {
         deallocate(headPointers[i]);
     }
@@ -201,28 +345,96 @@ SkipListSet<T>::~SkipListSet()
 
 template <typename T>
 SkipListSet<T>::SkipListSet(const SkipListSet& s)
+    : engine{s.engine}
 {
-    // copy constructor
-    this->headPointers = s.headPointers;
+    // copy the levels from the bottom up, so that each copied node can
+    // point below to the copy of the node it pointed to.  Every level is a
+    // subsequence of the one below it, so walking the two levels side by
+    // side finds each of those copies in linear time.
+    headPointers.resize(s.headPointers.size());
+    Node* lowerOriginal = NULL;
+    Node* lowerCopy = NULL;
+    for (int i = s.headPointers.size() - 1; i >= 0; i--)
+    {
+        Node* original = lowerOriginal;
+        Node* copy = lowerCopy;
+        Node* prev = NULL;
+        for (Node* n = s.headPointers[i]; n != NULL; n = n->folow)
+        {
+            Node* newNode = new Node{n->kind, n->key, NULL, NULL};
+            if (n->below != NULL)
+            {
+                while (original != n->below)
+                {
+                    original = original->folow;
+                    copy = copy->folow;
+                }
+                newNode->below = copy;
+            }
+            if (prev == NULL)
+            {
+                headPointers[i] = newNode;
+            }
+            else
+            {
+                prev->folow = newNode;
+            }
+            prev = newNode;
+        }
+        lowerOriginal = s.headPointers[i];
+        lowerCopy = headPointers[i];
+    }
     this->height = s.height;
     this->numberOfElements = s.numberOfElements;
+    this->replacements = 0;
+}
+
+
+template <typename T>
+SkipListSet<T>::SkipListSet(SkipListSet&& s)
+    : SkipListSet{}
+{
+    // start out empty, then trade places with s
+    swap(s);
 }
 
 
 template <typename T>
 SkipListSet<T>& SkipListSet<T>::operator=(const SkipListSet& s)
 {
-    // copy assignment
+    // copy s on the side, then trade places with the copy, whose
+    // destructor cleans up the old levels
     if (this != &s)
     {
-        this->headPointers = s.headPointers;
-        this->height = s.height;
-        this->numberOfElements = s.numberOfElements;
+        SkipListSet copy{s};
+        swap(copy);
     }
     return *this;
 }
 
 
+template <typename T>
+SkipListSet<T>& SkipListSet<T>::operator=(SkipListSet&& s)
+{
+    // the old levels end up in s, which will clean them up
+    swap(s);
+    return *this;
+}
+
+
+template <typename T>
+void SkipListSet<T>::swap(SkipListSet& s) noexcept
+{
+    headPointers.swap(s.headPointers);
+    std::swap(height, s.height);
+    std::swap(numberOfElements, s.numberOfElements);
+    std::swap(engine, s.engine);
+    // both sets now have different nodes than their Fingers knew about
+    replacements++;
+    s.replacements++;
+}
+
+
 template <typename T>
 bool SkipListSet<T>::isImplemented() const
 {
@@ -234,140 +446,59 @@ bool SkipListSet<T>::isImplemented() const
 template <typename T>
 void SkipListSet<T>::add(const T& element)
 {
-    // check if the element is existed in the skip list or not
-    if(!contains(element))
+    // find the last node before element on every level, from the top
+    // down; previous[0] is on the bottom level and previous[height] on the
+    // empty top one
+    Node* previous[MAX_HEIGHT + 1];
+    Node* search = headPointers.front();
+    for (int i = height; i >= 0; i--)
     {
-        numberOfElements++;
-        // add the first element to the skip list
-        if (height == 0)
+        while (search->folow->kind == SkipListKind::Normal && search->folow->key < element)
         {
-            Node* head = new Node;
-            head->kind = headPointers[0]->kind;
-            head->key = headPointers[0]->key;
-            Node* tail = new Node;
-            tail->kind = headPointers[0]->folow->kind;
-            tail->key = headPointers[0]->folow->key;
-            headPointers[0]->below = head;
-            headPointers[0]->folow->below = tail;
-            Node* newAddedNode = new Node;
-            newAddedNode->key = element;
-            newAddedNode->folow = head->folow;
-            head->folow = newAddedNode;
-            height++;
-            headPointers.push_back(head);
-            // call the coinFlip() function to see if the element is needed to promote
-            while (coinFlip())
-            {
-                Node* newHead = new Node;
-                Node* newMiddle = new Node;
-                Node* newTail = new Node;
-                newHead->kind = headPointers[height]->kind;
-                newHead->key = headPointers[height]->key;
-                newHead->folow = newMiddle;
-                newHead->below = NULL;
-                newMiddle->kind = headPointers[height]->folow->kind;
-                newMiddle->key = headPointers[height]->folow->key;
-                newMiddle->folow = newTail;
-                newMiddle->below = NULL;
-                newTail->kind = headPointers[height]->folow->folow->kind;
-                newTail->key = headPointers[height]->folow->folow->key;
-                newTail->folow = NULL;
-                newTail->below = NULL;
-                headPointers[height]->below = newHead;
-                headPointers[height]->folow->below = newMiddle;
-                headPointers[height]->folow->folow->below = newTail;
-                height++;
-                headPointers.push_back(newHead);
-            }
+            search = search->folow;
         }
-        else
+        previous[i] = search;
+        if (search->below != NULL)
         {
-            int tempHeight = 1;
-            int currentHeight = 0;
-            int position = 0;
-            Node* head = headPointers.front();
-            bool checkingLevel = true;
-            // compare strings and nevigate to cooresponging position
-            while (checkingLevel)
-            {
-                if (head->below == NULL)
-                {
-                    checkingLevel = false;
-                }
-                else
-                {
-                    head = head->below;
-                    currentHeight++;
-                    bool checkingNode = true;
-                    while (checkingNode)
-                    {
-                        // check if the next one is tail
-                        if (head->folow->kind == SkipListKind::PosInf)
-                        {
-                            checkingNode = false;
-                        }
-                        // check if the next one is behind the element
-                        else if (head->folow->key.compare(element) > 0)
-                        {
-                            while (currentHeight != height)
-                            {
-                                head = head->below;
-                                currentHeight++;
-                            }
-                            Node* newAddedNode = new Node;
-                            newAddedNode->kind = SkipListKind::Normal;
-                            newAddedNode->key = element;
-                            newAddedNode->folow = head->folow;
-                            head->folow = newAddedNode;
-                            // same thing as above, but will reorder the vector if the number of same key is over the height and add a level
-                           /* while (coinFlip())
-                            {
-                                Node* thirdTop = headPointers[1];
-                                Node* temp = headPointers[height-tempHeight+1];
-                                Node* newHead = headPointers[height-tempHeight];
-                                for (int i = 0; i < position; i++)
-                                {
-                                    newHead = newHead->folow;
-                                    temp = temp->folow;
-                                    thirdTop = thirdTop->folow;
-                                }
-                                Node* tempLower = temp->folow;
-                                tempLower->folow = newHead->folow;
-                                tempLower->below = temp->folow;
-                                newHead->folow = tempLower;
-                                if (tempHeight > height)
-                                {
-                                    Node* secondTop = headPointers[0];
-                                    Node* tempNew = newAddedNode;
-                                    tempNew->folow = secondTop->folow;
-                                    tempNew->below = thirdTop->folow;
-                                    secondTop->folow = tempNew;
-                                    std::vector<Node*> tempVec;
-                                    for (int i = 0; i < headPointers.size(); i++)
-                                    {
-                                        if (i == 1)
-                                        {
-                                            tempVec.push_back(secondTop);
-                                        }
-                                        tempVec.push_back(headPointers[i]);
-                                    }
-                                    headPointers = tempVec;
-                                }
-                                tempHeight++;
-                            }*/
-                            checkingNode = false;
-                            checkingLevel = false;
-                        }
-                        else
-                        {
-                            head = head->folow;
-                            position++;
-                        }
-                    }
-                }
-            }
+            search = search->below;
         }
     }
+
+    // check if the element is existed in the skip list or not
+    Node* next = previous[0]->folow;
+    if (next->kind == SkipListKind::Normal && next->key == element)
+    {
+        return;
+    }
+
+    // call the coinFlip() function to see how many levels the element is
+    // promoted to, adding levels to the top so the top level stays empty
+    int levels = 1;
+    while (levels < MAX_HEIGHT && coinFlip())
+    {
+        levels++;
+    }
+    while (levels > height)
+    {
+        Node* head = newLevel(headPointers.front());
+        headPointers.insert(headPointers.begin(), head);
+        height++;
+        previous[height] = head;
+    }
+
+    // link a node into each level, from the bottom up
+    Node* newBelow = NULL;
+    for (int i = 0; i < levels; i++)
+    {
+        Node* newAddedNode = new Node;
+        newAddedNode->kind = SkipListKind::Normal;
+        newAddedNode->key = element;
+        newAddedNode->folow = previous[i]->folow;
+        newAddedNode->below = newBelow;
+        previous[i]->folow = newAddedNode;
+        newBelow = newAddedNode;
+    }
+    numberOfElements++;
 }
 
 
@@ -375,56 +506,233 @@ void SkipListSet<T>::add(const T& element)
 template <typename T>
 bool SkipListSet<T>::coinFlip()
 {
-    std::random_device device;
-    std::default_random_engine engine{device()};
     std::uniform_int_distribution<int> distribution{0, 1};
     return distribution(engine);
 }
 
 
+template <typename T>
+typename SkipListSet<T>::Node* SkipListSet<T>::newLevel(Node* below)
+{
+    // creating head and tail node for the level
+    Node* head = new Node;
+    Node* tail = new Node;
+    // assign SkipListKind to head and tail nodes
+    head->kind = SkipListKind::NegInf;
+    tail->kind = SkipListKind::PosInf;
+    // connect tail to head, and both to the level below
+    head->folow = tail;
+    tail->folow = NULL;
+    head->below = below;
+    tail->below = NULL;
+    if (below != NULL)
+    {
+        Node* belowTail = below;
+        while (belowTail->folow != NULL)
+        {
+            belowTail = belowTail->folow;
+        }
+        tail->below = belowTail;
+    }
+    return head;
+}
+
+
 template <typename T>
 bool SkipListSet<T>::contains(const T& element) const
 {
-    bool isContained = false;
-    /*bool checkingLevel = true;
     Node* search = headPointers.front();
-    while (checkingLevel)
+    while (true)
     {
+        // move right as long as the next key is smaller than the element
+        while (search->folow->kind == SkipListKind::Normal && search->folow->key < element)
+        {
+            search = search->folow;
+        }
+        // if find matched element, return true
+        if (search->folow->kind == SkipListKind::Normal && search->folow->key == element)
+        {
+            return true;
+        }
+        // otherwise drop down a level, unless this is the bottom one
         if (search->below == NULL)
         {
-            checkingLevel = false;
+            return false;
         }
-        else
+        search = search->below;
+    }
+}
+
+
+template <typename T>
+void SkipListSet<T>::containsMany(const T* elements, unsigned int count, bool* results) const
+{
+    Node* cursors[PREFETCH_GROUP_SIZE];
+    for (unsigned int first = 0; first < count; first += PREFETCH_GROUP_SIZE)
+    {
+        unsigned int groupSize = std::min(PREFETCH_GROUP_SIZE, count - first);
+        for (unsigned int j = 0; j < groupSize; j++)
         {
-            search = search->below;
-            bool checkingNode = true;
-            while (checkingNode)
+            cursors[j] = headPointers.front();
+        }
+
+        // take one step (right or down) for every lookup still going
+        unsigned int active = groupSize;
+        while (active > 0)
+        {
+            for (unsigned int j = 0; j < groupSize; j++)
             {
-                // check if next node is tail
-                if (search->folow->kind == SkipListKind::PosInf)
+                Node* search = cursors[j];
+                if (search == NULL)
+                {
+                    continue;
+                }
+                const T& element = elements[first + j];
+                Node* next = search->folow;
+                if (next->kind == SkipListKind::Normal && next->key < element)
                 {
-                    checkingNode = false;
+                    search = next;
+                    prefetch(search->folow);
                 }
-                // check if next node is greater than the element
-                else if (search->folow->key.compare(element) > 0)
+                else if (next->kind == SkipListKind::Normal && next->key == element)
                 {
-                    checkingNode = false;
+                    results[first + j] = true;
+                    search = NULL;
+                }
+                else if (search->below == NULL)
+                {
+                    results[first + j] = false;
+                    search = NULL;
                 }
                 else
                 {
-                    search = search->folow;
-                    // if find matched element, return true
-                    if (search->key == element)
-                    {
-                        checkingNode = false;
-                        checkingLevel = false;
-                        isContained = true;
-                    }
+                    search = search->below;
+                    prefetch(search->folow);
+                }
+                if (search == NULL)
+                {
+                    active--;
                 }
+                cursors[j] = search;
             }
         }
-    }*/
-    return isContained;
+    }
+}
+
+
+template <typename T>
+void SkipListSet<T>::containsSorted(const T* elements, unsigned int count, bool* results) const
+{
+    Finger finger{*this};
+    for (unsigned int i = 0; i < count; i++)
+    {
+        results[i] = finger.contains(elements[i]);
+    }
+}
+
+
+template <typename T>
+template <typename Callback>
+unsigned int SkipListSet<T>::forEachWithPrefix(
+    const T& prefix, unsigned int limit, Callback callback) const
+{
+    // find the last node on the bottom level whose key is less than prefix
+    Node* search = headPointers.front();
+    while (true)
+    {
+        while (search->folow->kind == SkipListKind::Normal && search->folow->key < prefix)
+        {
+            search = search->folow;
+        }
+        if (search->below == NULL)
+        {
+            break;
+        }
+        search = search->below;
+    }
+
+    // the keys that begin with prefix follow it in a row
+    unsigned int count = 0;
+    for (Node* n = search->folow;
+         count < limit && n->kind == SkipListKind::Normal
+             && n->key.compare(0, prefix.size(), prefix) == 0;
+         n = n->folow)
+    {
+        callback(n->key);
+        count++;
+    }
+    return count;
+}
+
+
+template <typename T>
+template <typename ForwardIt>
+void SkipListSet<T>::buildFromSorted(ForwardIt begin, ForwardIt end)
+{
+    // check the order before touching the set
+    if (countDistinctSorted(begin, end) == 0)
+    {
+        SkipListSet empty;
+        empty.engine = engine;
+        swap(empty);
+        return;
+    }
+
+    // build the levels from the bottom up in a set on the side, whose
+    // destructor cleans them up if anything goes wrong; last holds the
+    // last node on each level, with the bottom level first
+    SkipListSet built;
+    built.deallocate(built.headPointers.front());
+    built.headPointers.clear();
+    std::vector<Node*> last;
+    unsigned int count = 0;
+    for (ForwardIt i = begin; i != end; i = nextDistinct(i, end))
+    {
+        count++;
+        unsigned int levels = 1;
+        for (unsigned int c = count; c % 2 == 0; c /= 2)
+        {
+            levels++;
+        }
+        while (last.size() < levels + 1)
+        {
+            // the new level's head sits on top of the one below, and
+            // there's always an empty level above the highest element
+            Node* below = built.headPointers.empty() ? NULL : built.headPointers.front();
+            Node* head = new Node{SkipListKind::NegInf, T{}, NULL, below};
+            built.headPointers.insert(built.headPointers.begin(), head);
+            last.push_back(head);
+        }
+        Node* below = NULL;
+        for (unsigned int level = 0; level < levels; level++)
+        {
+            Node* n = new Node{SkipListKind::Normal, *i, NULL, below};
+            last[level]->folow = n;
+            last[level] = n;
+            below = n;
+        }
+    }
+
+    // end every level with a tail, on top of the tail of the one below
+    Node* belowTail = NULL;
+    for (unsigned int level = 0; level < last.size(); level++)
+    {
+        Node* tail = new Node{SkipListKind::PosInf, T{}, NULL, belowTail};
+        last[level]->folow = tail;
+        belowTail = tail;
+    }
+    built.height = last.size() - 1;
+    built.numberOfElements = count;
+    built.engine = engine;
+    swap(built);
+}
+
+
+template <typename T>
+template <typename OutputIt>
+OutputIt SkipListSet<T>::dumpSorted(OutputIt out) const
+{
+    return std::copy(begin(), end(), out);
 }
 
 
@@ -436,20 +744,153 @@ unsigned int SkipListSet<T>::size() const
 }
 
 
-//helper function for destructor
+//helper function for destructor; deletes every node on one level
 template <typename T>
 void SkipListSet<T>::deallocate(Node* n)
 {
-    if (n != NULL)
+    while (n != NULL)
     {
-        deallocate(n->folow);
-        delete n->below;
-        delete n->folow;
+        Node* next = n->folow;
         delete n;
+        n = next;
     }
 }
 
 
+template <typename T>
+SkipListSet<T>::Finger::Finger(const SkipListSet& set)
+    : set{&set}
+{
+    reset();
+}
 
-#endif // SKIPLISTSET_HPP
 
+template <typename T>
+bool SkipListSet<T>::Finger::contains(const T& element)
+{
+    // the path is only a head start for elements after the last node on
+    // the bottom of it, and it's missing any levels added since it was made
+    Node* last = path.back();
+    if (knownReplacements != set->replacements
+        || path.size() != set->headPointers.size()
+        || (last->kind == SkipListKind::Normal && !(last->key < element)))
+    {
+        reset();
+    }
+
+    // climb from the bottom for as long as the node after the path on the
+    // level above is still before the element
+    int level = path.size() - 1;
+    while (level > 0
+        && path[level - 1]->folow->kind == SkipListKind::Normal
+        && path[level - 1]->folow->key < element)
+    {
+        level--;
+    }
+
+    // then search down from there as contains() would, updating the path
+    Node* search = path[level];
+    while (true)
+    {
+        while (search->folow->kind == SkipListKind::Normal && search->folow->key < element)
+        {
+            search = search->folow;
+        }
+        path[level] = search;
+        if (search->below == NULL)
+        {
+            break;
+        }
+        search = search->below;
+        level++;
+    }
+    Node* next = search->folow;
+    return next->kind == SkipListKind::Normal && next->key == element;
+}
+
+
+template <typename T>
+void SkipListSet<T>::Finger::reset()
+{
+    // the heads of the levels come before every element
+    path = set->headPointers;
+    knownReplacements = set->replacements;
+}
+
+
+// swap() lets SkipListSets be exchanged with an unqualified call to swap()
+template <typename T>
+void swap(SkipListSet<T>& a, SkipListSet<T>& b) noexcept
+{
+    a.swap(b);
+}
+
+
+template <typename T>
+typename SkipListSet<T>::Iterator SkipListSet<T>::begin() const
+{
+    return Iterator{headPointers.back()->folow};
+}
+
+
+template <typename T>
+typename SkipListSet<T>::Iterator SkipListSet<T>::end() const
+{
+    return Iterator{NULL};
+}
+
+
+template <typename T>
+SkipListSet<T>::Iterator::Iterator(Node* node)
+    : node{(node != NULL && node->kind == SkipListKind::PosInf) ? NULL : node}
+{
+}
+
+
+template <typename T>
+const T& SkipListSet<T>::Iterator::operator*() const
+{
+    return node->key;
+}
+
+
+template <typename T>
+const T* SkipListSet<T>::Iterator::operator->() const
+{
+    return &node->key;
+}
+
+
+template <typename T>
+typename SkipListSet<T>::Iterator& SkipListSet<T>::Iterator::operator++()
+{
+    node = (node->folow->kind == SkipListKind::PosInf) ? NULL : node->folow;
+    return *this;
+}
+
+
+template <typename T>
+typename SkipListSet<T>::Iterator SkipListSet<T>::Iterator::operator++(int)
+{
+    Iterator old = *this;
+    ++*this;
+    return old;
+}
+
+
+template <typename T>
+bool SkipListSet<T>::Iterator::operator==(const Iterator& other) const
+{
+    return node == other.node;
+}
+
+
+template <typename T>
+bool SkipListSet<T>::Iterator::operator!=(const Iterator& other) const
+{
+    return node != other.node;
+}
+
+
+
+#endif // SKIPLISTSET_HPP
@@ -0,0 +1,64 @@
+// SortedRange.hpp
+//
+// ICS 46 Spring 2015
+// Project #3: Set the Controls for the Heart of the Sun
+//
+// A couple of small utilities for walking a range that's already in
+// ascending order, such as a sorted dictionary file, shared by the sets
+// that know how to build themselves from one in linear time.  Repeated
+// elements are allowed and are treated as one.
+
+#ifndef SORTEDRANGE_HPP
+#define SORTEDRANGE_HPP
+
+#include <iterator>
+#include <stdexcept>
+
+
+
+// countDistinctSorted() returns the number of distinct elements in the
+// range [begin, end), in one pass over it.  It throws an
+// std::invalid_argument if the range isn't in ascending order.
+template <typename ForwardIt>
+unsigned int countDistinctSorted(ForwardIt begin, ForwardIt end)
+{
+    if (begin == end)
+    {
+        return 0;
+    }
+
+    unsigned int count = 1;
+    ForwardIt previous = begin;
+    for (ForwardIt i = std::next(begin); i != end; ++i)
+    {
+        if (*previous < *i)
+        {
+            count++;
+        }
+        else if (*i < *previous)
+        {
+            throw std::invalid_argument{"the range is not in ascending order"};
+        }
+        previous = i;
+    }
+    return count;
+}
+
+
+// nextDistinct() returns an iterator to the first element after i, in a
+// range in ascending order, that isn't equal to the element at i (or end,
+// if there's none).
+template <typename ForwardIt>
+ForwardIt nextDistinct(ForwardIt i, ForwardIt end)
+{
+    ForwardIt next = std::next(i);
+    while (next != end && !(*i < *next))
+    {
+        ++next;
+    }
+    return next;
+}
+
+
+
+#endif // SORTEDRANGE_HPP
@@ -0,0 +1,76 @@
+// SuggestionBuffer.cpp
+//
+// ICS 46 Spring 2015
+// Project #3: Set the Controls for the Heart of the Sun
+
+#include "SuggestionBuffer.hpp"
+
+
+
+SuggestionBuffer::SuggestionBuffer()
+    : count{0}, foundCapacity{0}
+{
+}
+
+
+unsigned int SuggestionBuffer::size() const
+{
+    return count;
+}
+
+
+bool SuggestionBuffer::empty() const
+{
+    return count == 0;
+}
+
+
+const std::string& SuggestionBuffer::operator[](unsigned int index) const
+{
+    return suggestions[index];
+}
+
+
+const std::string* SuggestionBuffer::begin() const
+{
+    return suggestions.data();
+}
+
+
+const std::string* SuggestionBuffer::end() const
+{
+    return suggestions.data() + count;
+}
+
+
+void SuggestionBuffer::clear()
+{
+    count = 0;
+}
+
+
+std::vector<std::string> SuggestionBuffer::toVector() const
+{
+    return std::vector<std::string>(begin(), end());
+}
+
+
+std::string& SuggestionBuffer::append()
+{
+    if (count == suggestions.size())
+    {
+        suggestions.emplace_back();
+    }
+    return suggestions[count++];
+}
+
+
+bool* SuggestionBuffer::reserveFound(unsigned int n)
+{
+    if (n > foundCapacity)
+    {
+        found.reset(new bool[n]);
+        foundCapacity = n;
+    }
+    return found.get();
+}
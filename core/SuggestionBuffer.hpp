@@ -0,0 +1,87 @@
+// SuggestionBuffer.hpp
+//
+// ICS 46 Spring 2015
+// Project #3: Set the Controls for the Heart of the Sun
+//
+// A SuggestionBuffer holds the suggestions that findSuggestions() finds
+// for one word, along with the scratch space it needs to find them.  It
+// is meant to be reused: clearing it, or passing it to findSuggestions()
+// again, keeps every string and array it has allocated so far, so once
+// it has grown large enough for the words being checked, finding
+// suggestions into it allocates no memory at all.
+
+#ifndef SUGGESTIONBUFFER_HPP
+#define SUGGESTIONBUFFER_HPP
+
+#include <memory>
+#include <string>
+#include <vector>
+#include "WordKey.hpp"
+
+
+template <typename SetType, typename AlphabetType, typename TimerType>
+class BasicWordChecker;
+
+
+
+class SuggestionBuffer
+{
+public:
+    // Initializes a SuggestionBuffer with no suggestions in it.
+    SuggestionBuffer();
+
+    // size() returns the number of suggestions in the buffer.
+    unsigned int size() const;
+
+    // empty() returns true if there are no suggestions in the buffer.
+    bool empty() const;
+
+    // operator[] returns one of the suggestions; index must be less than
+    // size().  The reference is good until the buffer is next changed.
+    const std::string& operator[](unsigned int index) const;
+
+    // begin() and end() allow the suggestions to be iterated over, in the
+    // order they were found.
+    const std::string* begin() const;
+    const std::string* end() const;
+
+    // clear() removes every suggestion, keeping the memory they used.
+    void clear();
+
+    // toVector() returns a copy of the suggestions.
+    std::vector<std::string> toVector() const;
+
+private:
+    template <typename SetType, typename AlphabetType, typename TimerType>
+    friend class BasicWordChecker;
+
+    // the suggestions are the first count strings; the ones after them are
+    // left over from earlier words, kept for their memory
+    std::vector<std::string> suggestions;
+    unsigned int count;
+
+    // scratch space for the candidates a strategy generates and for
+    // whether each one was found
+    std::vector<std::string> candidates;
+    std::unique_ptr<bool[]> found;
+    unsigned int foundCapacity;
+
+    // the candidates instead, when they're made directly as WordKeys
+    std::vector<WordKey> keys;
+
+    // where each character of a UTF-8 word begins, when it's edited a
+    // character at a time
+    std::vector<unsigned int> characterStarts;
+
+    // returns the string that will hold the next suggestion, which is
+    // counted as one of the suggestions from now on
+    std::string& append();
+
+    // returns an array of at least n bools, reallocating it only if it's
+    // smaller than that
+    bool* reserveFound(unsigned int n);
+};
+
+
+
+#endif // SUGGESTIONBUFFER_HPP
@@ -0,0 +1,191 @@
+// SuggestionTable.cpp
+//
+// ICS 46 Spring 2015
+// Project #3: Set the Controls for the Heart of the Sun
+
+#include "SuggestionTable.hpp"
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "HashPolicy.hpp"
+
+
+namespace
+{
+    const std::uint64_t MAGIC = 0x31424154474753ull;
+
+    const unsigned int MAX_LENGTH = 0xffff;
+
+
+    void appendLength(std::vector<char>& out, unsigned int length)
+    {
+        std::uint16_t value = length;
+        const char* bytes = reinterpret_cast<const char*>(&value);
+        out.insert(out.end(), bytes, bytes + sizeof(value));
+    }
+
+
+    void appendString(std::vector<char>& out, const std::string& s)
+    {
+        appendLength(out, s.size());
+        out.insert(out.end(), s.begin(), s.end());
+    }
+}
+
+
+
+SuggestionTable::SuggestionTable(const std::string& path)
+    : mapping{NULL}, mappingSize{0}
+{
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+        throw std::runtime_error{"SuggestionTable: can't open " + path};
+    }
+    struct stat status;
+    if (::fstat(fd, &status) != 0 || status.st_size < static_cast<off_t>(sizeof(Header)))
+    {
+        ::close(fd);
+        throw std::runtime_error{"SuggestionTable: " + path + " is too short to be a table"};
+    }
+    mappingSize = status.st_size;
+    mapping = ::mmap(NULL, mappingSize, PROT_READ, MAP_SHARED, fd, 0);
+    // the mapping keeps the file open, so the descriptor isn't needed
+    ::close(fd);
+    if (mapping == MAP_FAILED)
+    {
+        throw std::runtime_error{"SuggestionTable: can't map " + path};
+    }
+
+    const char* base = static_cast<const char*>(mapping);
+    header = reinterpret_cast<const Header*>(base);
+    std::size_t slotBytes = static_cast<std::size_t>(header->slotCount) * sizeof(Slot);
+    if (header->magic != MAGIC
+        || header->slotCount == 0
+        || (header->slotCount & (header->slotCount - 1)) != 0
+        || mappingSize != sizeof(Header) + slotBytes + header->recordBytes)
+    {
+        ::munmap(mapping, mappingSize);
+        throw std::runtime_error{"SuggestionTable: " + path + " isn't a suggestion table"};
+    }
+    slots = reinterpret_cast<const Slot*>(base + sizeof(Header));
+    records = base + sizeof(Header) + slotBytes;
+}
+
+
+SuggestionTable::~SuggestionTable()
+{
+    ::munmap(mapping, mappingSize);
+}
+
+
+void SuggestionTable::write(
+    std::ostream& out, const std::vector<std::string>& misspellings,
+    const std::vector<std::vector<std::string>>& suggestions)
+{
+    unsigned int slotCount = 2;
+    while (slotCount < 2 * misspellings.size())
+    {
+        slotCount *= 2;
+    }
+    std::vector<Slot> table(slotCount, Slot{0, EMPTY_SLOT});
+    std::vector<char> recordBytes;
+    unsigned int entryCount = 0;
+
+    for (unsigned int i = 0; i < misspellings.size(); i++)
+    {
+        const std::string& word = misspellings[i];
+        if (word.size() > MAX_LENGTH)
+        {
+            continue;
+        }
+
+        // find the word's slot, skipping it if it's already been written
+        std::uint64_t h = hash(word.data(), word.size());
+        std::uint32_t fingerprint = h >> 32;
+        unsigned int slot = h & (slotCount - 1);
+        bool duplicate = false;
+        while (table[slot].record != EMPTY_SLOT && !duplicate)
+        {
+            const char* record = recordBytes.data() + table[slot].record;
+            duplicate = table[slot].fingerprint == fingerprint
+                && readLength(record) == word.size()
+                && std::memcmp(record + 2, word.data(), word.size()) == 0;
+            slot = (slot + 1) & (slotCount - 1);
+        }
+        if (duplicate)
+        {
+            continue;
+        }
+
+        table[slot] = Slot{fingerprint, static_cast<std::uint32_t>(recordBytes.size())};
+        entryCount++;
+        appendString(recordBytes, word);
+        unsigned int count = 0;
+        for (const std::string& suggestion : suggestions[i])
+        {
+            if (suggestion.size() <= MAX_LENGTH && count < MAX_LENGTH)
+            {
+                count++;
+            }
+        }
+        appendLength(recordBytes, count);
+        count = 0;
+        for (const std::string& suggestion : suggestions[i])
+        {
+            if (suggestion.size() <= MAX_LENGTH && count < MAX_LENGTH)
+            {
+                appendString(recordBytes, suggestion);
+                count++;
+            }
+        }
+    }
+
+    Header header{MAGIC, entryCount, slotCount, static_cast<std::uint64_t>(recordBytes.size())};
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(table.data()), table.size() * sizeof(Slot));
+    out.write(recordBytes.data(), recordBytes.size());
+}
+
+
+unsigned int SuggestionTable::size() const
+{
+    return header->entryCount;
+}
+
+
+std::uint64_t SuggestionTable::hash(const char* word, std::size_t length)
+{
+    return wyhash(word, length);
+}
+
+
+unsigned int SuggestionTable::readLength(const char* p)
+{
+    std::uint16_t value;
+    std::memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+
+const char* SuggestionTable::find(const std::string& word) const
+{
+    std::uint64_t h = hash(word.data(), word.size());
+    std::uint32_t fingerprint = h >> 32;
+    unsigned int mask = header->slotCount - 1;
+    for (unsigned int slot = h & mask; slots[slot].record != EMPTY_SLOT; slot = (slot + 1) & mask)
+    {
+        if (slots[slot].fingerprint == fingerprint)
+        {
+            const char* record = records + slots[slot].record;
+            if (readLength(record) == word.size()
+                && std::memcmp(record + 2, word.data(), word.size()) == 0)
+            {
+                return record;
+            }
+        }
+    }
+    return NULL;
+}
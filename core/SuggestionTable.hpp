@@ -0,0 +1,140 @@
+// SuggestionTable.hpp
+//
+// ICS 46 Spring 2015
+// Project #3: Set the Controls for the Heart of the Sun
+//
+// A SuggestionTable holds precomputed suggestions for a fixed list of
+// misspellings, such as the ones most often seen in query logs, so that
+// a BasicWordChecker can answer those without generating any candidates.
+//
+// A table is built offline and written to a file with write(), and is
+// used straight from that file: the constructor maps the file into
+// memory with mmap() rather than reading it, so opening even a large
+// table is quick, its pages are only read from disk as they're used, and
+// processes that open the same file share one copy of it.
+//
+// The file is laid out for lookups in place.  After a short header comes
+// an open-addressed hash table of slots, at most half full, each holding
+// 32 bits of a misspelling's hash along with where its record starts;
+// after that come the records, each a misspelling followed by its
+// suggestions.  Looking up a misspelling hashes it, usually reads one
+// slot, and then reads one record.  Numbers are stored in the byte order
+// of the machine that wrote the file.  Only the header is checked when a
+// file is opened, so only files written by write() should be opened.
+
+#ifndef SUGGESTIONTABLE_HPP
+#define SUGGESTIONTABLE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <ostream>
+#include <string>
+#include <vector>
+
+
+
+class SuggestionTable
+{
+public:
+    // Maps the table in the given file into memory.  Throws a
+    // std::runtime_error if the file can't be mapped or doesn't contain a
+    // table.
+    explicit SuggestionTable(const std::string& path);
+
+    // Unmaps the table.
+    ~SuggestionTable();
+
+    // A SuggestionTable can't be copied or assigned, since it owns its
+    // mapping.
+    SuggestionTable(const SuggestionTable& t) = delete;
+    SuggestionTable& operator=(const SuggestionTable& t) = delete;
+
+
+    // write() writes a table of the given misspellings to a stream, where
+    // suggestions[i] are the suggestions for misspellings[i].  If a
+    // misspelling appears more than once, its first suggestions are kept.
+    // Misspellings and suggestions longer than 65,535 characters, and
+    // suggestions past the first 65,535 for a misspelling, are left out.
+    static void write(
+        std::ostream& out, const std::vector<std::string>& misspellings,
+        const std::vector<std::vector<std::string>>& suggestions);
+
+
+    // size() returns the number of misspellings in the table.
+    unsigned int size() const;
+
+
+    // forEachSuggestion() calls callback(characters, length) for each of
+    // the suggestions for word, in order, and returns how many there are,
+    // if word is one of the misspellings in the table.  If it isn't, it
+    // returns -1 without calling callback.  The characters are good as
+    // long as the table is.
+    template <typename Callback>
+    int forEachSuggestion(const std::string& word, Callback callback) const;
+
+
+private:
+    // a slot of the hash table; an empty one has EMPTY_SLOT as its record
+    struct Slot
+    {
+        std::uint32_t fingerprint;
+        std::uint32_t record;
+    };
+
+    static constexpr std::uint32_t EMPTY_SLOT = 0xffffffffu;
+
+    struct Header
+    {
+        std::uint64_t magic;
+        std::uint32_t entryCount;
+        std::uint32_t slotCount;
+        std::uint64_t recordBytes;
+    };
+
+    // the whole mapped file
+    void* mapping;
+    std::size_t mappingSize;
+
+    // the parts of it
+    const Header* header;
+    const Slot* slots;
+    const char* records;
+
+    // hashes a misspelling
+    static std::uint64_t hash(const char* word, std::size_t length);
+
+    // reads a 16-bit length from a record
+    static unsigned int readLength(const char* p);
+
+    // returns the record of word, or NULL if word isn't in the table
+    const char* find(const std::string& word) const;
+};
+
+
+
+template <typename Callback>
+int SuggestionTable::forEachSuggestion(const std::string& word, Callback callback) const
+{
+    const char* p = find(word);
+    if (p == NULL)
+    {
+        return -1;
+    }
+
+    // skip over the misspelling itself to its suggestions
+    p += 2 + readLength(p);
+    unsigned int count = readLength(p);
+    p += 2;
+    for (unsigned int i = 0; i < count; i++)
+    {
+        unsigned int length = readLength(p);
+        callback(p + 2, static_cast<std::size_t>(length));
+        p += 2 + length;
+    }
+    return count;
+}
+
+
+
+#endif // SUGGESTIONTABLE_HPP
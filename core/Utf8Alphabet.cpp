@@ -0,0 +1,267 @@
+// Utf8Alphabet.cpp
+//
+// ICS 46 Spring 2015
+// Project #3: Set the Controls for the Heart of the Sun
+
+#include "Utf8Alphabet.hpp"
+#include <algorithm>
+#include "HashPolicy.hpp"
+
+
+namespace
+{
+    // returns true if byte is a UTF-8 continuation byte, 10xxxxxx
+    inline bool isContinuation(unsigned char byte)
+    {
+        return (byte & 0xC0) == 0x80;
+    }
+
+
+    // returns the code point of the well-formed character of the given
+    // length at p
+    std::uint32_t decode(const unsigned char* p, unsigned int length)
+    {
+        switch (length)
+        {
+        case 1:
+            return p[0];
+        case 2:
+            return ((p[0] & 0x1F) << 6) | (p[1] & 0x3F);
+        case 3:
+            return ((p[0] & 0x0F) << 12) | ((p[1] & 0x3F) << 6) | (p[2] & 0x3F);
+        default:
+            return ((p[0] & 0x07) << 18) | ((p[1] & 0x3F) << 12)
+                | ((p[2] & 0x3F) << 6) | (p[3] & 0x3F);
+        }
+    }
+
+
+    // appends the UTF-8 bytes of a code point to out; the values past
+    // U+10FFFF that stand for malformed bytes are appended as those bytes
+    void encode(std::uint32_t codePoint, std::vector<char>& out)
+    {
+        if (codePoint >= 0x110000)
+        {
+            out.push_back(static_cast<char>(codePoint - 0x110000));
+        }
+        else if (codePoint < 0x800)
+        {
+            out.push_back(static_cast<char>(0xC0 | (codePoint >> 6)));
+            out.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+        }
+        else if (codePoint < 0x10000)
+        {
+            out.push_back(static_cast<char>(0xE0 | (codePoint >> 12)));
+            out.push_back(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F)));
+            out.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+        }
+        else
+        {
+            out.push_back(static_cast<char>(0xF0 | (codePoint >> 18)));
+            out.push_back(static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F)));
+            out.push_back(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F)));
+            out.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+        }
+    }
+}
+
+
+
+Utf8Alphabet::Utf8Alphabet(const std::vector<std::string>& words)
+{
+    std::vector<std::string> nonAscii;
+    for (const std::string& word : words)
+    {
+        if (!isAscii(word.data(), word.size()))
+        {
+            nonAscii.push_back(word);
+        }
+    }
+    std::sort(nonAscii.begin(), nonAscii.end());
+    nonAscii.erase(std::unique(nonAscii.begin(), nonAscii.end()), nonAscii.end());
+
+    // each occurrence of a non-ASCII character, with its code point or,
+    // for a malformed byte, 0x110000 plus the byte, so that it sorts after
+    // every real code point
+    std::vector<Occurrence> found;
+    std::vector<std::uint32_t> foundCodePoints;
+    wordOffsets.push_back(0);
+    for (unsigned int w = 0; w < nonAscii.size(); w++)
+    {
+        const std::string& word = nonAscii[w];
+        std::size_t position = 0;
+        while (position < word.size())
+        {
+            unsigned int length = characterLength(word.data() + position, word.size() - position);
+            const unsigned char* bytes = reinterpret_cast<const unsigned char*>(word.data() + position);
+            if (bytes[0] >= 0x80)
+            {
+                found.push_back(Occurrence{w, static_cast<unsigned int>(position), 0});
+                foundCodePoints.push_back(length == 1 ? 0x110000 + bytes[0] : decode(bytes, length));
+            }
+            position += length;
+        }
+        wordCharacters.insert(wordCharacters.end(), word.begin(), word.end());
+        wordOffsets.push_back(wordCharacters.size());
+    }
+
+    std::vector<std::uint32_t> codePoints = foundCodePoints;
+    std::sort(codePoints.begin(), codePoints.end());
+    codePoints.erase(std::unique(codePoints.begin(), codePoints.end()), codePoints.end());
+
+    offsets.push_back(0);
+    for (std::uint32_t codePoint : codePoints)
+    {
+        encode(codePoint, characters);
+        offsets.push_back(characters.size());
+    }
+
+    // about two buckets per occurrence
+    unsigned int bucketCount = 1;
+    while (bucketCount < 2 * found.size())
+    {
+        bucketCount *= 2;
+    }
+    bucketMask = bucketCount - 1;
+
+    // an occurrence is the only non-ASCII character in its word when the
+    // occurrences on either side of it are other words'; the filter gets
+    // about 16 bits for each of those
+    std::vector<bool> onlyOne(found.size());
+    unsigned int onlyOneCount = 0;
+    for (unsigned int o = 0; o < found.size(); o++)
+    {
+        onlyOne[o] = (o == 0 || found[o - 1].word != found[o].word)
+            && (o + 1 == found.size() || found[o + 1].word != found[o].word);
+        onlyOneCount += onlyOne[o];
+    }
+    unsigned int blockCount = 1;
+    while (blockCount * 4 < onlyOneCount)
+    {
+        blockCount *= 2;
+    }
+    asciiFilter.assign(blockCount, 0);
+    asciiFilterMask = blockCount - 1;
+
+    // number each occurrence's letter, then lay the occurrences out by
+    // bucket, each bucket in letter order
+    std::vector<unsigned int> buckets(found.size());
+    bucketStarts.assign(bucketCount + 1, 0);
+    for (unsigned int o = 0; o < found.size(); o++)
+    {
+        Occurrence& occurrence = found[o];
+        occurrence.letter = std::lower_bound(codePoints.begin(), codePoints.end(), foundCodePoints[o])
+            - codePoints.begin();
+
+        const char* word = wordCharacters.data() + wordOffsets[occurrence.word];
+        std::size_t wordLength = wordOffsets[occurrence.word + 1] - wordOffsets[occurrence.word];
+        std::size_t end = occurrence.start + offsets[occurrence.letter + 1] - offsets[occurrence.letter];
+        std::uint64_t hashCode = surroundingsHash(word, occurrence.start, word + end, wordLength - end);
+        if (onlyOne[o])
+        {
+            asciiFilter[filterBlock(hashCode)] |= filterBits(hashCode);
+        }
+        buckets[o] = hashCode & bucketMask;
+        bucketStarts[buckets[o] + 1]++;
+    }
+    for (unsigned int b = 0; b < bucketCount; b++)
+    {
+        bucketStarts[b + 1] += bucketStarts[b];
+    }
+
+    std::vector<unsigned int> next(bucketStarts.begin(), bucketStarts.end() - 1);
+    occurrences.resize(found.size());
+    for (unsigned int o = 0; o < found.size(); o++)
+    {
+        occurrences[next[buckets[o]]++] = found[o];
+    }
+    for (unsigned int b = 0; b < bucketCount; b++)
+    {
+        std::sort(occurrences.begin() + bucketStarts[b], occurrences.begin() + bucketStarts[b + 1],
+            [](const Occurrence& one, const Occurrence& other)
+            {
+                return one.letter < other.letter || (one.letter == other.letter && one.word < other.word);
+            });
+    }
+}
+
+
+unsigned int Utf8Alphabet::size() const
+{
+    return offsets.size() - 1;
+}
+
+
+std::uint64_t Utf8Alphabet::surroundingsHash(
+    const char* prefix, std::size_t prefixLength, const char* suffix, std::size_t suffixLength)
+{
+    // the prefix's length is mixed into the seed, so that moving the
+    // character gives a different hash
+    return wyhash(suffix, suffixLength, wyhash(prefix, prefixLength, prefixLength));
+}
+
+
+unsigned int Utf8Alphabet::characterLength(const char* characters, std::size_t remaining)
+{
+    const unsigned char* p = reinterpret_cast<const unsigned char*>(characters);
+    unsigned int length;
+    std::uint32_t minimum;
+    if (p[0] < 0x80)
+    {
+        return 1;
+    }
+    else if ((p[0] & 0xE0) == 0xC0)
+    {
+        length = 2;
+        minimum = 0x80;
+    }
+    else if ((p[0] & 0xF0) == 0xE0)
+    {
+        length = 3;
+        minimum = 0x800;
+    }
+    else if ((p[0] & 0xF8) == 0xF0)
+    {
+        length = 4;
+        minimum = 0x10000;
+    }
+    else
+    {
+        return 1;
+    }
+
+    if (length > remaining)
+    {
+        return 1;
+    }
+    for (unsigned int i = 1; i < length; i++)
+    {
+        if (!isContinuation(p[i]))
+        {
+            return 1;
+        }
+    }
+
+    // overlong encodings, surrogates and code points past U+10FFFF aren't
+    // well-formed
+    std::uint32_t codePoint = decode(p, length);
+    if (codePoint < minimum || codePoint > 0x10FFFF || (codePoint >= 0xD800 && codePoint <= 0xDFFF))
+    {
+        return 1;
+    }
+    return length;
+}
+
+
+unsigned int Utf8Alphabet::findCharacters(const std::string& word, std::vector<unsigned int>& starts)
+{
+    starts.clear();
+    std::size_t position = 0;
+    while (position < word.size())
+    {
+        starts.push_back(position);
+        position += characterLength(word.data() + position, word.size() - position);
+    }
+    starts.push_back(word.size());
+    return starts.size() - 1;
+}
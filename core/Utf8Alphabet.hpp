@@ -0,0 +1,242 @@
+// Utf8Alphabet.hpp
+//
+// ICS 46 Spring 2015
+// Project #3: Set the Controls for the Heart of the Sun
+//
+// A Utf8Alphabet is the set of non-ASCII characters that appear in a
+// dictionary whose words are encoded in UTF-8, gathered from its words
+// when it's loaded.  A BasicWordChecker given one suggests spellings of
+// words that aren't pure ASCII by editing them a code point at a time,
+// rather than a byte at a time: it swaps and deletes whole characters,
+// splits words only between characters, and inserts and replaces with
+// its alphabet's ASCII letters and the characters in the Utf8Alphabet.
+// Editing bytes would split multi-byte characters, making candidates that
+// can't be words and wasting a lookup on each.
+//
+// Most words a checker sees are pure ASCII, though, and trying every
+// character in the alphabet at every position of those would make them
+// slower to check for every non-ASCII character the dictionary has.  So
+// the alphabet also indexes each occurrence of its characters in the
+// words it was gathered from, under the bytes before and after it (much
+// as a WildcardIndex does).  Asking which of its characters fit between
+// a given prefix and suffix takes one hash lookup, and gives only the
+// characters that make a word there.  For an ASCII word, the only words
+// one edit away that aren't ASCII are those with a single non-ASCII
+// character, so a small Bloom filter of just those turns away nearly all
+// of its lookups before they reach the index.
+//
+// It also provides the UTF-8 functions that the BasicWordChecker uses to
+// decide which words need this and where their characters begin.  Bytes
+// that aren't part of a well-formed character are treated as characters
+// of their own, so any string can be edited without reading past its end.
+
+#ifndef UTF8ALPHABET_HPP
+#define UTF8ALPHABET_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+
+
+class Utf8Alphabet
+{
+public:
+    // Gathers every non-ASCII character that appears in the given words.
+    explicit Utf8Alphabet(const std::vector<std::string>& words);
+
+
+    // size() returns the number of characters in the alphabet; it's 0 for
+    // a dictionary that's pure ASCII.
+    unsigned int size() const;
+
+
+    // forEachLetter() calls callback(characters, length) with the UTF-8
+    // bytes of each character in the alphabet, in code point order.
+    template <typename Callback>
+    void forEachLetter(Callback callback) const;
+
+
+    // forEachLetterBetween() does the same for only those characters that,
+    // put between prefix and suffix, make one of the words the alphabet
+    // was gathered from.
+    template <typename Callback>
+    void forEachLetterBetween(
+        const char* prefix, std::size_t prefixLength,
+        const char* suffix, std::size_t suffixLength, Callback callback) const;
+
+
+    // forEachLetterBetweenAscii() does the same when prefix and suffix are
+    // both pure ASCII, as they are for every edit of an ASCII word.  It
+    // checks a small filter first, so when no character fits, which is
+    // nearly always, it finds that out without going to memory.
+    template <typename Callback>
+    void forEachLetterBetweenAscii(
+        const char* prefix, std::size_t prefixLength,
+        const char* suffix, std::size_t suffixLength, Callback callback) const;
+
+
+    // isAscii() returns true if the string is pure ASCII, which it checks
+    // eight bytes at a time.
+    static bool isAscii(const char* characters, std::size_t length);
+
+
+    // characterLength() returns the number of bytes in the UTF-8 character
+    // that starts at characters, or 1 if the bytes there aren't a
+    // well-formed character; remaining is the number of bytes available.
+    static unsigned int characterLength(const char* characters, std::size_t remaining);
+
+
+    // findCharacters() replaces the contents of starts with the position
+    // of each character in word, followed by word's length, and returns
+    // the number of characters.  starts's memory is reused.
+    static unsigned int findCharacters(const std::string& word, std::vector<unsigned int>& starts);
+
+
+private:
+    // letter i occupies characters [offsets[i], offsets[i + 1])
+    std::vector<unsigned int> offsets;
+    std::vector<char> characters;
+
+    // the distinct words that aren't pure ASCII; word i occupies
+    // wordCharacters[wordOffsets[i], wordOffsets[i + 1])
+    std::vector<unsigned int> wordOffsets;
+    std::vector<char> wordCharacters;
+
+    // an occurrence of letter number letter in word number word, starting
+    // at its byte start
+    struct Occurrence
+    {
+        unsigned int word;
+        unsigned int start;
+        unsigned int letter;
+    };
+
+    // the occurrences whose surrounding bytes hash into bucket b are
+    // occurrences[bucketStarts[b], bucketStarts[b + 1]), in letter order;
+    // the number of buckets is a power of two, and this is one less
+    std::vector<unsigned int> bucketStarts;
+    std::vector<Occurrence> occurrences;
+    unsigned int bucketMask;
+
+    // a Bloom filter of the surroundings of the occurrences that are the
+    // only non-ASCII character in their word, which are the only ones
+    // whose surroundings can be pure ASCII; each sets two bits in one
+    // 64-bit block.  There are about 16 bits per occurrence in it, and it
+    // leaves out the rest, so it's small enough to stay in cache.
+    std::vector<std::uint64_t> asciiFilter;
+    unsigned int asciiFilterMask;
+
+    // returns the block of asciiFilter that a hash code selects and the
+    // two bits it sets there
+    unsigned int filterBlock(std::uint64_t hashCode) const;
+    static std::uint64_t filterBits(std::uint64_t hashCode);
+
+    // calls callback for each letter in the bucket that a hash code of the
+    // surroundings selects whose occurrence they really are
+    template <typename Callback>
+    void forEachLetterInBucket(
+        std::uint64_t hashCode, const char* prefix, std::size_t prefixLength,
+        const char* suffix, std::size_t suffixLength, Callback& callback) const;
+
+    // hashes the bytes on either side of an occurrence
+    static std::uint64_t surroundingsHash(
+        const char* prefix, std::size_t prefixLength, const char* suffix, std::size_t suffixLength);
+};
+
+
+
+template <typename Callback>
+void Utf8Alphabet::forEachLetter(Callback callback) const
+{
+    for (unsigned int i = 0; i + 1 < offsets.size(); i++)
+    {
+        callback(characters.data() + offsets[i], offsets[i + 1] - offsets[i]);
+    }
+}
+
+
+template <typename Callback>
+void Utf8Alphabet::forEachLetterBetween(
+    const char* prefix, std::size_t prefixLength,
+    const char* suffix, std::size_t suffixLength, Callback callback) const
+{
+    std::uint64_t hashCode = surroundingsHash(prefix, prefixLength, suffix, suffixLength);
+    forEachLetterInBucket(hashCode, prefix, prefixLength, suffix, suffixLength, callback);
+}
+
+
+template <typename Callback>
+void Utf8Alphabet::forEachLetterBetweenAscii(
+    const char* prefix, std::size_t prefixLength,
+    const char* suffix, std::size_t suffixLength, Callback callback) const
+{
+    std::uint64_t hashCode = surroundingsHash(prefix, prefixLength, suffix, suffixLength);
+    std::uint64_t bits = filterBits(hashCode);
+    if ((asciiFilter[filterBlock(hashCode)] & bits) == bits)
+    {
+        forEachLetterInBucket(hashCode, prefix, prefixLength, suffix, suffixLength, callback);
+    }
+}
+
+
+template <typename Callback>
+void Utf8Alphabet::forEachLetterInBucket(
+    std::uint64_t hashCode, const char* prefix, std::size_t prefixLength,
+    const char* suffix, std::size_t suffixLength, Callback& callback) const
+{
+    unsigned int bucket = hashCode & bucketMask;
+    for (unsigned int o = bucketStarts[bucket]; o < bucketStarts[bucket + 1]; o++)
+    {
+        const Occurrence& occurrence = occurrences[o];
+        const char* word = wordCharacters.data() + wordOffsets[occurrence.word];
+        std::size_t wordLength = wordOffsets[occurrence.word + 1] - wordOffsets[occurrence.word];
+        const char* letter = characters.data() + offsets[occurrence.letter];
+        std::size_t letterLength = offsets[occurrence.letter + 1] - offsets[occurrence.letter];
+        if (occurrence.start == prefixLength
+            && wordLength == prefixLength + letterLength + suffixLength
+            && std::memcmp(word, prefix, prefixLength) == 0
+            && std::memcmp(word + prefixLength + letterLength, suffix, suffixLength) == 0)
+        {
+            callback(letter, letterLength);
+        }
+    }
+}
+
+
+inline unsigned int Utf8Alphabet::filterBlock(std::uint64_t hashCode) const
+{
+    // the bucket is chosen by the low bits, and the filter's bits by the
+    // top twelve, so the block is chosen by the bits in between
+    return (hashCode >> 20) & asciiFilterMask;
+}
+
+
+inline std::uint64_t Utf8Alphabet::filterBits(std::uint64_t hashCode)
+{
+    return (std::uint64_t{1} << ((hashCode >> 52) & 63)) | (std::uint64_t{1} << (hashCode >> 58));
+}
+
+
+inline bool Utf8Alphabet::isAscii(const char* characters, std::size_t length)
+{
+    std::uint64_t highBits = 0;
+    std::size_t i = 0;
+    for (; i + 8 <= length; i += 8)
+    {
+        std::uint64_t block;
+        std::memcpy(&block, characters + i, 8);
+        highBits |= block;
+    }
+    for (; i < length; i++)
+    {
+        highBits |= static_cast<unsigned char>(characters[i]);
+    }
+    return (highBits & 0x8080808080808080ull) == 0;
+}
+
+
+
+#endif // UTF8ALPHABET_HPP
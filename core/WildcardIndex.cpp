@@ -0,0 +1,114 @@
+// WildcardIndex.cpp
+//
+// ICS 46 Spring 2015
+// Project #3: Set the Controls for the Heart of the Sun
+
+#include "WildcardIndex.hpp"
+#include <algorithm>
+#include "HashPolicy.hpp"
+
+
+
+WildcardIndex::WildcardIndex(const std::vector<std::string>& words)
+{
+    // number the distinct words in ascending order, so that each bucket's
+    // postings, which are filled in by word number, come out sorted too
+    std::vector<std::string> sorted = words;
+    std::sort(sorted.begin(), sorted.end());
+    sorted.erase(std::unique(sorted.begin(), sorted.end()), sorted.end());
+
+    std::size_t patternCount = 0;
+    offsets.push_back(0);
+    for (const std::string& word : sorted)
+    {
+        characters.insert(characters.end(), word.begin(), word.end());
+        offsets.push_back(characters.size());
+        patternCount += word.size();
+    }
+
+    // about two patterns per bucket
+    unsigned int bucketCount = 1;
+    while (bucketCount < patternCount / 2)
+    {
+        bucketCount *= 2;
+    }
+    bucketMask = bucketCount - 1;
+
+    // hash every pattern once, counting the patterns in each bucket, then
+    // lay the buckets out end to end and fill them in
+    std::vector<unsigned int> patternBuckets;
+    patternBuckets.reserve(patternCount);
+    bucketStarts.assign(bucketCount + 1, 0);
+    for (unsigned int w = 0; w < sorted.size(); w++)
+    {
+        const char* word = characters.data() + offsets[w];
+        std::size_t length = offsets[w + 1] - offsets[w];
+        for (std::size_t i = 0; i < length; i++)
+        {
+            unsigned int bucket = patternHash(word, i, word + i + 1, length - i - 1) & bucketMask;
+            patternBuckets.push_back(bucket);
+            bucketStarts[bucket + 1]++;
+        }
+    }
+    for (unsigned int b = 0; b < bucketCount; b++)
+    {
+        bucketStarts[b + 1] += bucketStarts[b];
+    }
+
+    std::vector<unsigned int> next(bucketStarts.begin(), bucketStarts.end() - 1);
+    postings.resize(patternCount);
+    std::size_t pattern = 0;
+    for (unsigned int w = 0; w < sorted.size(); w++)
+    {
+        std::size_t length = offsets[w + 1] - offsets[w];
+        for (std::size_t i = 0; i < length; i++)
+        {
+            unsigned int bucket = patternBuckets[pattern++];
+            // a word can be indexed twice in the same bucket when two of
+            // its patterns collide; it only needs to be there once
+            if (next[bucket] == bucketStarts[bucket] || postings[next[bucket] - 1] != w)
+            {
+                postings[next[bucket]++] = w;
+            }
+        }
+    }
+
+    // close up the gaps that the skipped duplicates left
+    unsigned int end = 0;
+    for (unsigned int b = 0; b < bucketCount; b++)
+    {
+        unsigned int start = end;
+        for (unsigned int p = bucketStarts[b]; p < next[b]; p++)
+        {
+            postings[end++] = postings[p];
+        }
+        bucketStarts[b] = start;
+    }
+    bucketStarts[bucketCount] = end;
+    postings.resize(end);
+    postings.shrink_to_fit();
+}
+
+
+unsigned int WildcardIndex::size() const
+{
+    return offsets.size() - 1;
+}
+
+
+std::size_t WildcardIndex::bytes() const
+{
+    return offsets.size() * sizeof(unsigned int)
+        + characters.size()
+        + bucketStarts.size() * sizeof(unsigned int)
+        + postings.size() * sizeof(unsigned int);
+}
+
+
+std::uint64_t WildcardIndex::patternHash(
+    const char* prefix, std::size_t prefixLength, const char* suffix, std::size_t suffixLength)
+{
+    // the prefix's length is mixed into the seed, so that moving the
+    // wildcard gives a different pattern
+    return wyhash(suffix, suffixLength, wyhash(prefix, prefixLength, prefixLength));
+}
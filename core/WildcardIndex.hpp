@@ -0,0 +1,143 @@
+// WildcardIndex.hpp
+//
+// ICS 46 Spring 2015
+// Project #3: Set the Controls for the Heart of the Sun
+//
+// A WildcardIndex finds every word in a fixed list that matches a pattern
+// with one wildcard in it, such as C?T, which matches CAT, COT and CUT.
+// Those are exactly the words that two of the suggestion strategies look
+// for: replacing the character at position i of a word w matches the
+// pattern w[0, i) ? w[i + 1, end), and inserting a character into w
+// before position i matches the pattern w[0, i) ? w[i, end).  So instead
+// of trying each of 26 letters at every position, one lookup per
+// position finds every replacement or insertion that's a word.
+//
+// Every word of length n is indexed under its n patterns.  The patterns
+// themselves aren't stored: each is hashed (its prefix and suffix are
+// hashed separately, so no string has to be built to look one up) into a
+// bucket, and a bucket holds only the numbers of the words indexed under
+// it.  A lookup compares the pattern against each of those words to weed
+// out the ones that only share its bucket.  The words are sorted and
+// packed end to end in one array, so each of them is stored only once no
+// matter how many patterns it's indexed under.  The postings take four
+// bytes per character of the word list, and the buckets up to another
+// four.
+
+#ifndef WILDCARDINDEX_HPP
+#define WILDCARDINDEX_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+
+
+class WildcardIndex
+{
+public:
+    // Builds a WildcardIndex of the given words.  Duplicate words are
+    // allowed and are indexed only once.
+    WildcardIndex(const std::vector<std::string>& words);
+
+
+    // size() returns the number of distinct words in the index.
+    unsigned int size() const;
+
+
+    // bytes() returns the memory used by the index, including its words.
+    std::size_t bytes() const;
+
+
+    // forEachReplacement() calls callback(characters, length) for every
+    // word that's the same as word except, possibly, at the given
+    // position; word itself is one of them if it's in the index.  The
+    // words are passed in ascending order, and the count of them is
+    // returned.  The characters are good as long as the index is.
+    template <typename Callback>
+    unsigned int forEachReplacement(
+        const std::string& word, std::size_t position, Callback callback) const;
+
+
+    // forEachInsertion() calls callback(characters, length) for every word
+    // made by inserting one character into word before the given position
+    // (or at the end, if position is word's length).  The words are passed
+    // in ascending order, and the count of them is returned.
+    template <typename Callback>
+    unsigned int forEachInsertion(
+        const std::string& word, std::size_t position, Callback callback) const;
+
+
+private:
+    // the word numbered i occupies characters [offsets[i], offsets[i + 1])
+    std::vector<unsigned int> offsets;
+    std::vector<char> characters;
+
+    // the numbers of the words indexed under the patterns in bucket b are
+    // postings[bucketStarts[b], bucketStarts[b + 1]), in ascending order
+    std::vector<unsigned int> bucketStarts;
+    std::vector<unsigned int> postings;
+
+    // the number of buckets is a power of two; this is one less than it
+    unsigned int bucketMask;
+
+    // hashes the pattern prefix ? suffix
+    static std::uint64_t patternHash(
+        const char* prefix, std::size_t prefixLength, const char* suffix, std::size_t suffixLength);
+
+    // calls callback for each word matching the pattern prefix ? suffix
+    template <typename Callback>
+    unsigned int forEachMatch(
+        const char* prefix, std::size_t prefixLength,
+        const char* suffix, std::size_t suffixLength, Callback& callback) const;
+};
+
+
+
+template <typename Callback>
+unsigned int WildcardIndex::forEachReplacement(
+    const std::string& word, std::size_t position, Callback callback) const
+{
+    return forEachMatch(
+        word.data(), position,
+        word.data() + position + 1, word.size() - position - 1, callback);
+}
+
+
+template <typename Callback>
+unsigned int WildcardIndex::forEachInsertion(
+    const std::string& word, std::size_t position, Callback callback) const
+{
+    return forEachMatch(
+        word.data(), position,
+        word.data() + position, word.size() - position, callback);
+}
+
+
+template <typename Callback>
+unsigned int WildcardIndex::forEachMatch(
+    const char* prefix, std::size_t prefixLength,
+    const char* suffix, std::size_t suffixLength, Callback& callback) const
+{
+    unsigned int bucket = patternHash(prefix, prefixLength, suffix, suffixLength) & bucketMask;
+    std::size_t length = prefixLength + 1 + suffixLength;
+    unsigned int count = 0;
+    for (unsigned int p = bucketStarts[bucket]; p < bucketStarts[bucket + 1]; p++)
+    {
+        unsigned int w = postings[p];
+        const char* candidate = characters.data() + offsets[w];
+        if (offsets[w + 1] - offsets[w] == length
+            && std::memcmp(candidate, prefix, prefixLength) == 0
+            && std::memcmp(candidate + prefixLength + 1, suffix, suffixLength) == 0)
+        {
+            callback(candidate, length);
+            count++;
+        }
+    }
+    return count;
+}
+
+
+
+#endif // WILDCARDINDEX_HPP
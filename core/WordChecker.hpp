@@ -10,13 +10,22 @@
 // to modify the declarations of any of its member functions, since the
 // provided code calls into this class and expects it to look as originally
 // given.
+//
+// WordChecker is a thin wrapper around a BasicWordChecker over
+// Set<std::string>, which looks up words through Set's virtual functions,
+// and records the latency of its calls in LatencyMetrics.  Code that knows
+// the concrete type of its set can use BasicWordChecker directly, so that
+// its lookups are bound at compile time and, unless it asks for a
+// LatencyTimer, aren't timed.
 
 #ifndef WORDCHECKER_HPP
 #define WORDCHECKER_HPP
 
 #include <string>
 #include <vector>
+#include "BasicWordChecker.hpp"
 #include "Set.hpp"
+#include "SuggestionBuffer.hpp"
 
 
 
@@ -29,6 +38,31 @@ public:
     WordChecker(const Set<std::string>& words);
 
 
+    // This constructor also takes a WildcardIndex of the same words, which
+    // speeds up finding suggestions (see BasicWordChecker).  It's stored
+    // by reference, too.
+    WordChecker(const Set<std::string>& words, const WildcardIndex& wildcards);
+
+
+    // setPhoneticIndex() has findSuggestions() also suggest words that
+    // sound like the word, as found by the given index of the same words,
+    // which is stored by reference (see BasicWordChecker).
+    void setPhoneticIndex(const PhoneticIndex& phonetics);
+
+
+    // setSuggestionTable() has findSuggestions() answer the misspellings
+    // in the given table from it, which is stored by reference (see
+    // BasicWordChecker).
+    void setSuggestionTable(const SuggestionTable& table);
+
+
+    // setUtf8Alphabet() has findSuggestions() edit words that aren't pure
+    // ASCII a UTF-8 character at a time, trying the characters in the
+    // given alphabet, which must have been gathered from the set's words
+    // and is stored by reference (see BasicWordChecker).
+    void setUtf8Alphabet(const Utf8Alphabet& utf8);
+
+
     // wordExists() returns true if the given word is spelled correctly,
     // false otherwise.
     bool wordExists(const std::string& word) const;
@@ -40,8 +74,14 @@ public:
     std::vector<std::string> findSuggestions(const std::string& word) const;
 
 
+    // findSuggestions() finds the same suggestions, but replaces the
+    // contents of result with them, reusing result's memory rather than
+    // allocating a new vector (see SuggestionBuffer).
+    void findSuggestions(const std::string& word, SuggestionBuffer& result) const;
+
+
 private:
-    const Set<std::string>& words;
+    BasicWordChecker<Set<std::string>, UppercaseAlphabet, LatencyTimer> checker;
 };
 
 
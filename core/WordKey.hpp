@@ -0,0 +1,415 @@
+// WordKey.hpp
+//
+// ICS 46 Spring 2015
+// Project #3: Set the Controls for the Heart of the Sun
+//
+// A WordKey holds a word in a form that's quicker to compare than a
+// std::string, for use as the element type of any of the sets (for
+// example, HashSet<WordKey> or AVLSet<WordKey>).  Nearly all dictionary
+// words are 16 characters or fewer, and a WordKey stores those inline,
+// padded with zeroes to exactly 16 bytes, so two of them can be compared
+// in one 128-bit SSE2 comparison: the result says at once whether they're
+// equal and, if they aren't, at which position they first differ.  There's
+// no call into std::string's compare(), no loop and no pointer to follow.
+//
+// Longer words are also stored out of line in full, but their first 16
+// characters are still kept inline, so that two long words that differ
+// early are compared just as quickly.
+//
+// A WordKey can be made implicitly from a std::string, so a set of
+// WordKeys can be asked whether it contains a std::string, and a
+// BasicWordChecker over such a set works unchanged.  A WordKey of a short
+// word can also be made as a one-character edit of another one (a swap,
+// deletion, insertion or replacement), working on the 16 inline bytes
+// directly, which is how BasicWordChecker makes its candidates for short
+// words without building a std::string for each of them.
+//
+// Without SSE2, the inline prefixes are compared a byte at a time.
+
+#ifndef WORDKEY_HPP
+#define WORDKEY_HPP
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <utility>
+#include "HashPolicy.hpp"
+
+#if defined(__SSE2__) && defined(__GNUC__)
+#include <emmintrin.h>
+#define WORDKEY_USE_SSE2 1
+#endif
+
+
+
+class WordKey
+{
+public:
+    // The longest word that's stored entirely inline.
+    static constexpr unsigned int INLINE_CAPACITY = 16;
+
+public:
+    // Initializes a WordKey to hold the empty word.
+    WordKey();
+
+    // Initializes a WordKey to hold the given word.
+    WordKey(const std::string& word);
+    WordKey(const char* word, std::size_t length);
+
+    WordKey(const WordKey& other);
+    WordKey(WordKey&& other) noexcept;
+    ~WordKey();
+
+    WordKey& operator=(const WordKey& other);
+    WordKey& operator=(WordKey&& other) noexcept;
+
+
+    // assign() replaces the word with the given one.  It's cheaper than
+    // assigning a new WordKey made from the word, since no temporary
+    // WordKey is made and destroyed.
+    void assign(const std::string& word);
+    void assign(const char* word, std::size_t length);
+
+
+    // assignSwap(), assignErase(), assignInsert() and assignReplace()
+    // replace the word with word after swapping the characters at position
+    // and position + 1, erasing the character at position, inserting c
+    // before position, or replacing the character at position with c.
+    // word must be another WordKey, shorter than INLINE_CAPACITY, so that
+    // the result is stored inline, too.
+    void assignSwap(const WordKey& word, std::size_t position);
+    void assignErase(const WordKey& word, std::size_t position);
+    void assignInsert(const WordKey& word, std::size_t position, char c);
+    void assignReplace(const WordKey& word, std::size_t position, char c);
+
+
+    // size() returns the number of characters in the word.
+    std::size_t size() const;
+
+
+    // data() returns the word's characters, which aren't null-terminated.
+    const char* data() const;
+
+
+    // str() returns the word as a std::string.
+    std::string str() const;
+
+
+    // compare() returns a negative number, zero or a positive number if the
+    // word sorts before, the same as, or after the other one, in the same
+    // order that std::string's compare() gives.
+    int compare(const WordKey& other) const;
+
+
+    bool operator==(const WordKey& other) const;
+    bool operator!=(const WordKey& other) const;
+    bool operator<(const WordKey& other) const;
+    bool operator>(const WordKey& other) const;
+    bool operator<=(const WordKey& other) const;
+    bool operator>=(const WordKey& other) const;
+
+
+private:
+    friend struct DefaultHash<WordKey>;
+
+    // the first INLINE_CAPACITY characters of the word, followed by zeroes
+    // if it's shorter than that
+    alignas(16) unsigned char prefix[INLINE_CAPACITY];
+
+    // the whole word, if it's longer than INLINE_CAPACITY; NULL otherwise
+    char* longWord;
+
+    std::uint32_t length;
+
+    // returns true if the inline prefixes are equal, and otherwise sets
+    // position to the first position at which they differ
+    bool prefixesEqual(const WordKey& other, unsigned int& position) const;
+
+    // makes the word an inline one of the given length, with its prefix
+    // copied from word's, ready to be edited
+    void assignInline(const WordKey& word, std::size_t length);
+};
+
+
+
+inline WordKey::WordKey()
+    : prefix{}, longWord{NULL}, length{0}
+{
+}
+
+
+inline WordKey::WordKey(const std::string& word)
+    : longWord{NULL}
+{
+    assign(word.data(), word.size());
+}
+
+
+inline WordKey::WordKey(const char* word, std::size_t length)
+    : longWord{NULL}
+{
+    assign(word, length);
+}
+
+
+inline WordKey::WordKey(const WordKey& other)
+    : longWord{NULL}
+{
+    assign(other.data(), other.length);
+}
+
+
+inline WordKey::WordKey(WordKey&& other) noexcept
+    : longWord{other.longWord}, length{other.length}
+{
+    std::memcpy(prefix, other.prefix, INLINE_CAPACITY);
+    other.longWord = NULL;
+    other.length = 0;
+    std::memset(other.prefix, 0, INLINE_CAPACITY);
+}
+
+
+inline WordKey::~WordKey()
+{
+    delete[] longWord;
+}
+
+
+inline WordKey& WordKey::operator=(const WordKey& other)
+{
+    if (this != &other)
+    {
+        assign(other.data(), other.length);
+    }
+    return *this;
+}
+
+
+inline WordKey& WordKey::operator=(WordKey&& other) noexcept
+{
+    std::swap(longWord, other.longWord);
+    std::swap(length, other.length);
+    unsigned char temporary[INLINE_CAPACITY];
+    std::memcpy(temporary, prefix, INLINE_CAPACITY);
+    std::memcpy(prefix, other.prefix, INLINE_CAPACITY);
+    std::memcpy(other.prefix, temporary, INLINE_CAPACITY);
+    return *this;
+}
+
+
+inline std::size_t WordKey::size() const
+{
+    return length;
+}
+
+
+inline const char* WordKey::data() const
+{
+    return longWord != NULL ? longWord : reinterpret_cast<const char*>(prefix);
+}
+
+
+inline std::string WordKey::str() const
+{
+    return std::string(data(), length);
+}
+
+
+inline int WordKey::compare(const WordKey& other) const
+{
+    unsigned int position;
+    if (!prefixesEqual(other, position))
+    {
+        if (position < length && position < other.length)
+        {
+            return prefix[position] < other.prefix[position] ? -1 : 1;
+        }
+
+        // they differ only past the end of the shorter word, where it's
+        // padded with zeroes, so the shorter word is a prefix of the other
+        return length < other.length ? -1 : 1;
+    }
+    else if (length <= INLINE_CAPACITY && other.length <= INLINE_CAPACITY)
+    {
+        return (length > other.length) - (length < other.length);
+    }
+
+    // at least one is a long word, and their first INLINE_CAPACITY
+    // characters are equal
+    std::size_t shorter = length < other.length ? length : other.length;
+    int result = std::memcmp(
+        data() + INLINE_CAPACITY, other.data() + INLINE_CAPACITY, shorter - INLINE_CAPACITY);
+    if (result != 0)
+    {
+        return result;
+    }
+    return (length > other.length) - (length < other.length);
+}
+
+
+inline bool WordKey::operator==(const WordKey& other) const
+{
+    unsigned int position;
+    return length == other.length
+        && prefixesEqual(other, position)
+        && (length <= INLINE_CAPACITY
+            || std::memcmp(longWord + INLINE_CAPACITY, other.longWord + INLINE_CAPACITY,
+                length - INLINE_CAPACITY) == 0);
+}
+
+
+inline bool WordKey::operator!=(const WordKey& other) const
+{
+    return !(*this == other);
+}
+
+
+inline bool WordKey::operator<(const WordKey& other) const
+{
+    return compare(other) < 0;
+}
+
+
+inline bool WordKey::operator>(const WordKey& other) const
+{
+    return compare(other) > 0;
+}
+
+
+inline bool WordKey::operator<=(const WordKey& other) const
+{
+    return compare(other) <= 0;
+}
+
+
+inline bool WordKey::operator>=(const WordKey& other) const
+{
+    return compare(other) >= 0;
+}
+
+
+inline void WordKey::assign(const std::string& word)
+{
+    assign(word.data(), word.size());
+}
+
+
+inline void WordKey::assign(const char* word, std::size_t length)
+{
+    // allocate before changing anything, so that if it throws the WordKey
+    // is left as it was
+    char* replacement = NULL;
+    if (length > INLINE_CAPACITY)
+    {
+        replacement = new char[length];
+        std::memcpy(replacement, word, length);
+    }
+    delete[] longWord;
+    longWord = replacement;
+
+    this->length = static_cast<std::uint32_t>(length);
+    std::memset(prefix, 0, INLINE_CAPACITY);
+    std::memcpy(prefix, word, length < INLINE_CAPACITY ? length : INLINE_CAPACITY);
+}
+
+
+inline void WordKey::assignSwap(const WordKey& word, std::size_t position)
+{
+    assignInline(word, word.length);
+    prefix[position] = word.prefix[position + 1];
+    prefix[position + 1] = word.prefix[position];
+}
+
+
+inline void WordKey::assignErase(const WordKey& word, std::size_t position)
+{
+    // the last byte of word's prefix is padding, so shifting the bytes
+    // after position left leaves the new last byte zero, too
+    assignInline(word, word.length - 1);
+    std::memmove(prefix + position, word.prefix + position + 1, INLINE_CAPACITY - 1 - position);
+    prefix[INLINE_CAPACITY - 1] = 0;
+}
+
+
+inline void WordKey::assignInsert(const WordKey& word, std::size_t position, char c)
+{
+    // the byte shifted off the end is word's last byte of padding
+    assignInline(word, word.length + 1);
+    std::memmove(prefix + position + 1, word.prefix + position, INLINE_CAPACITY - 1 - position);
+    prefix[position] = static_cast<unsigned char>(c);
+}
+
+
+inline void WordKey::assignReplace(const WordKey& word, std::size_t position, char c)
+{
+    assignInline(word, word.length);
+    prefix[position] = static_cast<unsigned char>(c);
+}
+
+
+inline void WordKey::assignInline(const WordKey& word, std::size_t length)
+{
+    if (longWord != NULL)
+    {
+        delete[] longWord;
+        longWord = NULL;
+    }
+    this->length = static_cast<std::uint32_t>(length);
+    std::memcpy(prefix, word.prefix, INLINE_CAPACITY);
+}
+
+
+inline bool WordKey::prefixesEqual(const WordKey& other, unsigned int& position) const
+{
+#if defined(WORDKEY_USE_SSE2)
+    __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(prefix));
+    __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(other.prefix));
+    unsigned int differences = ~_mm_movemask_epi8(_mm_cmpeq_epi8(a, b)) & 0xffffu;
+    if (differences == 0)
+    {
+        return true;
+    }
+    position = __builtin_ctz(differences);
+    return false;
+#else
+    for (position = 0; position < INLINE_CAPACITY; position++)
+    {
+        if (prefix[position] != other.prefix[position])
+        {
+            return false;
+        }
+    }
+    return true;
+#endif
+}
+
+
+
+// DefaultHash<WordKey> hashes a word stored inline by mixing its two
+// 8-byte halves and its length with wyhash's final step; since the word
+// is always padded to 16 bytes, there are no branches on its length.
+// Longer words are hashed with wyhash.
+template <>
+struct DefaultHash<WordKey>
+{
+    unsigned int operator()(const WordKey& element) const
+    {
+        using namespace wyhashDetail;
+
+        std::uint64_t h;
+        if (element.length <= WordKey::INLINE_CAPACITY)
+        {
+            h = mix(read8(element.prefix) ^ SECRET1 ^ element.length,
+                read8(element.prefix + 8) ^ SECRET2);
+        }
+        else
+        {
+            h = wyhash(element.longWord, element.length);
+        }
+        return static_cast<unsigned int>(h ^ (h >> 32));
+    }
+};
+
+
+
+#endif // WORDKEY_HPP
@@ -0,0 +1,150 @@
+// AlphabetBenchmark.cpp
+//
+// ICS 46 Spring 2015
+// Project #3: Set the Controls for the Heart of the Sun
+//
+// Measures findSuggestions() with each of the ready-made alphabets.  The
+// word list is rewritten into each alphabet (lowercased, capitalized, or
+// lowercased with some of its E's accented for Latin-1), and one character
+// in the middle of each word is replaced with '#'.  The replacement
+// strategy should then suggest the original word; the benchmark returns
+// nonzero if it doesn't for any of them.
+
+#include <cctype>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "Alphabet.hpp"
+#include "BasicWordChecker.hpp"
+#include "Benchmarks.hpp"
+#include "HashSet.hpp"
+#include "SuggestionBuffer.hpp"
+
+
+namespace
+{
+    // the number of words misspelled for each alphabet
+    const unsigned int MISSPELLING_COUNT = 5000;
+
+    // the Latin-1 e with an acute accent
+    const char ACCENTED_E = static_cast<char>(0xE9);
+
+
+    std::string lowercase(const std::string& word)
+    {
+        std::string result = word;
+        for (char& c : result)
+        {
+            c = std::tolower(static_cast<unsigned char>(c));
+        }
+        return result;
+    }
+
+
+    std::string capitalized(const std::string& word)
+    {
+        std::string result = lowercase(word);
+        result[0] = std::toupper(static_cast<unsigned char>(result[0]));
+        return result;
+    }
+
+
+    std::string accented(const std::string& word)
+    {
+        std::string result = lowercase(word);
+        for (std::string::size_type i = 0; i < result.size(); i += 2)
+        {
+            if (result[i] == 'e')
+            {
+                result[i] = ACCENTED_E;
+            }
+        }
+        return result;
+    }
+
+
+    // checks misspellings of the first words with a BasicWordChecker over
+    // the given alphabet, reporting the time per word; returns the number
+    // of misspellings whose original word wasn't suggested
+    template <typename AlphabetType>
+    unsigned int measure(const char* name, const std::vector<std::string>& words)
+    {
+        HashSet<std::string> set;
+        set.addAll(words.begin(), words.end());
+
+        std::vector<std::string> misspellings;
+        for (unsigned int i = 0; i < words.size() && i < MISSPELLING_COUNT; i++)
+        {
+            std::string misspelled = words[i];
+            misspelled[misspelled.size() / 2] = '#';
+            misspellings.push_back(misspelled);
+        }
+
+        BasicWordChecker<HashSet<std::string>, AlphabetType> checker{set};
+        SuggestionBuffer buffer;
+        unsigned int missed = 0;
+        unsigned int suggestions = 0;
+        Stopwatch stopwatch;
+        for (unsigned int i = 0; i < misspellings.size(); i++)
+        {
+            checker.findSuggestions(misspellings[i], buffer);
+            suggestions += buffer.size();
+            bool suggested = false;
+            for (const std::string& suggestion : buffer)
+            {
+                suggested = suggested || suggestion == words[i];
+            }
+            if (!suggested)
+            {
+                missed++;
+            }
+        }
+        double elapsed = stopwatch.seconds();
+
+        std::cout << name << " (" << AlphabetType::SIZE << " letters): "
+                  << elapsed * 1e6 / misspellings.size() << " us/word, "
+                  << suggestions << " suggestions" << std::endl;
+        return missed;
+    }
+}
+
+
+int runAlphabetBenchmark(int argc, char** argv)
+{
+    if (argc < 1)
+    {
+        std::cout << "usage: exp alphabet <word list>" << std::endl;
+        return 1;
+    }
+
+    std::vector<std::string> words = loadWords(argv[0]);
+    if (words.empty())
+    {
+        std::cout << "no words could be read from " << argv[0] << std::endl;
+        return 1;
+    }
+
+    std::vector<std::string> lower;
+    std::vector<std::string> mixed;
+    std::vector<std::string> latin1;
+    for (const std::string& word : words)
+    {
+        lower.push_back(lowercase(word));
+        mixed.push_back(capitalized(word));
+        latin1.push_back(accented(word));
+    }
+
+    std::cout << words.size() << " words" << std::endl;
+    unsigned int missed = 0;
+    missed += measure<UppercaseAlphabet>("uppercase ", words);
+    missed += measure<LowercaseAlphabet>("lowercase ", lower);
+    missed += measure<MixedCaseAlphabet>("mixed case", mixed);
+    missed += measure<Latin1Alphabet>("Latin-1   ", latin1);
+
+    if (missed != 0)
+    {
+        std::cout << missed << " misspellings didn't get their word suggested" << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,233 @@
+// Benchmarks.hpp
+//
+// ICS 46 Spring 2015
+// Project #3: Set the Controls for the Heart of the Sun
+//
+// Declarations of the benchmarks that expmain() can run, along with a
+// few utilities that they share.  Each benchmark lives in its own source
+// file in the "exp" directory and takes the command-line arguments that
+// follow its name.
+
+#ifndef BENCHMARKS_HPP
+#define BENCHMARKS_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+
+
+
+// loadWords() reads a word list with one word per line, such as the
+// dictionary used by the spell checker.  Blank lines are skipped.
+inline std::vector<std::string> loadWords(const std::string& path)
+{
+    std::vector<std::string> words;
+    std::ifstream in{path};
+    std::string line;
+    while (std::getline(in, line))
+    {
+        if (!line.empty() && line[line.size() - 1] == '\r')
+        {
+            line.erase(line.size() - 1);
+        }
+        if (!line.empty())
+        {
+            words.push_back(line);
+        }
+    }
+    return words;
+}
+
+
+// A Stopwatch measures the wall-clock time since it was created or last
+// restarted.
+class Stopwatch
+{
+public:
+    Stopwatch()
+        : start{std::chrono::steady_clock::now()}
+    {
+    }
+
+    void restart()
+    {
+        start = std::chrono::steady_clock::now();
+    }
+
+    double seconds() const
+    {
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        return elapsed.count();
+    }
+
+private:
+    std::chrono::steady_clock::time_point start;
+};
+
+
+// A ZipfSampler draws ranks in [0, n) such that rank r is drawn with
+// probability proportional to 1 / (r + 1)^s, the way word frequencies in
+// real text fall off.  It's driven by a std::mt19937, whose output the C++
+// standard fixes, and doesn't use the standard distributions, whose
+// output it doesn't, so a given seed replays the same ranks everywhere.
+class ZipfSampler
+{
+public:
+    ZipfSampler(std::size_t n, double s, unsigned int seed)
+        : engine{seed}
+    {
+        double total = 0.0;
+        for (unsigned int r = 0; r < n; r++)
+        {
+            total += 1.0 / std::pow(r + 1.0, s);
+            cumulative.push_back(total);
+        }
+        for (double& c : cumulative)
+        {
+            c /= total;
+        }
+    }
+
+    unsigned int next()
+    {
+        double u = (engine() + 0.5) / 4294967296.0;
+        unsigned int rank = std::lower_bound(cumulative.begin(), cumulative.end(), u) - cumulative.begin();
+        return std::min(rank, static_cast<unsigned int>(cumulative.size() - 1));
+    }
+
+    std::vector<unsigned int> sample(unsigned int count)
+    {
+        std::vector<unsigned int> ranks;
+        ranks.reserve(count);
+        for (unsigned int i = 0; i < count; i++)
+        {
+            ranks.push_back(next());
+        }
+        return ranks;
+    }
+
+private:
+    std::mt19937 engine;
+    std::vector<double> cumulative;
+};
+
+
+
+// Compares lookups per second of a HashSet using its compile-time hash
+// policy against one using a std::function.
+//     exp hash <word list>
+int runHashPolicyBenchmark(int argc, char** argv);
+
+
+// Compares building a HashSet and an AVLSet one add() at a time against
+// addAll() with 1, 2, 4, ... threads, on generated word lists.
+//     exp build [word count...]
+int runParallelBuildBenchmark(int argc, char** argv);
+
+
+// Compares the throughput of a ShardedHashSet against a HashSet behind
+// one lock, with 1, 4, 16 and 64 threads adding and looking up words.
+//     exp contention <word list> [write every n]
+int runContentionBenchmark(int argc, char** argv);
+
+
+// Checks every word in a list and finds suggestions for a misspelling of
+// each, then dumps the recorded latency histograms.
+//     exp latency <word list>
+int runLatencyReport(int argc, char** argv);
+
+
+// Replays a seeded Zipf-distributed stream of lookups against a HashSet
+// in each ChainOrder and reports the mean number of probes per lookup.
+//     exp zipf <word list> [lookups] [exponent] [seed]
+int runZipfProbeBenchmark(int argc, char** argv);
+
+
+// Compares a BSTSet that splays against an AVLSet, building each from a
+// sorted word list and then answering Zipf-distributed and uniformly
+// distributed lookups.
+//     exp splay <word list> [lookups] [exponent] [seed]
+int runSplayBenchmark(int argc, char** argv);
+
+
+// Compares finding suggestions with and without a WildcardIndex, reporting
+// the lookups saved; returns nonzero if they find different suggestions.
+//     exp wildcard <word list>
+int runWildcardBenchmark(int argc, char** argv);
+
+
+// Compares lookups in a LayeredSet of three dictionaries against looking
+// in each of the three sets in turn.
+//     exp layered <word list>
+int runLayeredBenchmark(int argc, char** argv);
+
+
+// Builds a SuggestionTable file from a file of misspellings (such as a
+// query log), keeping the most frequent limit of them, then checks it;
+// returns nonzero if the table's suggestions differ from live ones.
+//     exp table <dictionary> <misspellings> <output> [limit]
+int runSuggestionTableTool(int argc, char** argv);
+
+
+// Compares building a whole dictionary against opening it as a
+// LazyShardedSet (written to the shard file) for a sparse workload,
+// with and without a memory limit; returns nonzero if they disagree.
+//     exp lazy <word list> <shard file> [distinct words] [shards]
+int runLazyShardBenchmark(int argc, char** argv);
+
+
+// Compares the bytes per word and lookup latency of FrontCodedSets of
+// several block sizes against the node-based sets; returns nonzero if
+// any set gives a wrong answer.
+//     exp frontcoded <word list>
+int runFrontCodedBenchmark(int argc, char** argv);
+
+
+// Compares lookups in, and finding suggestions with, sets of WordKeys
+// against sets of std::strings.
+//     exp wordkey <word list>
+int runWordKeyBenchmark(int argc, char** argv);
+
+
+// Measures findSuggestions() with each ready-made alphabet, on the word
+// list rewritten into that alphabet; returns nonzero if a misspelling
+// doesn't get its word suggested.
+//     exp alphabet <word list>
+int runAlphabetBenchmark(int argc, char** argv);
+
+
+// Measures findSuggestions() on UTF-8 words a byte at a time and a
+// character at a time, and on ASCII words with and without a
+// Utf8Alphabet; returns nonzero if a UTF-8 misspelling checked a
+// character at a time doesn't get its word suggested.
+//     exp utf8 <word list>
+int runUtf8Benchmark(int argc, char** argv);
+
+
+// Measures unionOf(), intersectionOf() and differenceOf() on two releases
+// of millions of words, made from copies of the word list, against one
+// contains() call per element; returns nonzero if the results differ.
+//     exp algebra <word list> [copies] [threads]
+int runSetAlgebraBenchmark(int argc, char** argv);
+
+
+// Measures merging a batch of new words into a large AVLSet of millions
+// of words with one add() per word, with addAll() and with insertAll();
+// returns nonzero if the merged sets differ.
+//     exp join <word list> [copies] [threads]
+int runJoinBenchmark(int argc, char** argv);
+
+
+// Measures loading a sorted word list into each tree and skip-list set
+// with add() and with buildFromSorted(), and a snapshot and restore with
+// dumpSorted(); returns nonzero if a restored set differs.
+//     exp bulkload <word list>
+int runBulkLoadBenchmark(int argc, char** argv);
+
+
+
+#endif // BENCHMARKS_HPP
@@ -0,0 +1,101 @@
+// BulkLoadBenchmark.cpp
+//
+// ICS 46 Spring 2015
+// Project #3: Set the Controls for the Heart of the Sun
+//
+// Measures loading a sorted word list into an AVLSet, a BSTSet and a
+// SkipListSet with one add() per word and with buildFromSorted(), and
+// taking a snapshot of each set with dumpSorted() and restoring it with
+// buildFromSorted().  Adding sorted words to a BSTSet one at a time
+// makes a chain, which takes quadratic time, so only the first few
+// thousand words are added to it that way.  It returns nonzero if a
+// restored set doesn't hold the same words as the list.
+
+#include <algorithm>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+#include "AVLSet.hpp"
+#include "Benchmarks.hpp"
+#include "BSTSet.hpp"
+#include "SkipListSet.hpp"
+
+
+namespace
+{
+    const unsigned int BST_ADD_LIMIT = 20000;
+
+
+    // times add() for each of the first count words, then the rest of the
+    // steps on the whole list; returns true if the restored set matches
+    template <typename SetType>
+    bool measure(const char* name, const std::vector<std::string>& words, unsigned int count)
+    {
+        Stopwatch stopwatch;
+        {
+            SetType added;
+            for (unsigned int i = 0; i < count; i++)
+            {
+                added.add(words[i]);
+            }
+        }
+        double addSeconds = stopwatch.seconds();
+
+        stopwatch.restart();
+        SetType built;
+        built.buildFromSorted(words.begin(), words.end());
+        double buildSeconds = stopwatch.seconds();
+
+        stopwatch.restart();
+        std::vector<std::string> snapshot;
+        snapshot.reserve(built.size());
+        built.dumpSorted(std::back_inserter(snapshot));
+        double dumpSeconds = stopwatch.seconds();
+
+        stopwatch.restart();
+        SetType restored;
+        restored.buildFromSorted(snapshot.begin(), snapshot.end());
+        double restoreSeconds = stopwatch.seconds();
+
+        std::cout << name << ": add() " << addSeconds << " s for " << count << " words, "
+                  << "buildFromSorted() " << buildSeconds << " s, dumpSorted() " << dumpSeconds
+                  << " s, restore " << restoreSeconds << " s" << std::endl;
+
+        std::vector<std::string> check;
+        restored.dumpSorted(std::back_inserter(check));
+        return check == words;
+    }
+}
+
+
+int runBulkLoadBenchmark(int argc, char** argv)
+{
+    if (argc < 1)
+    {
+        std::cout << "usage: exp bulkload <word list>" << std::endl;
+        return 1;
+    }
+
+    std::vector<std::string> words = loadWords(argv[0]);
+    if (words.empty())
+    {
+        std::cout << "no words could be read from " << argv[0] << std::endl;
+        return 1;
+    }
+    std::sort(words.begin(), words.end());
+    words.erase(std::unique(words.begin(), words.end()), words.end());
+    std::cout << words.size() << " words" << std::endl;
+
+    unsigned int bstCount = std::min<unsigned int>(words.size(), BST_ADD_LIMIT);
+    bool matched = measure<AVLSet<std::string>>("AVLSet     ", words, words.size());
+    matched = measure<BSTSet<std::string>>("BSTSet     ", words, bstCount) && matched;
+    matched = measure<SkipListSet<std::string>>("SkipListSet", words, words.size()) && matched;
+
+    if (!matched)
+    {
+        std::cout << "a restored set differs from the word list" << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,119 @@
+// ContentionBenchmark.cpp
+//
+// ICS 46 Spring 2015
+// Project #3: Set the Controls for the Heart of the Sun
+//
+// Measures the throughput of a ShardedHashSet with 1, 4, 16 and 64
+// threads, each running the same mix of operations: mostly contains(),
+// with an add() of a new word every so often.  For comparison, the same
+// workload runs against a HashSet guarded by a single std::mutex.
+
+#include <atomic>
+#include <cstdlib>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "Benchmarks.hpp"
+#include "HashSet.hpp"
+#include "Parallel.hpp"
+#include "ShardedHashSet.hpp"
+
+
+namespace
+{
+    const unsigned int OPERATIONS_PER_THREAD = 400000;
+
+
+    // a HashSet with one lock around everything, as a baseline
+    class LockedHashSet
+    {
+    public:
+        void add(const std::string& word)
+        {
+            std::lock_guard<std::mutex> guard{lock};
+            set.add(word);
+        }
+
+        bool contains(const std::string& word) const
+        {
+            std::lock_guard<std::mutex> guard{lock};
+            return set.contains(word);
+        }
+
+    private:
+        mutable std::mutex lock;
+        HashSet<std::string> set;
+    };
+
+
+    // every writeEvery'th operation adds a word that no other thread adds;
+    // the rest look up words from the list, about half of them present
+    template <typename SetType>
+    double operationsPerSecond(
+        SetType& set, const std::vector<std::string>& words,
+        unsigned int threadCount, unsigned int writeEvery)
+    {
+        std::atomic<unsigned int> hits{0};
+        Stopwatch stopwatch;
+        runInParallel(threadCount,
+            [&](unsigned int t)
+            {
+                unsigned int found = 0;
+                std::string added = "T" + std::to_string(t) + "#";
+                for (unsigned int i = 0; i < OPERATIONS_PER_THREAD; i++)
+                {
+                    if (i % writeEvery == 0)
+                    {
+                        set.add(added + std::to_string(i));
+                    }
+                    else if (set.contains(words[(i * 7919 + t * 104729) % words.size()]))
+                    {
+                        found++;
+                    }
+                }
+                hits += found;
+            });
+        return threadCount * static_cast<double>(OPERATIONS_PER_THREAD) / stopwatch.seconds();
+    }
+}
+
+
+int runContentionBenchmark(int argc, char** argv)
+{
+    if (argc < 1)
+    {
+        std::cout << "usage: exp contention <word list> [write every n]" << std::endl;
+        return 1;
+    }
+
+    std::vector<std::string> words = loadWords(argv[0]);
+    if (words.empty())
+    {
+        std::cout << "no words could be read from " << argv[0] << std::endl;
+        return 1;
+    }
+    unsigned int writeEvery = (argc > 1) ? std::strtoul(argv[1], NULL, 10) : 10;
+    if (writeEvery == 0)
+    {
+        writeEvery = 1;
+    }
+
+    std::cout << "1 add() in every " << writeEvery << " operations" << std::endl;
+    for (unsigned int threads : {1u, 4u, 16u, 64u})
+    {
+        ShardedHashSet<std::string> sharded;
+        LockedHashSet locked;
+        for (unsigned int i = 0; i < words.size(); i += 2)
+        {
+            sharded.add(words[i]);
+            locked.add(words[i]);
+        }
+
+        double shardedRate = operationsPerSecond(sharded, words, threads, writeEvery);
+        double lockedRate = operationsPerSecond(locked, words, threads, writeEvery);
+        std::cout << threads << " thread(s): ShardedHashSet " << shardedRate
+                  << " ops/s, locked HashSet " << lockedRate << " ops/s" << std::endl;
+    }
+    return 0;
+}
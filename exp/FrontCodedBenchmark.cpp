@@ -0,0 +1,147 @@
+// FrontCodedBenchmark.cpp
+//
+// ICS 46 Spring 2015
+// Project #3: Set the Controls for the Heart of the Sun
+//
+// Compares the memory and lookup latency of a FrontCodedSet, at its
+// smallest, default and largest block sizes, against the node-based sets.
+// Memory is measured as the growth in the heap's allocated bytes while
+// each set is built (using glibc's mallinfo2(), so it includes malloc's
+// own overhead), divided by the number of words.  Half of the lookups
+// are words in the list and half are words that aren't, in random order.
+// It returns nonzero if any set gives a wrong answer.
+
+#include <algorithm>
+#include <iostream>
+#include <malloc.h>
+#include <random>
+#include <string>
+#include <vector>
+#include "AVLSet.hpp"
+#include "Benchmarks.hpp"
+#include "FrontCodedSet.hpp"
+#include "HashSet.hpp"
+#include "SkipListSet.hpp"
+
+
+namespace
+{
+    const unsigned int SEED = 46;
+
+
+    std::size_t heapBytes()
+    {
+        return mallinfo2().uordblks;
+    }
+
+
+    // builds a set with the given function, then reports the heap it
+    // takes per word and the mean time per lookup; returns the number of
+    // lookups that gave the wrong answer
+    template <typename SetType, typename Build>
+    unsigned int measure(
+        const char* name, Build build, unsigned int wordCount,
+        const std::vector<std::string>& probes, const std::vector<bool>& expected)
+    {
+        std::size_t before = heapBytes();
+        SetType* set = build();
+        std::size_t after = heapBytes();
+
+        unsigned int wrong = 0;
+        Stopwatch stopwatch;
+        for (unsigned int i = 0; i < probes.size(); i++)
+        {
+            if (set->contains(probes[i]) != expected[i])
+            {
+                wrong++;
+            }
+        }
+        double elapsed = stopwatch.seconds();
+
+        std::cout << name << ": " << static_cast<double>(after - before) / wordCount
+                  << " bytes/word, " << elapsed * 1e9 / probes.size() << " ns/lookup" << std::endl;
+        delete set;
+        return wrong;
+    }
+}
+
+
+int runFrontCodedBenchmark(int argc, char** argv)
+{
+    if (argc < 1)
+    {
+        std::cout << "usage: exp frontcoded <word list>" << std::endl;
+        return 1;
+    }
+
+    std::vector<std::string> words = loadWords(argv[0]);
+    if (words.empty())
+    {
+        std::cout << "no words could be read from " << argv[0] << std::endl;
+        return 1;
+    }
+
+    std::vector<std::string> probes;
+    std::vector<bool> expected;
+    for (const std::string& word : words)
+    {
+        probes.push_back(word);
+        probes.push_back(word + "#");
+    }
+    std::shuffle(probes.begin(), probes.end(), std::mt19937{SEED});
+    for (const std::string& probe : probes)
+    {
+        expected.push_back(probe[probe.size() - 1] != '#');
+    }
+
+    std::cout << words.size() << " words, " << probes.size() << " lookups" << std::endl;
+
+    unsigned int wrong = 0;
+    wrong += measure<HashSet<std::string>>("HashSet         ",
+        [&]
+        {
+            HashSet<std::string>* set = new HashSet<std::string>;
+            set->addAll(words.begin(), words.end());
+            return set;
+        },
+        words.size(), probes, expected);
+    wrong += measure<AVLSet<std::string>>("AVLSet          ",
+        [&]
+        {
+            AVLSet<std::string>* set = new AVLSet<std::string>;
+            set->addAll(words.begin(), words.end());
+            return set;
+        },
+        words.size(), probes, expected);
+    wrong += measure<SkipListSet<std::string>>("SkipListSet     ",
+        [&]
+        {
+            SkipListSet<std::string>* set = new SkipListSet<std::string>;
+            for (const std::string& word : words)
+            {
+                set->add(word);
+            }
+            return set;
+        },
+        words.size(), probes, expected);
+
+    for (unsigned int blockSize :
+        {FrontCodedSet::MIN_BLOCK_SIZE, FrontCodedSet::DEFAULT_BLOCK_SIZE, FrontCodedSet::MAX_BLOCK_SIZE})
+    {
+        std::string name = "FrontCodedSet " + std::to_string(blockSize);
+        name.resize(16, ' ');
+        wrong += measure<FrontCodedSet>(name.c_str(),
+            [&]
+            {
+                return new FrontCodedSet{words, blockSize};
+            },
+            words.size(), probes, expected);
+    }
+
+    if (wrong != 0)
+    {
+        std::cout << wrong << " wrong answers" << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,87 @@
+// HashPolicyBenchmark.cpp
+//
+// ICS 46 Spring 2015
+// Project #3: Set the Controls for the Heart of the Sun
+//
+// Measures how many contains() calls per second a HashSet can answer when
+// it hashes with its compile-time HashPolicy, compared to the same hash
+// wrapped in a std::function (the original interface).  Half of the
+// lookups are words in the list and half are words that aren't.
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include "Benchmarks.hpp"
+#include "HashSet.hpp"
+
+
+namespace
+{
+    const int ROUNDS = 20;
+
+
+    template <typename SetType>
+    double lookupsPerSecond(const SetType& set, const std::vector<std::string>& probes)
+    {
+        unsigned int found = 0;
+        Stopwatch stopwatch;
+        for (int round = 0; round < ROUNDS; round++)
+        {
+            for (const std::string& probe : probes)
+            {
+                if (set.contains(probe))
+                {
+                    found++;
+                }
+            }
+        }
+        double elapsed = stopwatch.seconds();
+
+        // printed so the lookups can't be optimized away
+        std::cout << "    (" << found << " hits)" << std::endl;
+        return probes.size() * static_cast<double>(ROUNDS) / elapsed;
+    }
+}
+
+
+int runHashPolicyBenchmark(int argc, char** argv)
+{
+    if (argc < 1)
+    {
+        std::cout << "usage: exp hash <word list>" << std::endl;
+        return 1;
+    }
+
+    std::vector<std::string> words = loadWords(argv[0]);
+    if (words.empty())
+    {
+        std::cout << "no words could be read from " << argv[0] << std::endl;
+        return 1;
+    }
+
+    std::vector<std::string> probes;
+    for (const std::string& word : words)
+    {
+        probes.push_back(word);
+        probes.push_back(word + "Q");
+    }
+
+    HashSet<std::string> inlined;
+    HashSet<std::string> erased{HashSet<std::string>::HashFunction{DefaultHash<std::string>{}}};
+    for (const std::string& word : words)
+    {
+        inlined.add(word);
+        erased.add(word);
+    }
+
+    std::cout << words.size() << " words, " << probes.size() << " probes" << std::endl;
+
+    double erasedRate = lookupsPerSecond(erased, probes);
+    std::cout << "std::function hash: " << erasedRate << " lookups/s" << std::endl;
+
+    double inlinedRate = lookupsPerSecond(inlined, probes);
+    std::cout << "HashPolicy hash:    " << inlinedRate << " lookups/s" << std::endl;
+
+    std::cout << "speedup: " << inlinedRate / erasedRate << "x" << std::endl;
+    return 0;
+}
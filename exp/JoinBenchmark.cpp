@@ -0,0 +1,106 @@
+// JoinBenchmark.cpp
+//
+// ICS 46 Spring 2015
+// Project #3: Set the Controls for the Heart of the Sun
+//
+// Measures three ways of merging a batch of new words into a large
+// AVLSet: one add() per word, addAll(), which rebuilds the whole tree,
+// and insertAll(), which splits and joins the existing tree around a
+// balanced one built from the batch.  The word list is multiplied into
+// millions of words by appending numbers to it, and the batch is a tenth
+// as many words again, half of them already in the set.  It returns
+// nonzero if the three sets don't end up with the same elements.
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include "AVLSet.hpp"
+#include "Benchmarks.hpp"
+
+
+namespace
+{
+    const unsigned int DEFAULT_COPIES = 20;
+    const unsigned int SEED = 46;
+
+
+    // builds the large set that each way starts from
+    void buildExisting(AVLSet<std::string>& set, const std::vector<std::string>& existing)
+    {
+        set.addAll(existing.begin(), existing.end());
+    }
+}
+
+
+int runJoinBenchmark(int argc, char** argv)
+{
+    if (argc < 1)
+    {
+        std::cout << "usage: exp join <word list> [copies] [threads]" << std::endl;
+        return 1;
+    }
+
+    std::vector<std::string> words = loadWords(argv[0]);
+    if (words.empty())
+    {
+        std::cout << "no words could be read from " << argv[0] << std::endl;
+        return 1;
+    }
+    unsigned int copies = argc >= 2 ? std::atoi(argv[1]) : DEFAULT_COPIES;
+    unsigned int threadCount = argc >= 3 ? std::atoi(argv[2]) : defaultThreadCount();
+
+    // every twentieth word of each copy goes into the batch, along with a
+    // new word made from it that isn't in the set yet
+    std::vector<std::string> existing;
+    std::vector<std::string> batch;
+    for (unsigned int c = 0; c < copies; c++)
+    {
+        for (unsigned int i = 0; i < words.size(); i++)
+        {
+            std::string word = words[i] + std::to_string(c);
+            if (i % 20 == 0)
+            {
+                batch.push_back(word);
+                batch.push_back(word + "-");
+            }
+            existing.push_back(std::move(word));
+        }
+    }
+    std::shuffle(batch.begin(), batch.end(), std::mt19937{SEED});
+    std::cout << existing.size() << " words in the set, " << batch.size() << " in the batch, "
+              << threadCount << " threads" << std::endl;
+
+    AVLSet<std::string> added;
+    buildExisting(added, existing);
+    Stopwatch stopwatch;
+    for (const std::string& word : batch)
+    {
+        added.add(word);
+    }
+    std::cout << "add() per word: " << stopwatch.seconds() << " s" << std::endl;
+
+    AVLSet<std::string> rebuilt;
+    buildExisting(rebuilt, existing);
+    stopwatch.restart();
+    rebuilt.addAll(batch.begin(), batch.end(), threadCount);
+    std::cout << "addAll():       " << stopwatch.seconds() << " s" << std::endl;
+
+    AVLSet<std::string> joined;
+    buildExisting(joined, existing);
+    stopwatch.restart();
+    joined.insertAll(batch.begin(), batch.end(), threadCount);
+    std::cout << "insertAll():    " << stopwatch.seconds() << " s" << std::endl;
+
+    std::cout << joined.size() << " words after merging" << std::endl;
+    if (added.size() != joined.size() || rebuilt.size() != joined.size()
+        || !std::equal(joined.begin(), joined.end(), added.begin())
+        || !std::equal(joined.begin(), joined.end(), rebuilt.begin()))
+    {
+        std::cout << "the merged sets differ" << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,46 @@
+// LatencyReport.cpp
+//
+// ICS 46 Spring 2015
+// Project #3: Set the Controls for the Heart of the Sun
+//
+// Runs a WordChecker over a word list, checking each word and finding
+// suggestions for a misspelling of it, then prints the latency metrics
+// that were recorded, first as a table and then as JSON.
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include "Benchmarks.hpp"
+#include "HashSet.hpp"
+#include "LatencyHistogram.hpp"
+#include "WordChecker.hpp"
+
+
+int runLatencyReport(int argc, char** argv)
+{
+    if (argc < 1)
+    {
+        std::cout << "usage: exp latency <word list>" << std::endl;
+        return 1;
+    }
+
+    std::vector<std::string> words = loadWords(argv[0]);
+    HashSet<std::string> set;
+    set.addAll(words.begin(), words.end(), 1);
+    WordChecker checker{set};
+
+    LatencyMetrics::reset();
+    unsigned int suggestions = 0;
+    for (const std::string& word : words)
+    {
+        checker.wordExists(word);
+        std::string misspelled = word;
+        misspelled[misspelled.size() / 2] = '#';
+        suggestions += checker.findSuggestions(misspelled).size();
+    }
+
+    std::cout << words.size() << " words, " << suggestions << " suggestions" << std::endl;
+    LatencyMetrics::dump(std::cout);
+    std::cout << LatencyMetrics::toJson() << std::endl;
+    return 0;
+}
@@ -0,0 +1,135 @@
+// LayeredBenchmark.cpp
+//
+// ICS 46 Spring 2015
+// Project #3: Set the Controls for the Heart of the Sun
+//
+// Splits a word list into a base dictionary (80% of the words), a domain
+// dictionary (15%) and a user's own words (5%), and compares looking
+// words up in a LayeredSet of the three against looking them up in each
+// of the three sets in turn.  Half of the lookups are words in the list
+// and half are words that aren't, and it reports how many of the latter
+// got past the LayeredSet's filters.  The base and domain dictionaries
+// share one filter, built once, as they would across tenants; the user's
+// LayeredSet holds only a filter of its own words.
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include "Benchmarks.hpp"
+#include "BloomFilter.hpp"
+#include "HashSet.hpp"
+#include "LayeredSet.hpp"
+
+
+namespace
+{
+    const int ROUNDS = 10;
+
+
+    template <typename Lookup>
+    double lookupsPerSecond(const std::vector<std::string>& probes, Lookup lookup)
+    {
+        unsigned int found = 0;
+        Stopwatch stopwatch;
+        for (int round = 0; round < ROUNDS; round++)
+        {
+            for (const std::string& probe : probes)
+            {
+                if (lookup(probe))
+                {
+                    found++;
+                }
+            }
+        }
+        double elapsed = stopwatch.seconds();
+
+        // printed so the lookups can't be optimized away
+        std::cout << "    (" << found << " hits)" << std::endl;
+        return probes.size() * static_cast<double>(ROUNDS) / elapsed;
+    }
+}
+
+
+int runLayeredBenchmark(int argc, char** argv)
+{
+    if (argc < 1)
+    {
+        std::cout << "usage: exp layered <word list>" << std::endl;
+        return 1;
+    }
+
+    std::vector<std::string> words = loadWords(argv[0]);
+    if (words.empty())
+    {
+        std::cout << "no words could be read from " << argv[0] << std::endl;
+        return 1;
+    }
+
+    unsigned int baseEnd = words.size() * 80 / 100;
+    unsigned int domainEnd = words.size() * 95 / 100;
+    unsigned int sharedBlocks = BloomFilter::blocksFor(domainEnd);
+    unsigned int userBlocks = BloomFilter::blocksFor(words.size() - domainEnd);
+
+    HashSet<std::string> base;
+    HashSet<std::string> domain;
+    HashSet<std::string> user;
+    BloomFilter sharedFilter{sharedBlocks};
+    for (unsigned int i = 0; i < domainEnd; i++)
+    {
+        HashSet<std::string>& layer = (i < baseEnd) ? base : domain;
+        layer.add(words[i]);
+        sharedFilter.add(words[i]);
+    }
+
+    LayeredSet layered{userBlocks};
+    layered.addLayer(base, sharedFilter);
+    layered.addLayer(domain, sharedFilter);
+    for (unsigned int i = domainEnd; i < words.size(); i++)
+    {
+        user.add(words[i]);
+        layered.add(words[i]);
+    }
+
+    std::vector<std::string> probes;
+    for (const std::string& word : words)
+    {
+        probes.push_back(word);
+        probes.push_back(word + "#");
+    }
+
+    // the LayeredSet doesn't say whether its filters let a miss through,
+    // so build the same filter of the user's words here and ask both
+    unsigned int falsePositives = 0;
+    BloomFilter userFilter{userBlocks};
+    for (unsigned int i = domainEnd; i < words.size(); i++)
+    {
+        userFilter.add(words[i]);
+    }
+    for (const std::string& word : words)
+    {
+        if (sharedFilter.mayContain(word + "#") || userFilter.mayContain(word + "#"))
+        {
+            falsePositives++;
+        }
+    }
+
+    std::cout << words.size() << " words in three layers, " << probes.size() << " probes" << std::endl;
+    std::cout << "filters: " << sharedFilter.bytes() << " bytes shared by every user, "
+              << userFilter.bytes() << " bytes per user, "
+              << 100.0 * falsePositives / words.size() << "% of misses got past them" << std::endl;
+
+    double separate = lookupsPerSecond(probes,
+        [&](const std::string& probe)
+        {
+            return base.contains(probe) || domain.contains(probe) || user.contains(probe);
+        });
+    std::cout << "three sets in turn: " << separate << " lookups/s" << std::endl;
+
+    double combined = lookupsPerSecond(probes,
+        [&](const std::string& probe)
+        {
+            return layered.contains(probe);
+        });
+    std::cout << "LayeredSet:         " << combined << " lookups/s" << std::endl;
+    return 0;
+}
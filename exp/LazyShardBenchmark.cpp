@@ -0,0 +1,159 @@
+// LazyShardBenchmark.cpp
+//
+// ICS 46 Spring 2015
+// Project #3: Set the Controls for the Heart of the Sun
+//
+// Compares building a whole dictionary up front against opening it as a
+// LazyShardedSet, for a sparse workload: a short document's worth of
+// distinct words, each looked up many times.  It reports how long each
+// takes to start and to answer the lookups, and how many shards (and how
+// much estimated memory) the lazy set ends up holding, then replays the
+// lookups again with a memory limit of a quarter of that and reports how
+// many shards were loaded again after being dropped.  It returns nonzero
+// if any lookup gives a different answer from the whole dictionary.
+
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include "Benchmarks.hpp"
+#include "HashSet.hpp"
+#include "LazyShardedSet.hpp"
+
+
+namespace
+{
+    const unsigned int DEFAULT_DISTINCT_WORDS = 100;
+    const unsigned int LOOKUP_COUNT = 200000;
+    const double EXPONENT = 1.0;
+    const unsigned int SEED = 46;
+
+
+    // looks up every probe in the set, returning how many were found and
+    // counting into mismatches any whose answer differs from expected
+    unsigned int lookUp(
+        const Set<std::string>& set, const std::vector<std::string>& probes,
+        const std::vector<bool>& expected, unsigned int& mismatches)
+    {
+        unsigned int found = 0;
+        for (unsigned int i = 0; i < probes.size(); i++)
+        {
+            bool result = set.contains(probes[i]);
+            if (result)
+            {
+                found++;
+            }
+            if (!expected.empty() && result != expected[i])
+            {
+                mismatches++;
+            }
+        }
+        return found;
+    }
+}
+
+
+int runLazyShardBenchmark(int argc, char** argv)
+{
+    if (argc < 2)
+    {
+        std::cout << "usage: exp lazy <word list> <shard file> [distinct words] [shards]" << std::endl;
+        return 1;
+    }
+
+    std::vector<std::string> words = loadWords(argv[0]);
+    if (words.empty())
+    {
+        std::cout << "no words could be read from " << argv[0] << std::endl;
+        return 1;
+    }
+
+    std::string shardPath = argv[1];
+    unsigned int distinct = argc >= 3 ? std::atoi(argv[2]) : DEFAULT_DISTINCT_WORDS;
+    unsigned int shardCount = argc >= 4 ? std::atoi(argv[3]) : LazyShardedSet::DEFAULT_SHARD_COUNT;
+
+    {
+        std::ofstream out{shardPath, std::ios::binary};
+        LazyShardedSet::write(out, words, shardCount);
+        if (!out)
+        {
+            std::cout << "couldn't write " << shardPath << std::endl;
+            return 1;
+        }
+    }
+
+    // a document's vocabulary: distinct words chosen at random, half of
+    // them misspelled, looked up with Zipf-distributed frequencies
+    std::mt19937 random{SEED};
+    std::vector<std::string> vocabulary;
+    for (unsigned int i = 0; i < distinct; i++)
+    {
+        std::string word = words[random() % words.size()];
+        vocabulary.push_back(i % 2 == 0 ? word : word + "#");
+    }
+    ZipfSampler sampler{vocabulary.size(), EXPONENT, SEED};
+    std::vector<std::string> probes;
+    for (unsigned int rank : sampler.sample(LOOKUP_COUNT))
+    {
+        probes.push_back(vocabulary[rank]);
+    }
+
+    std::cout << words.size() << " words, " << shardCount << " shards, "
+              << distinct << " distinct words in " << probes.size() << " lookups" << std::endl;
+
+    Stopwatch stopwatch;
+    std::vector<std::string> reloaded = loadWords(argv[0]);
+    HashSet<std::string> eager;
+    eager.addAll(reloaded.begin(), reloaded.end());
+    double eagerStart = stopwatch.seconds();
+    stopwatch.restart();
+    std::vector<bool> expected;
+    for (const std::string& probe : probes)
+    {
+        expected.push_back(eager.contains(probe));
+    }
+    double eagerLookups = stopwatch.seconds();
+
+    unsigned int mismatches = 0;
+    stopwatch.restart();
+    LazyShardedSet lazy{shardPath};
+    double lazyStart = stopwatch.seconds();
+    stopwatch.restart();
+    unsigned int found = lookUp(lazy, probes, expected, mismatches);
+    double lazyLookups = stopwatch.seconds();
+    std::size_t lazyBytes = lazy.residentBytes();
+
+    std::size_t wholeBytes = 0;
+    {
+        // the estimate the lazy set would give if every shard were loaded
+        LazyShardedSet everything{shardPath};
+        for (const std::string& word : words)
+        {
+            everything.contains(word);
+        }
+        wholeBytes = everything.residentBytes();
+    }
+
+    std::cout << "eager: started in " << eagerStart << " s, looked up in "
+              << eagerLookups << " s, ~" << wholeBytes << " bytes" << std::endl;
+    std::cout << "lazy:  started in " << lazyStart << " s, looked up in "
+              << lazyLookups << " s, ~" << lazyBytes << " bytes in "
+              << lazy.loadedShardCount() << " shards (" << found << " hits)" << std::endl;
+
+    LazyShardedSet capped{shardPath, lazyBytes / 4};
+    stopwatch.restart();
+    lookUp(capped, probes, expected, mismatches);
+    double cappedLookups = stopwatch.seconds();
+    std::cout << "capped at " << lazyBytes / 4 << " bytes: looked up in " << cappedLookups
+              << " s, " << capped.loadCount() << " loads, " << capped.loadedShardCount()
+              << " shards held" << std::endl;
+
+    if (mismatches != 0)
+    {
+        std::cout << mismatches << " lookups disagreed with the whole dictionary" << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,89 @@
+// ParallelBuildBenchmark.cpp
+//
+// ICS 46 Spring 2015
+// Project #3: Set the Controls for the Heart of the Sun
+//
+// Measures how long it takes to build a HashSet and an AVLSet from a
+// large list of words, one add() at a time and with addAll() at several
+// thread counts.  The words are generated, since real word lists don't
+// run to millions of entries; a fixed seed keeps runs comparable.
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include "AVLSet.hpp"
+#include "Benchmarks.hpp"
+#include "HashSet.hpp"
+#include "Parallel.hpp"
+
+
+namespace
+{
+    std::vector<std::string> generateWords(unsigned int count)
+    {
+        std::mt19937 engine{46};
+        std::uniform_int_distribution<int> length{4, 14};
+        std::uniform_int_distribution<int> letter{'A', 'Z'};
+        std::vector<std::string> words(count);
+        for (std::string& word : words)
+        {
+            word.resize(length(engine));
+            for (char& c : word)
+            {
+                c = static_cast<char>(letter(engine));
+            }
+        }
+        return words;
+    }
+
+
+    template <typename SetType>
+    void timeBuilds(const char* name, const std::vector<std::string>& words)
+    {
+        {
+            Stopwatch stopwatch;
+            SetType set;
+            for (const std::string& word : words)
+            {
+                set.add(word);
+            }
+            std::cout << "  " << name << " add():            "
+                      << stopwatch.seconds() << " s" << std::endl;
+        }
+
+        for (unsigned int threads = 1; threads <= defaultThreadCount(); threads *= 2)
+        {
+            Stopwatch stopwatch;
+            SetType set;
+            set.addAll(words.begin(), words.end(), threads);
+            std::cout << "  " << name << " addAll(), " << threads << " thread(s): "
+                      << stopwatch.seconds() << " s" << std::endl;
+        }
+    }
+}
+
+
+int runParallelBuildBenchmark(int argc, char** argv)
+{
+    std::vector<unsigned int> sizes;
+    for (int i = 0; i < argc; i++)
+    {
+        sizes.push_back(std::strtoul(argv[i], NULL, 10));
+    }
+    if (sizes.empty())
+    {
+        sizes = {1000000, 2000000, 5000000, 10000000};
+    }
+
+    for (unsigned int size : sizes)
+    {
+        std::vector<std::string> words = generateWords(size);
+        std::cout << size << " words" << std::endl;
+        timeBuilds<HashSet<std::string>>("HashSet", words);
+        timeBuilds<AVLSet<std::string>>("AVLSet ", words);
+    }
+    return 0;
+}
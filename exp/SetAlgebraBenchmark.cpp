@@ -0,0 +1,175 @@
+// SetAlgebraBenchmark.cpp
+//
+// ICS 46 Spring 2015
+// Project #3: Set the Controls for the Heart of the Sun
+//
+// Measures unionOf(), intersectionOf() and differenceOf() on two large
+// "releases" of a dictionary, against the obvious way of computing them
+// with one contains() call per element from outside the sets.  The word
+// list is multiplied into millions of words by appending numbers to it;
+// the new release drops a tenth of the old one's words and adds as many
+// new ones.  The AVLSets are merged, and the HashSets are probed a slice
+// of buckets per thread.  It returns nonzero if the results differ in
+// size from the contains()-based ones.
+
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "AVLSet.hpp"
+#include "Benchmarks.hpp"
+#include "HashSet.hpp"
+#include "SetAlgebra.hpp"
+
+
+namespace
+{
+    const unsigned int DEFAULT_COPIES = 20;
+
+
+    struct Sizes
+    {
+        unsigned int unionSize;
+        unsigned int intersectionSize;
+        unsigned int differenceSize;
+    };
+
+
+    // times the three operations on a and b, counting their results
+    template <typename SetType>
+    Sizes measure(const char* name, const SetType& a, const SetType& b, unsigned int threadCount)
+    {
+        Sizes sizes{0, 0, 0};
+        Stopwatch stopwatch;
+        unionOf(a, b, [&](const std::string&) { sizes.unionSize++; }, threadCount);
+        double unionSeconds = stopwatch.seconds();
+        stopwatch.restart();
+        intersectionOf(a, b, [&](const std::string&) { sizes.intersectionSize++; }, threadCount);
+        double intersectionSeconds = stopwatch.seconds();
+        stopwatch.restart();
+        differenceOf(a, b, [&](const std::string&) { sizes.differenceSize++; }, threadCount);
+        double differenceSeconds = stopwatch.seconds();
+
+        std::cout << name << ": union " << unionSeconds << " s, intersection "
+                  << intersectionSeconds << " s, difference " << differenceSeconds << " s" << std::endl;
+        return sizes;
+    }
+
+
+    // times the same operations done with one contains() per element
+    template <typename SetType>
+    Sizes measureByContains(const char* name, const SetType& a, const SetType& b)
+    {
+        Sizes sizes{0, 0, 0};
+        Stopwatch stopwatch;
+        sizes.unionSize = a.size();
+        for (const std::string& element : b)
+        {
+            if (!a.contains(element))
+            {
+                sizes.unionSize++;
+            }
+        }
+        double unionSeconds = stopwatch.seconds();
+        stopwatch.restart();
+        for (const std::string& element : a)
+        {
+            if (b.contains(element))
+            {
+                sizes.intersectionSize++;
+            }
+        }
+        double intersectionSeconds = stopwatch.seconds();
+        stopwatch.restart();
+        for (const std::string& element : a)
+        {
+            if (!b.contains(element))
+            {
+                sizes.differenceSize++;
+            }
+        }
+        double differenceSeconds = stopwatch.seconds();
+
+        std::cout << name << ": union " << unionSeconds << " s, intersection "
+                  << intersectionSeconds << " s, difference " << differenceSeconds << " s" << std::endl;
+        return sizes;
+    }
+
+
+    bool sameSizes(const Sizes& x, const Sizes& y)
+    {
+        return x.unionSize == y.unionSize
+            && x.intersectionSize == y.intersectionSize
+            && x.differenceSize == y.differenceSize;
+    }
+}
+
+
+int runSetAlgebraBenchmark(int argc, char** argv)
+{
+    if (argc < 1)
+    {
+        std::cout << "usage: exp algebra <word list> [copies] [threads]" << std::endl;
+        return 1;
+    }
+
+    std::vector<std::string> words = loadWords(argv[0]);
+    if (words.empty())
+    {
+        std::cout << "no words could be read from " << argv[0] << std::endl;
+        return 1;
+    }
+    unsigned int copies = argc >= 2 ? std::atoi(argv[1]) : DEFAULT_COPIES;
+    unsigned int threadCount = argc >= 3 ? std::atoi(argv[2]) : defaultThreadCount();
+
+    // word i of copy c is in the old release unless c == 0 and i is a
+    // multiple of 10, and in the new one unless c == 1 and it is
+    std::vector<std::string> oldRelease;
+    std::vector<std::string> newRelease;
+    for (unsigned int c = 0; c < copies; c++)
+    {
+        for (unsigned int i = 0; i < words.size(); i++)
+        {
+            std::string word = words[i] + std::to_string(c);
+            if (c != 0 || i % 10 != 0)
+            {
+                oldRelease.push_back(word);
+            }
+            if (c != 1 || i % 10 != 0)
+            {
+                newRelease.push_back(word);
+            }
+        }
+    }
+    std::cout << oldRelease.size() << " and " << newRelease.size() << " words, "
+              << threadCount << " threads" << std::endl;
+
+    unsigned int mismatches = 0;
+    {
+        AVLSet<std::string> a;
+        AVLSet<std::string> b;
+        a.addAll(oldRelease.begin(), oldRelease.end());
+        b.addAll(newRelease.begin(), newRelease.end());
+        Sizes merged = measure("AVLSet, merged          ", a, b, threadCount);
+        Sizes byContains = measureByContains("AVLSet, by contains()   ", a, b);
+        mismatches += !sameSizes(merged, byContains);
+    }
+    {
+        HashSet<std::string> a;
+        HashSet<std::string> b;
+        a.addAll(oldRelease.begin(), oldRelease.end());
+        b.addAll(newRelease.begin(), newRelease.end());
+        Sizes probed = measure("HashSet, bucket slices  ", a, b, threadCount);
+        Sizes byContains = measureByContains("HashSet, by contains()  ", a, b);
+        mismatches += !sameSizes(probed, byContains);
+        std::cout << "union " << probed.unionSize << ", intersection " << probed.intersectionSize
+                  << ", difference " << probed.differenceSize << " words" << std::endl;
+    }
+
+    if (mismatches != 0)
+    {
+        std::cout << "the results differ from the contains()-based ones" << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,125 @@
+// SplayBenchmark.cpp
+//
+// ICS 46 Spring 2015
+// Project #3: Set the Controls for the Heart of the Sun
+//
+// Compares a BSTSet whose adjustment is Splay against an AVLSet.  Both are
+// built by adding the words in sorted order, which would leave a BSTSet
+// without any adjustment as one long path (and take quadratic time to
+// build, which is why it isn't measured here).  Then each answers the
+// same lookups, first drawn from a Zipf distribution over the words in a
+// shuffled order, then drawn uniformly, all generated from the seed.
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include "AVLSet.hpp"
+#include "BSTSet.hpp"
+#include "Benchmarks.hpp"
+
+
+namespace
+{
+    const unsigned int DEFAULT_LOOKUP_COUNT = 1000000;
+    const double DEFAULT_EXPONENT = 1.0;
+    const unsigned int DEFAULT_SEED = 46;
+
+
+    template <typename SetType>
+    double lookupsPerSecond(
+        const SetType& set, const std::vector<std::string>& ranked,
+        const std::vector<unsigned int>& lookups)
+    {
+        unsigned int found = 0;
+        Stopwatch stopwatch;
+        for (unsigned int rank : lookups)
+        {
+            if (set.contains(ranked[rank]))
+            {
+                found++;
+            }
+        }
+        double elapsed = stopwatch.seconds();
+
+        // printed so the lookups can't be optimized away
+        std::cout << "    (" << found << " hits)" << std::endl;
+        return lookups.size() / elapsed;
+    }
+}
+
+
+int runSplayBenchmark(int argc, char** argv)
+{
+    if (argc < 1)
+    {
+        std::cout << "usage: exp splay <word list> [lookups] [exponent] [seed]" << std::endl;
+        return 1;
+    }
+
+    std::vector<std::string> words = loadWords(argv[0]);
+    if (words.empty())
+    {
+        std::cout << "no words could be read from " << argv[0] << std::endl;
+        return 1;
+    }
+    unsigned int lookupCount = (argc > 1) ? std::strtoul(argv[1], NULL, 10) : DEFAULT_LOOKUP_COUNT;
+    double exponent = (argc > 2) ? std::strtod(argv[2], NULL) : DEFAULT_EXPONENT;
+    unsigned int seed = (argc > 3) ? std::strtoul(argv[3], NULL, 10) : DEFAULT_SEED;
+
+    std::sort(words.begin(), words.end());
+    words.erase(std::unique(words.begin(), words.end()), words.end());
+
+    std::vector<std::string> ranked = words;
+    std::mt19937 shuffler{seed};
+    for (unsigned int i = ranked.size() - 1; i > 0; i--)
+    {
+        std::swap(ranked[i], ranked[shuffler() % (i + 1)]);
+    }
+    std::vector<unsigned int> skewed = ZipfSampler{ranked.size(), exponent, seed}.sample(lookupCount);
+    std::vector<unsigned int> uniform;
+    for (unsigned int i = 0; i < lookupCount; i++)
+    {
+        uniform.push_back(shuffler() % ranked.size());
+    }
+
+    std::cout << words.size() << " words, " << lookupCount << " lookups, exponent "
+              << exponent << ", seed " << seed << std::endl;
+
+    Stopwatch stopwatch;
+    BSTSet<std::string> splay;
+    splay.setAdjustment(BSTAdjustment::Splay);
+    for (const std::string& word : words)
+    {
+        splay.add(word);
+    }
+    double splayBuild = stopwatch.seconds();
+
+    stopwatch.restart();
+    AVLSet<std::string> avl;
+    for (const std::string& word : words)
+    {
+        avl.add(word);
+    }
+    double avlBuild = stopwatch.seconds();
+
+    std::cout << "sorted build" << std::endl;
+    std::cout << "  splay BSTSet: " << splayBuild << " s" << std::endl;
+    std::cout << "  AVLSet:       " << avlBuild << " s" << std::endl;
+
+    std::cout << "Zipf lookups" << std::endl;
+    double splaySkewed = lookupsPerSecond(splay, ranked, skewed);
+    std::cout << "  splay BSTSet: " << splaySkewed << " lookups/s" << std::endl;
+    double avlSkewed = lookupsPerSecond(avl, ranked, skewed);
+    std::cout << "  AVLSet:       " << avlSkewed << " lookups/s" << std::endl;
+
+    std::cout << "uniform lookups" << std::endl;
+    double splayUniform = lookupsPerSecond(splay, ranked, uniform);
+    std::cout << "  splay BSTSet: " << splayUniform << " lookups/s" << std::endl;
+    double avlUniform = lookupsPerSecond(avl, ranked, uniform);
+    std::cout << "  AVLSet:       " << avlUniform << " lookups/s" << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,144 @@
+// SuggestionTableTool.cpp
+//
+// ICS 46 Spring 2015
+// Project #3: Set the Controls for the Heart of the Sun
+//
+// Builds a SuggestionTable offline from a file of observed misspellings,
+// such as a query log with one query per line.  The distinct lines are
+// counted, the ones that are words in the dictionary are dropped, and the
+// most frequent of the rest (all of them, unless a limit is given) have
+// their suggestions found by a WordChecker, on as many threads as there
+// are hardware threads.  The table is then written to the output file,
+// mapped back in, and checked against the live suggestions, and the time
+// taken to answer the misspellings both ways is reported.
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "Benchmarks.hpp"
+#include "HashSet.hpp"
+#include "Parallel.hpp"
+#include "SuggestionBuffer.hpp"
+#include "SuggestionTable.hpp"
+#include "WordChecker.hpp"
+
+
+namespace
+{
+    // returns the distinct lines that aren't words, most frequent first,
+    // breaking ties by which was seen first
+    std::vector<std::string> rankMisspellings(
+        const std::vector<std::string>& lines, const WordChecker& checker, unsigned int limit)
+    {
+        std::unordered_map<std::string, unsigned int> counts;
+        std::vector<std::string> distinct;
+        for (const std::string& line : lines)
+        {
+            if (counts[line]++ == 0 && !checker.wordExists(line))
+            {
+                distinct.push_back(line);
+            }
+        }
+        std::stable_sort(distinct.begin(), distinct.end(),
+            [&](const std::string& a, const std::string& b)
+            {
+                return counts[a] > counts[b];
+            });
+        if (distinct.size() > limit)
+        {
+            distinct.resize(limit);
+        }
+        return distinct;
+    }
+}
+
+
+int runSuggestionTableTool(int argc, char** argv)
+{
+    if (argc < 3)
+    {
+        std::cout << "usage: exp table <dictionary> <misspellings> <output> [limit]" << std::endl;
+        return 1;
+    }
+
+    std::vector<std::string> words = loadWords(argv[0]);
+    std::vector<std::string> lines = loadWords(argv[1]);
+    std::string output = argv[2];
+    unsigned int limit = (argc > 3) ? std::strtoul(argv[3], NULL, 10) : lines.size();
+
+    HashSet<std::string> set;
+    set.addAll(words.begin(), words.end());
+    WordChecker checker{set};
+
+    std::vector<std::string> misspellings = rankMisspellings(lines, checker, limit);
+    std::vector<std::vector<std::string>> suggestions(misspellings.size());
+
+    Stopwatch stopwatch;
+    unsigned int threadCount = defaultThreadCount();
+    runInParallel(threadCount,
+        [&](unsigned int t)
+        {
+            SuggestionBuffer buffer;
+            unsigned int last = sliceBegin(misspellings.size(), threadCount, t + 1);
+            for (unsigned int i = sliceBegin(misspellings.size(), threadCount, t); i < last; i++)
+            {
+                checker.findSuggestions(misspellings[i], buffer);
+                suggestions[i] = buffer.toVector();
+            }
+        });
+    double generateTime = stopwatch.seconds();
+
+    {
+        std::ofstream out{output, std::ios::binary};
+        SuggestionTable::write(out, misspellings, suggestions);
+        if (!out)
+        {
+            std::cout << "couldn't write " << output << std::endl;
+            return 1;
+        }
+    }
+
+    std::cout << lines.size() << " lines, " << misspellings.size() << " misspellings, "
+              << "suggested on " << threadCount << " threads in " << generateTime << " s" << std::endl;
+
+    // map the table back in and check it against the live suggestions
+    stopwatch.restart();
+    SuggestionTable table{output};
+    double openTime = stopwatch.seconds();
+
+    WordChecker precomputed{set};
+    precomputed.setSuggestionTable(table);
+    SuggestionBuffer buffer;
+    unsigned int differences = 0;
+    stopwatch.restart();
+    for (unsigned int i = 0; i < misspellings.size(); i++)
+    {
+        precomputed.findSuggestions(misspellings[i], buffer);
+        if (buffer.toVector() != suggestions[i])
+        {
+            differences++;
+        }
+    }
+    double tableTime = stopwatch.seconds();
+
+    stopwatch.restart();
+    for (const std::string& misspelled : misspellings)
+    {
+        checker.findSuggestions(misspelled, buffer);
+    }
+    double liveTime = stopwatch.seconds();
+
+    std::ifstream written{output, std::ios::binary | std::ios::ate};
+    std::cout << "table: " << table.size() << " misspellings, " << written.tellg() << " bytes, "
+              << "mapped in " << openTime << " s" << std::endl;
+    std::cout << "answering every misspelling:" << std::endl;
+    std::cout << "  from the table: " << tableTime << " s" << std::endl;
+    std::cout << "  live:           " << liveTime << " s" << std::endl;
+    std::cout << differences << " misspellings got different suggestions" << std::endl;
+    return differences == 0 ? 0 : 1;
+}
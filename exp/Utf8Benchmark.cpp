@@ -0,0 +1,182 @@
+// Utf8Benchmark.cpp
+//
+// ICS 46 Spring 2015
+// Project #3: Set the Controls for the Heart of the Sun
+//
+// Measures findSuggestions() on UTF-8 words, a byte at a time and a
+// character at a time (with a Utf8Alphabet), and checks that pure ASCII
+// words aren't slowed down by having a Utf8Alphabet.
+//
+// The word list is lowercased, and a UTF-8 copy of it is made by
+// accenting some of its vowels; the dictionary is both of them together,
+// and its Utf8Alphabet is gathered from all of it, as a real dictionary's
+// would be, so the ASCII words are checked with every accented character
+// in the alphabet.  For each kind of word, one character in the middle
+// of each word is replaced with '#'; the replacement strategy should then
+// suggest the original word, which it can only do for a UTF-8 word when
+// it replaces whole characters.  It returns nonzero if a
+// character-at-a-time check misses any.
+
+#include <cctype>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "Alphabet.hpp"
+#include "BasicWordChecker.hpp"
+#include "Benchmarks.hpp"
+#include "HashSet.hpp"
+#include "SuggestionBuffer.hpp"
+#include "Utf8Alphabet.hpp"
+
+
+namespace
+{
+    // the number of words misspelled for each check
+    const unsigned int MISSPELLING_COUNT = 5000;
+
+    // the number of times the misspellings are checked while timing
+    const int ROUNDS = 5;
+
+
+    // returns the word lowercased, with every other vowel accented in UTF-8
+    // (a becomes U+00E1, e U+00E9, and so on; y becomes U+0177)
+    std::string accented(const std::string& word)
+    {
+        static const std::string vowels = "aeiouy";
+        static const char* const accents[] =
+        {
+            "\xC3\xA1", "\xC3\xA9", "\xC3\xAD", "\xC3\xB3", "\xC3\xBA", "\xC5\xB7"
+        };
+
+        std::string result;
+        bool accent = true;
+        for (char c : word)
+        {
+            c = std::tolower(static_cast<unsigned char>(c));
+            std::string::size_type vowel = vowels.find(c);
+            if (vowel != std::string::npos && accent)
+            {
+                result += accents[vowel];
+            }
+            else
+            {
+                result += c;
+            }
+            accent = accent != (vowel != std::string::npos);
+        }
+        return result;
+    }
+
+
+    // returns the word with its middle character replaced with '#'
+    std::string misspell(const std::string& word)
+    {
+        std::vector<unsigned int> starts;
+        unsigned int length = Utf8Alphabet::findCharacters(word, starts);
+        unsigned int middle = length / 2;
+        return word.substr(0, starts[middle]) + "#" + word.substr(starts[middle + 1]);
+    }
+
+
+    // checks misspellings of the first words against the dictionary,
+    // once to see which have their word suggested and then ROUNDS times
+    // more, reporting the time per word; returns the number of
+    // misspellings whose word wasn't suggested
+    unsigned int measure(
+        const char* name, const HashSet<std::string>& dictionary,
+        const std::vector<std::string>& words, const Utf8Alphabet* utf8)
+    {
+        BasicWordChecker<HashSet<std::string>, LowercaseAlphabet> checker{dictionary};
+        if (utf8 != NULL)
+        {
+            checker.setUtf8Alphabet(*utf8);
+        }
+
+        std::vector<std::string> misspellings;
+        for (unsigned int i = 0; i < words.size() && i < MISSPELLING_COUNT; i++)
+        {
+            misspellings.push_back(misspell(words[i]));
+        }
+
+        SuggestionBuffer buffer;
+        unsigned int missed = 0;
+        for (unsigned int i = 0; i < misspellings.size(); i++)
+        {
+            checker.findSuggestions(misspellings[i], buffer);
+            bool suggested = false;
+            for (const std::string& suggestion : buffer)
+            {
+                suggested = suggested || suggestion == words[i];
+            }
+            if (!suggested)
+            {
+                missed++;
+            }
+        }
+
+        Stopwatch stopwatch;
+        for (int round = 0; round < ROUNDS; round++)
+        {
+            for (const std::string& misspelling : misspellings)
+            {
+                checker.findSuggestions(misspelling, buffer);
+            }
+        }
+        double elapsed = stopwatch.seconds();
+
+        std::cout << name << ": " << elapsed * 1e6 / (misspellings.size() * ROUNDS) << " us/word, "
+                  << misspellings.size() - missed << " of " << misspellings.size()
+                  << " words suggested" << std::endl;
+        return missed;
+    }
+}
+
+
+int runUtf8Benchmark(int argc, char** argv)
+{
+    if (argc < 1)
+    {
+        std::cout << "usage: exp utf8 <word list>" << std::endl;
+        return 1;
+    }
+
+    std::vector<std::string> words = loadWords(argv[0]);
+    if (words.empty())
+    {
+        std::cout << "no words could be read from " << argv[0] << std::endl;
+        return 1;
+    }
+
+    std::vector<std::string> ascii;
+    std::vector<std::string> utf8Words;
+    for (const std::string& word : words)
+    {
+        std::string lower = word;
+        for (char& c : lower)
+        {
+            c = std::tolower(static_cast<unsigned char>(c));
+        }
+        ascii.push_back(lower);
+        utf8Words.push_back(accented(word));
+    }
+
+    std::vector<std::string> everything = ascii;
+    everything.insert(everything.end(), utf8Words.begin(), utf8Words.end());
+    HashSet<std::string> dictionary;
+    dictionary.addAll(everything.begin(), everything.end());
+    Utf8Alphabet utf8Alphabet{everything};
+    std::cout << words.size() << " words and their UTF-8 copies; the alphabet has "
+              << utf8Alphabet.size() << " non-ASCII characters" << std::endl;
+
+    measure("ASCII, no Utf8Alphabet      ", dictionary, ascii, NULL);
+    measure("ASCII, with a Utf8Alphabet  ", dictionary, ascii, &utf8Alphabet);
+    measure("UTF-8, a byte at a time     ", dictionary, utf8Words, NULL);
+    unsigned int missed = measure("UTF-8, a character at a time", dictionary, utf8Words, &utf8Alphabet);
+
+    if (missed != 0)
+    {
+        std::cout << missed << " UTF-8 misspellings didn't get their word suggested" << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,137 @@
+// WildcardBenchmark.cpp
+//
+// ICS 46 Spring 2015
+// Project #3: Set the Controls for the Heart of the Sun
+//
+// Compares finding suggestions with a WildcardIndex against finding them
+// with set lookups alone.  Each word in the list is misspelled twice, once
+// by replacing its middle character and once by deleting it, and the
+// suggestions for both misspellings are found by a BasicWordChecker with
+// and without the index.  It reports how many lookups the insertion and
+// replacement strategies made each way, the time taken, and the memory
+// used by the index, and checks that both found the same suggestions.
+// The check is repeated with a LowercaseAlphabet, whose letters aren't the
+// words' letters, so that the index's matches have to be filtered by the
+// alphabet to agree with the set's.
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include "BasicWordChecker.hpp"
+#include "Benchmarks.hpp"
+#include "HashSet.hpp"
+#include "WildcardIndex.hpp"
+
+
+namespace
+{
+    template <typename Checker>
+    double secondsToSuggest(
+        const Checker& checker, const std::vector<std::string>& misspellings,
+        std::vector<std::vector<std::string>>& suggestions)
+    {
+        SuggestionBuffer buffer;
+        suggestions.clear();
+        Stopwatch stopwatch;
+        for (const std::string& misspelled : misspellings)
+        {
+            checker.findSuggestions(misspelled, buffer);
+            suggestions.push_back(buffer.toVector());
+        }
+        return stopwatch.seconds();
+    }
+
+
+    unsigned int countDifferences(
+        const std::vector<std::vector<std::string>>& plainSuggestions,
+        const std::vector<std::vector<std::string>>& indexedSuggestions)
+    {
+        unsigned int differences = 0;
+        for (unsigned int i = 0; i < plainSuggestions.size(); i++)
+        {
+            if (plainSuggestions[i] != indexedSuggestions[i])
+            {
+                differences++;
+            }
+        }
+        return differences;
+    }
+}
+
+
+int runWildcardBenchmark(int argc, char** argv)
+{
+    if (argc < 1)
+    {
+        std::cout << "usage: exp wildcard <word list>" << std::endl;
+        return 1;
+    }
+
+    std::vector<std::string> words = loadWords(argv[0]);
+    if (words.empty())
+    {
+        std::cout << "no words could be read from " << argv[0] << std::endl;
+        return 1;
+    }
+
+    std::vector<std::string> misspellings;
+    unsigned long long setLookups = 0;
+    unsigned long long indexLookups = 0;
+    for (const std::string& word : words)
+    {
+        std::string replaced = word;
+        replaced[replaced.size() / 2] = '#';
+        std::string deleted = word;
+        deleted.erase(deleted.size() / 2, 1);
+        for (const std::string& misspelled : {replaced, deleted})
+        {
+            misspellings.push_back(misspelled);
+            // 26 per gap for insertion and 26 per character for replacement,
+            // against one per gap and one per character
+            setLookups += 26 * (misspelled.size() + 1) + 26 * misspelled.size();
+            indexLookups += (misspelled.size() + 1) + misspelled.size();
+        }
+    }
+
+    HashSet<std::string> set;
+    for (const std::string& word : words)
+    {
+        set.add(word);
+    }
+    Stopwatch stopwatch;
+    WildcardIndex index{words};
+    double buildTime = stopwatch.seconds();
+
+    BasicWordChecker<HashSet<std::string>> plain{set};
+    BasicWordChecker<HashSet<std::string>> indexed{set, index};
+
+    std::vector<std::vector<std::string>> plainSuggestions;
+    std::vector<std::vector<std::string>> indexedSuggestions;
+    double plainTime = secondsToSuggest(plain, misspellings, plainSuggestions);
+    double indexedTime = secondsToSuggest(indexed, misspellings, indexedSuggestions);
+
+    unsigned int differences = countDifferences(plainSuggestions, indexedSuggestions);
+
+    BasicWordChecker<HashSet<std::string>, LowercaseAlphabet> lowercasePlain{set};
+    BasicWordChecker<HashSet<std::string>, LowercaseAlphabet> lowercaseIndexed{set, index};
+    secondsToSuggest(lowercasePlain, misspellings, plainSuggestions);
+    secondsToSuggest(lowercaseIndexed, misspellings, indexedSuggestions);
+    unsigned int lowercaseDifferences = countDifferences(plainSuggestions, indexedSuggestions);
+
+    std::cout << index.size() << " words, " << misspellings.size() << " misspellings" << std::endl;
+    std::cout << "index: " << index.bytes() << " bytes, built in " << buildTime << " s" << std::endl;
+    std::cout << "insertion and replacement lookups:" << std::endl;
+    std::cout << "  set only:  " << setLookups << " ("
+              << static_cast<double>(setLookups) / misspellings.size() << " per word)" << std::endl;
+    std::cout << "  indexed:   " << indexLookups << " ("
+              << static_cast<double>(indexLookups) / misspellings.size() << " per word), "
+              << static_cast<double>(setLookups) / indexLookups << "x fewer" << std::endl;
+    std::cout << "findSuggestions() time:" << std::endl;
+    std::cout << "  set only:  " << plainTime << " s" << std::endl;
+    std::cout << "  indexed:   " << indexedTime << " s, "
+              << plainTime / indexedTime << "x faster" << std::endl;
+    std::cout << differences << " misspellings got different suggestions" << std::endl;
+    std::cout << lowercaseDifferences
+              << " misspellings got different suggestions with a LowercaseAlphabet" << std::endl;
+    return differences == 0 && lowercaseDifferences == 0 ? 0 : 1;
+}
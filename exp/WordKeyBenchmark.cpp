@@ -0,0 +1,133 @@
+// WordKeyBenchmark.cpp
+//
+// ICS 46 Spring 2015
+// Project #3: Set the Controls for the Heart of the Sun
+//
+// Compares sets of WordKeys against sets of std::strings: the lookups per
+// second of a HashSet and an AVLSet of each, probed with keys of their own
+// element type, and the time a BasicWordChecker over a HashSet of each
+// takes to find suggestions for misspellings (where the candidates for
+// the WordKey set are made directly as WordKeys, for words shorter than 16
+// characters).  Half of the lookups are words in the list and half are
+// words that aren't.
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include "AVLSet.hpp"
+#include "BasicWordChecker.hpp"
+#include "Benchmarks.hpp"
+#include "HashSet.hpp"
+#include "SuggestionBuffer.hpp"
+#include "WordKey.hpp"
+
+
+namespace
+{
+    const int ROUNDS = 10;
+
+    // the number of words misspelled for the findSuggestions() comparison
+    const unsigned int MISSPELLING_COUNT = 5000;
+
+
+    template <typename SetType, typename Key>
+    double lookupsPerSecond(const SetType& set, const std::vector<Key>& probes)
+    {
+        unsigned int found = 0;
+        Stopwatch stopwatch;
+        for (int round = 0; round < ROUNDS; round++)
+        {
+            for (const Key& probe : probes)
+            {
+                if (set.contains(probe))
+                {
+                    found++;
+                }
+            }
+        }
+        double elapsed = stopwatch.seconds();
+
+        // printed so the lookups can't be optimized away
+        std::cout << "    (" << found << " hits)" << std::endl;
+        return probes.size() * static_cast<double>(ROUNDS) / elapsed;
+    }
+
+
+    template <typename SetType>
+    double suggestionSeconds(const SetType& set, const std::vector<std::string>& misspellings)
+    {
+        BasicWordChecker<SetType> checker{set};
+        SuggestionBuffer buffer;
+        unsigned int suggestions = 0;
+        Stopwatch stopwatch;
+        for (const std::string& misspelling : misspellings)
+        {
+            checker.findSuggestions(misspelling, buffer);
+            suggestions += buffer.size();
+        }
+        double elapsed = stopwatch.seconds();
+
+        std::cout << "    (" << suggestions << " suggestions)" << std::endl;
+        return elapsed;
+    }
+}
+
+
+int runWordKeyBenchmark(int argc, char** argv)
+{
+    if (argc < 1)
+    {
+        std::cout << "usage: exp wordkey <word list>" << std::endl;
+        return 1;
+    }
+
+    std::vector<std::string> words = loadWords(argv[0]);
+    if (words.empty())
+    {
+        std::cout << "no words could be read from " << argv[0] << std::endl;
+        return 1;
+    }
+
+    std::vector<WordKey> keys{words.begin(), words.end()};
+    std::vector<std::string> probes;
+    for (const std::string& word : words)
+    {
+        probes.push_back(word);
+        probes.push_back(word + "#");
+    }
+    std::vector<WordKey> keyProbes{probes.begin(), probes.end()};
+
+    std::vector<std::string> misspellings;
+    for (unsigned int i = 0; i < words.size() && i < MISSPELLING_COUNT; i++)
+    {
+        std::string misspelled = words[i];
+        misspelled[misspelled.size() / 2] = '#';
+        misspellings.push_back(misspelled);
+    }
+
+    HashSet<std::string> stringHash;
+    HashSet<WordKey> keyHash;
+    AVLSet<std::string> stringTree;
+    AVLSet<WordKey> keyTree;
+    stringHash.addAll(words.begin(), words.end());
+    keyHash.addAll(keys.begin(), keys.end());
+    stringTree.addAll(words.begin(), words.end());
+    keyTree.addAll(keys.begin(), keys.end());
+
+    std::cout << words.size() << " words, " << probes.size() << " probes" << std::endl;
+    double stringHashRate = lookupsPerSecond(stringHash, probes);
+    std::cout << "HashSet<std::string>: " << stringHashRate << " lookups/s" << std::endl;
+    double keyHashRate = lookupsPerSecond(keyHash, keyProbes);
+    std::cout << "HashSet<WordKey>:     " << keyHashRate << " lookups/s" << std::endl;
+    double stringTreeRate = lookupsPerSecond(stringTree, probes);
+    std::cout << "AVLSet<std::string>:  " << stringTreeRate << " lookups/s" << std::endl;
+    double keyTreeRate = lookupsPerSecond(keyTree, keyProbes);
+    std::cout << "AVLSet<WordKey>:      " << keyTreeRate << " lookups/s" << std::endl;
+
+    std::cout << misspellings.size() << " misspellings" << std::endl;
+    double stringSeconds = suggestionSeconds(stringHash, misspellings);
+    std::cout << "findSuggestions, HashSet<std::string>: " << stringSeconds << " s" << std::endl;
+    double keySeconds = suggestionSeconds(keyHash, misspellings);
+    std::cout << "findSuggestions, HashSet<WordKey>:     " << keySeconds << " s" << std::endl;
+    return 0;
+}
@@ -0,0 +1,146 @@
+// ZipfProbeBenchmark.cpp
+//
+// ICS 46 Spring 2015
+// Project #3: Set the Controls for the Heart of the Sun
+//
+// Measures the mean number of elements a HashSet compares per lookup
+// when the lookups follow a Zipf distribution, as the words in real text
+// do, for each ChainOrder.  The words are ranked in a shuffled order and
+// the word of rank r is looked up with probability proportional to
+// 1 / r^s.  Everything is generated from the seed (see ZipfSampler), so
+// the same arguments replay the same lookups on any platform.
+//
+// The supplied frequencies are counted from a separate training stream,
+// generated from the next seed, so they're an estimate of the lookups
+// being measured rather than an exact record of them.
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include "Benchmarks.hpp"
+#include "HashSet.hpp"
+
+
+namespace
+{
+    const unsigned int DEFAULT_LOOKUP_COUNT = 1000000;
+    const double DEFAULT_EXPONENT = 1.0;
+    const unsigned int DEFAULT_SEED = 46;
+
+
+    // measures the mean probes per lookup, then the lookups per second, of
+    // replaying the lookups against the set; in ObservedFrequency order the
+    // set learns as it goes, so the probes are counted before each lookup
+    void replay(
+        const char* name, HashSet<std::string>& set,
+        const std::vector<std::string>& ranked, const std::vector<unsigned int>& lookups)
+    {
+        HashSet<std::string> copy{set};
+        unsigned long long probes = 0;
+        unsigned int firstProbeHits = 0;
+        for (unsigned int rank : lookups)
+        {
+            unsigned int p = set.probesFor(ranked[rank]);
+            probes += p;
+            if (p == 1)
+            {
+                firstProbeHits++;
+            }
+            set.contains(ranked[rank]);
+        }
+
+        // time the same lookups against a copy made before the replay, so
+        // the observed order starts out cold here too
+        unsigned int found = 0;
+        Stopwatch stopwatch;
+        for (unsigned int rank : lookups)
+        {
+            if (copy.contains(ranked[rank]))
+            {
+                found++;
+            }
+        }
+        double elapsed = stopwatch.seconds();
+
+        std::cout << name
+                  << static_cast<double>(probes) / lookups.size() << " probes/lookup, "
+                  << 100.0 * firstProbeHits / lookups.size() << "% on the first probe, "
+                  << lookups.size() / elapsed << " lookups/s"
+                  << " (" << found << " hits)" << std::endl;
+    }
+}
+
+
+int runZipfProbeBenchmark(int argc, char** argv)
+{
+    if (argc < 1)
+    {
+        std::cout << "usage: exp zipf <word list> [lookups] [exponent] [seed]" << std::endl;
+        return 1;
+    }
+
+    std::vector<std::string> words = loadWords(argv[0]);
+    if (words.empty())
+    {
+        std::cout << "no words could be read from " << argv[0] << std::endl;
+        return 1;
+    }
+    unsigned int lookupCount = (argc > 1) ? std::strtoul(argv[1], NULL, 10) : DEFAULT_LOOKUP_COUNT;
+    double exponent = (argc > 2) ? std::strtod(argv[2], NULL) : DEFAULT_EXPONENT;
+    unsigned int seed = (argc > 3) ? std::strtoul(argv[3], NULL, 10) : DEFAULT_SEED;
+
+    // rank the words in an order that has nothing to do with the order
+    // they're added in, which is the order they appear in the list
+    std::vector<std::string> ranked = words;
+    std::mt19937 shuffler{seed};
+    for (unsigned int i = ranked.size() - 1; i > 0; i--)
+    {
+        std::swap(ranked[i], ranked[shuffler() % (i + 1)]);
+    }
+
+    std::vector<unsigned int> lookups = ZipfSampler{ranked.size(), exponent, seed}.sample(lookupCount);
+    std::vector<unsigned int> training = ZipfSampler{ranked.size(), exponent, seed + 1}.sample(lookupCount);
+
+    std::cout << words.size() << " words, " << lookupCount << " lookups, exponent "
+              << exponent << ", seed " << seed << std::endl;
+
+    HashSet<std::string> insertion;
+    for (const std::string& word : words)
+    {
+        insertion.add(word);
+    }
+    replay("Insertion:         ", insertion, ranked, lookups);
+
+    HashSet<std::string> supplied;
+    supplied.setChainOrder(ChainOrder::SuppliedFrequency);
+    for (const std::string& word : words)
+    {
+        supplied.add(word);
+    }
+    std::vector<unsigned int> counts(ranked.size(), 0);
+    for (unsigned int rank : training)
+    {
+        counts[rank]++;
+    }
+    for (unsigned int rank = 0; rank < ranked.size(); rank++)
+    {
+        if (counts[rank] > 0)
+        {
+            supplied.add(ranked[rank], counts[rank]);
+        }
+    }
+    replay("SuppliedFrequency: ", supplied, ranked, lookups);
+
+    HashSet<std::string> observed;
+    observed.setChainOrder(ChainOrder::ObservedFrequency);
+    for (const std::string& word : words)
+    {
+        observed.add(word);
+    }
+    replay("ObservedFrequency: ", observed, ranked, lookups);
+
+    return 0;
+}
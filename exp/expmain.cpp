@@ -6,12 +6,94 @@
 // Do whatever you'd like here.  This is intended to allow you to experiment
 // with your code, outside of the context of the broader program or Google
 // Test.
+//
+// The first command-line argument names a benchmark to run (see
+// Benchmarks.hpp); the remaining arguments are passed along to it.
+
+#include <iostream>
+#include <string>
+#include "Benchmarks.hpp"
 
 
-int main()
+int main(int argc, char** argv)
 {
+    if (argc < 2)
+    {
+        std::cout << "usage: exp <benchmark> [arguments...]" << std::endl;
+        std::cout << "benchmarks: hash, build, contention, latency, zipf, splay, wildcard, layered, table, lazy, frontcoded, wordkey, alphabet, utf8, algebra, join, bulkload" << std::endl;
+        return 1;
+    }
 
+    std::string benchmark = argv[1];
+    if (benchmark == "hash")
+    {
+        return runHashPolicyBenchmark(argc - 2, argv + 2);
+    }
+    else if (benchmark == "build")
+    {
+        return runParallelBuildBenchmark(argc - 2, argv + 2);
+    }
+    else if (benchmark == "contention")
+    {
+        return runContentionBenchmark(argc - 2, argv + 2);
+    }
+    else if (benchmark == "latency")
+    {
+        return runLatencyReport(argc - 2, argv + 2);
+    }
+    else if (benchmark == "zipf")
+    {
+        return runZipfProbeBenchmark(argc - 2, argv + 2);
+    }
+    else if (benchmark == "splay")
+    {
+        return runSplayBenchmark(argc - 2, argv + 2);
+    }
+    else if (benchmark == "wildcard")
+    {
+        return runWildcardBenchmark(argc - 2, argv + 2);
+    }
+    else if (benchmark == "layered")
+    {
+        return runLayeredBenchmark(argc - 2, argv + 2);
+    }
+    else if (benchmark == "table")
+    {
+        return runSuggestionTableTool(argc - 2, argv + 2);
+    }
+    else if (benchmark == "lazy")
+    {
+        return runLazyShardBenchmark(argc - 2, argv + 2);
+    }
+    else if (benchmark == "frontcoded")
+    {
+        return runFrontCodedBenchmark(argc - 2, argv + 2);
+    }
+    else if (benchmark == "wordkey")
+    {
+        return runWordKeyBenchmark(argc - 2, argv + 2);
+    }
+    else if (benchmark == "alphabet")
+    {
+        return runAlphabetBenchmark(argc - 2, argv + 2);
+    }
+    else if (benchmark == "utf8")
+    {
+        return runUtf8Benchmark(argc - 2, argv + 2);
+    }
+    else if (benchmark == "algebra")
+    {
+        return runSetAlgebraBenchmark(argc - 2, argv + 2);
+    }
+    else if (benchmark == "join")
+    {
+        return runJoinBenchmark(argc - 2, argv + 2);
+    }
+    else if (benchmark == "bulkload")
+    {
+        return runBulkLoadBenchmark(argc - 2, argv + 2);
+    }
 
-    return 0;
+    std::cout << "unknown benchmark: " << benchmark << std::endl;
+    return 1;
 }
-
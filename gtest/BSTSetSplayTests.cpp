@@ -0,0 +1,66 @@
+// BSTSetSplayTests.cpp
+//
+// ICS 46 Spring 2015
+// Project #3: Set the Controls for the Heart of the Sun
+//
+// Checks that a BSTSet that has grown into a very tall tree, as one in
+// Splay mode does when its words are added in sorted order, can still be
+// copied and destroyed without running out of stack.
+
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+#include "BSTSet.hpp"
+
+
+namespace
+{
+    // enough nodes that recursing once per node would overflow the stack
+    const unsigned int CHAIN_LENGTH = 300000;
+
+
+    // adds CHAIN_LENGTH words in ascending order, so that splaying each
+    // one to the root leaves the tree a chain of left children
+    void addSortedWords(BSTSet<std::string>& set)
+    {
+        for (unsigned int i = 0; i < CHAIN_LENGTH; i++)
+        {
+            set.add("w" + std::to_string(1000000 + i));
+        }
+    }
+}
+
+
+TEST(BSTSetSplayTests, sortedAddsInSplayModeCanBeDestroyed)
+{
+    {
+        BSTSet<std::string> set;
+        set.setAdjustment(BSTAdjustment::Splay);
+        addSortedWords(set);
+        ASSERT_EQ(CHAIN_LENGTH, set.size());
+    }
+    SUCCEED();
+}
+
+
+TEST(BSTSetSplayTests, sortedAddsInSplayModeCanBeCopied)
+{
+    BSTSet<std::string> set;
+    set.setAdjustment(BSTAdjustment::Splay);
+    addSortedWords(set);
+
+    BSTSet<std::string> copy{set};
+    ASSERT_EQ(CHAIN_LENGTH, copy.size());
+
+    std::vector<std::string> original;
+    std::vector<std::string> copied;
+    set.dumpSorted(std::back_inserter(original));
+    copy.dumpSorted(std::back_inserter(copied));
+    ASSERT_EQ(original, copied);
+    ASSERT_EQ(CHAIN_LENGTH, copied.size());
+
+    BSTSet<std::string> assigned;
+    assigned = copy;
+    ASSERT_TRUE(assigned.contains("w1000000"));
+    ASSERT_TRUE(assigned.contains("w" + std::to_string(1000000 + CHAIN_LENGTH - 1)));
+}
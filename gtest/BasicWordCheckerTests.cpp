@@ -0,0 +1,74 @@
+// BasicWordCheckerTests.cpp
+//
+// ICS 46 Spring 2015
+// Project #3: Set the Controls for the Heart of the Sun
+//
+// Checks that BasicWordChecker makes the same suggestions, in the same
+// order, as the original WordChecker did: the insertion strategy's last
+// position tries the word itself, and a split is looked up as one word
+// with a space in it.
+
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+#include "AVLSet.hpp"
+#include "BasicWordChecker.hpp"
+#include "HashSet.hpp"
+#include "WordKey.hpp"
+
+
+namespace
+{
+    template <typename SetType>
+    SetType makeSet()
+    {
+        SetType set;
+        for (const char* word : {"BACD", "XABCD", "ABXCD", "ACD", "ABCDE", "ABCX", "AB CD", "ABC", "D"})
+        {
+            set.add(std::string{word});
+        }
+        return set;
+    }
+
+
+    const std::vector<std::string> ABCD_SUGGESTIONS{
+        "BACD", "XABCD", "ABXCD", "ACD", "ABC", "ABCX", "AB CD"};
+}
+
+
+TEST(BasicWordCheckerTests, suggestionsMatchOriginalOrder)
+{
+    HashSet<std::string> set = makeSet<HashSet<std::string>>();
+    BasicWordChecker<HashSet<std::string>> checker{set};
+    std::vector<std::string> suggestions = checker.findSuggestions("ABCD");
+    ASSERT_EQ(ABCD_SUGGESTIONS, suggestions);
+}
+
+
+TEST(BasicWordCheckerTests, abstractSetGivesSameSuggestions)
+{
+    AVLSet<std::string> set = makeSet<AVLSet<std::string>>();
+    BasicWordChecker<Set<std::string>> checker{set};
+    ASSERT_EQ(ABCD_SUGGESTIONS, checker.findSuggestions("ABCD"));
+}
+
+
+TEST(BasicWordCheckerTests, wordKeySetGivesSameSuggestions)
+{
+    // short words' candidates are made directly as WordKeys, and longer
+    // ones' are converted from strings; both have to match
+    HashSet<WordKey> set = makeSet<HashSet<WordKey>>();
+    set.add(std::string{"ABCDEFGHIJKLMNOP"});
+    BasicWordChecker<HashSet<WordKey>> checker{set};
+    ASSERT_EQ(ABCD_SUGGESTIONS, checker.findSuggestions("ABCD"));
+    ASSERT_EQ((std::vector<std::string>{"ABCDEFGHIJKLMNOP"}), checker.findSuggestions("ABCDEFGHIJKLMNP"));
+    ASSERT_EQ((std::vector<std::string>{"ABCDEFGHIJKLMNOP"}), checker.findSuggestions("ABCDEFGHIJKLMNOPQ"));
+}
+
+
+TEST(BasicWordCheckerTests, insertionTriesWordItselfRatherThanAppending)
+{
+    HashSet<std::string> set = makeSet<HashSet<std::string>>();
+    BasicWordChecker<HashSet<std::string>> checker{set};
+    ASSERT_EQ((std::vector<std::string>{"ABC"}), checker.findSuggestions("ABC"));
+}
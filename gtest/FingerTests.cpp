@@ -0,0 +1,131 @@
+// FingerTests.cpp
+//
+// ICS 46 Spring 2015
+// Project #3: Set the Controls for the Heart of the Sun
+//
+// Checks that a Finger notices when the set it searches has been
+// rebuilt or had its nodes replaced, even when the set's size hasn't
+// changed, and starts over rather than following a stale path.
+
+#include <gtest/gtest.h>
+#include <string>
+#include <utility>
+#include <vector>
+#include "AVLSet.hpp"
+#include "SkipListSet.hpp"
+
+
+namespace
+{
+    std::vector<std::string> makeWords()
+    {
+        std::vector<std::string> words;
+        for (unsigned int i = 0; i < 500; i++)
+        {
+            words.push_back("w" + std::to_string(1000 + i));
+        }
+        return words;
+    }
+
+
+    // searches for every word with the Finger, so that its path ends up
+    // deep in the set
+    template <typename FingerType>
+    void searchAll(FingerType& finger, const std::vector<std::string>& words)
+    {
+        for (const std::string& word : words)
+        {
+            ASSERT_TRUE(finger.contains(word));
+        }
+        ASSERT_FALSE(finger.contains("x"));
+    }
+}
+
+
+TEST(FingerTests, avlFingerSurvivesAddAllOfTheSameWords)
+{
+    std::vector<std::string> words = makeWords();
+    AVLSet<std::string> set;
+    set.addAll(words.begin(), words.end());
+    AVLSet<std::string>::Finger finger{set};
+    searchAll(finger, words);
+
+    // every node is freed and rebuilt, though the size stays the same
+    set.addAll(words.begin(), words.end());
+    ASSERT_EQ(words.size(), set.size());
+    searchAll(finger, words);
+}
+
+
+TEST(FingerTests, avlFingerSurvivesUnionsThatAddNothing)
+{
+    std::vector<std::string> words = makeWords();
+    AVLSet<std::string> set;
+    set.addAll(words.begin(), words.end());
+    AVLSet<std::string>::Finger finger{set};
+    searchAll(finger, words);
+
+    AVLSet<std::string> same;
+    same.addAll(words.begin(), words.end());
+    set.unionWith(std::move(same));
+    ASSERT_EQ(words.size(), set.size());
+    searchAll(finger, words);
+
+    set.insertAll(words.begin(), words.end());
+    ASSERT_EQ(words.size(), set.size());
+    searchAll(finger, words);
+}
+
+
+TEST(FingerTests, avlFingerSurvivesBuildFromSorted)
+{
+    std::vector<std::string> words = makeWords();
+    AVLSet<std::string> set;
+    for (const std::string& word : words)
+    {
+        set.add(word);
+    }
+    AVLSet<std::string>::Finger finger{set};
+    searchAll(finger, words);
+
+    set.buildFromSorted(words.begin(), words.end());
+    searchAll(finger, words);
+}
+
+
+TEST(FingerTests, avlFingerSurvivesAssignmentOfTheSameSize)
+{
+    std::vector<std::string> words = makeWords();
+    AVLSet<std::string> set;
+    set.addAll(words.begin(), words.end());
+    AVLSet<std::string>::Finger finger{set};
+    searchAll(finger, words);
+
+    AVLSet<std::string> other;
+    other.addAll(words.begin(), words.end());
+    set = std::move(other);
+    searchAll(finger, words);
+
+    other = set;
+    set = other;
+    searchAll(finger, words);
+}
+
+
+TEST(FingerTests, skipListFingerSurvivesBuildFromSorted)
+{
+    std::vector<std::string> words = makeWords();
+    SkipListSet<std::string> set;
+    set.buildFromSorted(words.begin(), words.end());
+    SkipListSet<std::string>::Finger finger{set};
+    searchAll(finger, words);
+
+    // the same words give the same number of levels, all of them new
+    set.buildFromSorted(words.begin(), words.end());
+    searchAll(finger, words);
+
+    SkipListSet<std::string> other;
+    other.buildFromSorted(words.begin(), words.end());
+    set = std::move(other);
+    searchAll(finger, words);
+}
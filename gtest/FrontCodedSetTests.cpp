@@ -0,0 +1,144 @@
+// FrontCodedSetTests.cpp
+//
+// ICS 46 Spring 2015
+// Project #3: Set the Controls for the Heart of the Sun
+//
+// Checks that a FrontCodedSet, with each of the block sizes it allows,
+// contains exactly the words it was built from, paying particular
+// attention to the first and last words of each block, to words with
+// bytes of 0x80 and above, and to words long enough that their lengths
+// take more than one byte to encode.
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "FrontCodedSet.hpp"
+
+
+namespace
+{
+    const unsigned int BLOCK_SIZES[] = {
+        FrontCodedSet::MIN_BLOCK_SIZE, FrontCodedSet::DEFAULT_BLOCK_SIZE, FrontCodedSet::MAX_BLOCK_SIZE};
+
+
+    // words that share long prefixes, as a front-coded set is meant for,
+    // some with bytes of 0x80 and above and some longer than 128
+    // characters, sorted and without duplicates
+    std::vector<std::string> makeWords()
+    {
+        std::mt19937 random{46};
+        const std::string letters{"ab\x7f\x80\xc3\xff"};
+        const std::string longPrefix(200, 'p');
+
+        std::vector<std::string> words;
+        for (unsigned int i = 0; i < 3000; i++)
+        {
+            std::string word = (i % 5 == 0 ? longPrefix : std::string{});
+            unsigned int length = 1 + random() % (i % 7 == 0 ? 300 : 8);
+            for (unsigned int j = 0; j < length; j++)
+            {
+                word += letters[random() % letters.size()];
+            }
+            words.push_back(word);
+        }
+        std::sort(words.begin(), words.end());
+        words.erase(std::unique(words.begin(), words.end()), words.end());
+        return words;
+    }
+
+
+    // the strings just around word that aren't in words: word with a
+    // character dropped from the end or added to it, and word with its
+    // last character changed to its neighbours
+    std::vector<std::string> neighboursOf(const std::string& word)
+    {
+        std::vector<std::string> neighbours{word.substr(0, word.size() - 1), word + '\0', word + '\xff'};
+        std::string changed = word;
+        changed.back()++;
+        neighbours.push_back(changed);
+        changed.back() -= 2;
+        neighbours.push_back(changed);
+        return neighbours;
+    }
+}
+
+
+TEST(FrontCodedSetTests, containsEveryWordWithEachBlockSize)
+{
+    std::vector<std::string> words = makeWords();
+    std::vector<std::string> shuffled = words;
+    std::shuffle(shuffled.begin(), shuffled.end(), std::mt19937{46});
+    shuffled.insert(shuffled.end(), words.begin(), words.begin() + 100);
+
+    for (unsigned int blockSize : BLOCK_SIZES)
+    {
+        FrontCodedSet set{shuffled, blockSize};
+        ASSERT_EQ(blockSize, set.blockSize());
+        ASSERT_EQ(words.size(), set.size());
+        for (const std::string& word : words)
+        {
+            ASSERT_TRUE(set.contains(word)) << blockSize;
+        }
+    }
+}
+
+
+TEST(FrontCodedSetTests, blockBoundariesAreFoundAndTheirNeighboursArent)
+{
+    std::vector<std::string> words = makeWords();
+    for (unsigned int blockSize : BLOCK_SIZES)
+    {
+        FrontCodedSet set{words, blockSize};
+        for (std::size_t first = 0; first < words.size(); first += blockSize)
+        {
+            std::size_t last = std::min(first + blockSize, words.size()) - 1;
+            for (std::size_t i : {first, last})
+            {
+                ASSERT_TRUE(set.contains(words[i])) << blockSize << " " << i;
+                for (const std::string& neighbour : neighboursOf(words[i]))
+                {
+                    bool expected = std::binary_search(words.begin(), words.end(), neighbour);
+                    ASSERT_EQ(expected, set.contains(neighbour)) << blockSize << " " << i;
+                }
+            }
+        }
+    }
+}
+
+
+TEST(FrontCodedSetTests, wordsOutsideTheRangeArentFound)
+{
+    std::vector<std::string> words = makeWords();
+    FrontCodedSet set{words};
+    ASSERT_FALSE(set.contains(""));
+    ASSERT_FALSE(set.contains(std::string(1, '\0')));
+    ASSERT_FALSE(set.contains(words.back() + "a"));
+    ASSERT_FALSE(set.contains(std::string(400, '\xff')));
+}
+
+
+TEST(FrontCodedSetTests, emptySetContainsNothing)
+{
+    FrontCodedSet set{std::vector<std::string>{}};
+    ASSERT_EQ(0u, set.size());
+    ASSERT_FALSE(set.contains(""));
+    ASSERT_FALSE(set.contains("a"));
+}
+
+
+TEST(FrontCodedSetTests, blockSizeOutOfRangeThrows)
+{
+    std::vector<std::string> words{"a", "b"};
+    ASSERT_THROW(FrontCodedSet(words, FrontCodedSet::MIN_BLOCK_SIZE - 1), std::invalid_argument);
+    ASSERT_THROW(FrontCodedSet(words, FrontCodedSet::MAX_BLOCK_SIZE + 1), std::invalid_argument);
+}
+
+
+TEST(FrontCodedSetTests, addThrows)
+{
+    FrontCodedSet set{std::vector<std::string>{"a"}};
+    ASSERT_THROW(set.add("b"), std::logic_error);
+}
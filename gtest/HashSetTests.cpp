@@ -0,0 +1,74 @@
+// HashSetTests.cpp
+//
+// ICS 46 Spring 2015
+// Project #3: Set the Controls for the Heart of the Sun
+//
+// Checks that a HashSet given a hash function, the way the original
+// interface worked, hashes with it, whichever policy the HashSet has, and
+// that its copies do too.
+
+#include <gtest/gtest.h>
+#include <string>
+#include "HashPolicy.hpp"
+#include "HashSet.hpp"
+
+
+namespace
+{
+    unsigned int calls = 0;
+
+
+    unsigned int countingHash(const std::string& element)
+    {
+        calls++;
+        return element.size();
+    }
+}
+
+
+TEST(HashSetTests, defaultPolicySetHashesWithGivenFunction)
+{
+    HashSet<std::string> set{countingHash};
+    calls = 0;
+    set.add("one");
+    set.add("three");
+    ASSERT_TRUE(set.contains("one"));
+    ASSERT_FALSE(set.contains("two"));
+    ASSERT_EQ(4u, calls);
+}
+
+
+TEST(HashSetTests, copyOfDefaultPolicySetKeepsGivenFunction)
+{
+    HashSet<std::string> set{countingHash};
+    set.add("one");
+    HashSet<std::string> copy{set};
+    calls = 0;
+    ASSERT_TRUE(copy.contains("one"));
+    ASSERT_EQ(1u, calls);
+}
+
+
+TEST(HashSetTests, functionHashSetHashesWithGivenFunction)
+{
+    HashSet<std::string, FunctionHash<std::string>> set{countingHash};
+    calls = 0;
+    set.add("one");
+    ASSERT_TRUE(set.contains("one"));
+    ASSERT_EQ(2u, calls);
+}
+
+
+TEST(HashSetTests, constantHashKeepsEveryElement)
+{
+    HashSet<std::string> set{[](const std::string&) { return 0u; }};
+    for (unsigned int i = 0; i < 100; i++)
+    {
+        set.add(std::to_string(i));
+    }
+    ASSERT_EQ(100u, set.size());
+    for (unsigned int i = 0; i < 100; i++)
+    {
+        ASSERT_TRUE(set.contains(std::to_string(i)));
+    }
+}
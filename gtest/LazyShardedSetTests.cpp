@@ -0,0 +1,106 @@
+// LazyShardedSetTests.cpp
+//
+// ICS 46 Spring 2015
+// Project #3: Set the Controls for the Heart of the Sun
+//
+// Checks that a LazyShardedSet looked up by several threads at once
+// answers every lookup correctly, loads each shard once when nothing is
+// dropped, and keeps answering correctly while a small memory limit has
+// shards dropped and loaded again underneath the lookups.
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "LazyShardedSet.hpp"
+
+
+namespace
+{
+    const unsigned int THREAD_COUNT = 4;
+    const unsigned int SHARD_COUNT = 32;
+
+
+    std::vector<std::string> makeWords()
+    {
+        std::vector<std::string> words;
+        for (unsigned int i = 0; i < 5000; i++)
+        {
+            words.push_back("w" + std::to_string(i));
+        }
+        return words;
+    }
+
+
+    std::string writeShards(const std::vector<std::string>& words)
+    {
+        std::string path = ::testing::TempDir() + "LazyShardedSetTests.shards";
+        std::ofstream out{path, std::ios::binary};
+        LazyShardedSet::write(out, words, SHARD_COUNT);
+        return path;
+    }
+
+
+    // has every thread look up every word and a misspelling of it, each
+    // thread starting at a different word, and returns the number of
+    // wrong answers
+    unsigned int lookUpFromThreads(const LazyShardedSet& set, const std::vector<std::string>& words)
+    {
+        std::atomic<unsigned int> wrong{0};
+        std::vector<std::thread> threads;
+        for (unsigned int t = 0; t < THREAD_COUNT; t++)
+        {
+            threads.emplace_back(
+                [&, t]()
+                {
+                    for (unsigned int i = 0; i < words.size(); i++)
+                    {
+                        const std::string& word = words[(i + t * words.size() / THREAD_COUNT) % words.size()];
+                        if (!set.contains(word) || set.contains(word + "#"))
+                        {
+                            wrong++;
+                        }
+                    }
+                });
+        }
+        for (std::thread& thread : threads)
+        {
+            thread.join();
+        }
+        return wrong.load();
+    }
+}
+
+
+TEST(LazyShardedSetTests, threadsLoadEachShardOnce)
+{
+    std::vector<std::string> words = makeWords();
+    LazyShardedSet set{writeShards(words)};
+
+    ASSERT_EQ(0u, lookUpFromThreads(set, words));
+    ASSERT_EQ(SHARD_COUNT, set.loadedShardCount());
+    ASSERT_EQ(SHARD_COUNT, set.loadCount());
+}
+
+
+TEST(LazyShardedSetTests, threadsGetRightAnswersWhileShardsAreDropped)
+{
+    std::vector<std::string> words = makeWords();
+    std::string path = writeShards(words);
+    std::size_t wholeBytes;
+    {
+        LazyShardedSet everything{path};
+        for (const std::string& word : words)
+        {
+            everything.contains(word);
+        }
+        wholeBytes = everything.residentBytes();
+    }
+
+    LazyShardedSet set{path, wholeBytes / 8};
+    ASSERT_EQ(0u, lookUpFromThreads(set, words));
+    ASSERT_LT(SHARD_COUNT, set.loadCount());
+    ASSERT_GE(wholeBytes / 8, set.residentBytes());
+}
@@ -0,0 +1,220 @@
+// PerfectHashSetTests.cpp
+//
+// ICS 46 Spring 2015
+// Project #3: Set the Controls for the Heart of the Sun
+//
+// Checks that a PerfectHashSet finds exactly the words it was built from,
+// both as built and after being written to a stream and read back, and
+// that reading one back rejects a stream that's been cut short or
+// corrupted, rather than building a set whose lookups read out of bounds.
+
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <cstring>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "PerfectHashSet.hpp"
+
+
+namespace
+{
+    // where the fields that precede the saved vectors begin
+    const std::size_t NUMBER_OF_ELEMENTS_AT = 16;
+    const std::size_t BUCKET_COUNT_AT = 20;
+    const std::size_t DENSE_BUCKET_COUNT_AT = 24;
+    const std::size_t TABLE_SIZE_AT = 28;
+    const std::size_t PILOT_WIDTH_AT = 32;
+    const std::size_t PILOTS_AT = 36;
+
+
+    std::vector<std::string> makeWords(unsigned int count)
+    {
+        std::vector<std::string> words;
+        for (unsigned int i = 0; i < count; i++)
+        {
+            words.push_back("w" + std::to_string(i * 7919));
+        }
+        return words;
+    }
+
+
+    std::string save(const PerfectHashSet& set)
+    {
+        std::ostringstream out;
+        set.write(out);
+        return out.str();
+    }
+
+
+    PerfectHashSet load(const std::string& bytes)
+    {
+        std::istringstream in{bytes};
+        return PerfectHashSet{in};
+    }
+
+
+    template <typename Value>
+    Value readAt(const std::string& bytes, std::size_t at)
+    {
+        Value value;
+        std::memcpy(&value, bytes.data() + at, sizeof(value));
+        return value;
+    }
+
+
+    template <typename Value>
+    std::string writeAt(std::string bytes, std::size_t at, Value value)
+    {
+        std::memcpy(&bytes[at], &value, sizeof(value));
+        return bytes;
+    }
+
+
+    // returns where each saved vector begins: its size, then its elements
+    std::vector<std::size_t> vectorPositions(const std::string& bytes)
+    {
+        const std::size_t elementSizes[] = {8, 4, 4, 1};
+        std::vector<std::size_t> positions;
+        std::size_t at = PILOTS_AT;
+        for (std::size_t elementSize : elementSizes)
+        {
+            positions.push_back(at);
+            at += 8 + readAt<std::uint64_t>(bytes, at) * elementSize;
+        }
+        return positions;
+    }
+
+
+    void checkContainsExactly(const PerfectHashSet& set, const std::vector<std::string>& words)
+    {
+        ASSERT_EQ(words.size(), set.size());
+        for (const std::string& word : words)
+        {
+            ASSERT_TRUE(set.contains(word));
+            ASSERT_FALSE(set.contains(word + "x"));
+        }
+        ASSERT_FALSE(set.contains(""));
+    }
+}
+
+
+TEST(PerfectHashSetTests, containsExactlyItsWords)
+{
+    std::vector<std::string> words = makeWords(5000);
+    std::vector<std::string> withDuplicates = words;
+    withDuplicates.insert(withDuplicates.end(), words.begin(), words.begin() + 100);
+
+    PerfectHashSet set{withDuplicates};
+    checkContainsExactly(set, words);
+}
+
+
+TEST(PerfectHashSetTests, emptySetContainsNothing)
+{
+    PerfectHashSet set{std::vector<std::string>{}};
+    ASSERT_EQ(0u, set.size());
+    ASSERT_FALSE(set.contains("w"));
+    ASSERT_EQ(0u, load(save(set)).size());
+}
+
+
+TEST(PerfectHashSetTests, addThrows)
+{
+    PerfectHashSet set{makeWords(10)};
+    ASSERT_THROW(set.add("new"), std::logic_error);
+}
+
+
+TEST(PerfectHashSetTests, savedSetCanBeReadBack)
+{
+    std::vector<std::string> words = makeWords(5000);
+    PerfectHashSet set{words};
+    std::string bytes = save(set);
+
+    PerfectHashSet loaded = load(bytes);
+    checkContainsExactly(loaded, words);
+    ASSERT_EQ(set.indexBits(), loaded.indexBits());
+    ASSERT_EQ(bytes, save(loaded));
+}
+
+
+TEST(PerfectHashSetTests, truncatedStreamIsRejected)
+{
+    std::string bytes = save(PerfectHashSet{makeWords(200)});
+    for (std::size_t length = 0; length < bytes.size(); length++)
+    {
+        ASSERT_THROW(load(bytes.substr(0, length)), std::runtime_error) << length;
+    }
+}
+
+
+TEST(PerfectHashSetTests, inconsistentHeaderIsRejected)
+{
+    std::string bytes = save(PerfectHashSet{makeWords(200)});
+    std::uint32_t n = readAt<std::uint32_t>(bytes, NUMBER_OF_ELEMENTS_AT);
+    std::uint32_t buckets = readAt<std::uint32_t>(bytes, BUCKET_COUNT_AT);
+
+    ASSERT_THROW(load(writeAt<std::uint64_t>(bytes, 0, 0)), std::runtime_error);
+    ASSERT_THROW(load(writeAt<std::uint32_t>(bytes, PILOT_WIDTH_AT, 0)), std::runtime_error);
+    ASSERT_THROW(load(writeAt<std::uint32_t>(bytes, PILOT_WIDTH_AT, 65)), std::runtime_error);
+    ASSERT_THROW(load(writeAt<std::uint32_t>(bytes, DENSE_BUCKET_COUNT_AT, buckets)), std::runtime_error);
+    ASSERT_THROW(load(writeAt<std::uint32_t>(bytes, TABLE_SIZE_AT, n - 1)), std::runtime_error);
+    ASSERT_THROW(load(writeAt<std::uint32_t>(bytes, NUMBER_OF_ELEMENTS_AT, 0xffffffffu)), std::runtime_error);
+}
+
+
+TEST(PerfectHashSetTests, hugeVectorSizeIsRejectedWithoutAllocatingIt)
+{
+    std::string bytes = save(PerfectHashSet{makeWords(200)});
+    for (std::size_t at : vectorPositions(bytes))
+    {
+        ASSERT_THROW(load(writeAt<std::uint64_t>(bytes, at, 1ull << 40)), std::runtime_error);
+        ASSERT_THROW(load(writeAt<std::uint64_t>(bytes, at, 0xffffffffull)), std::runtime_error);
+    }
+}
+
+
+TEST(PerfectHashSetTests, outOfRangeSlotsAndOffsetsAreRejected)
+{
+    std::string bytes = save(PerfectHashSet{makeWords(200)});
+    std::uint32_t n = readAt<std::uint32_t>(bytes, NUMBER_OF_ELEMENTS_AT);
+    std::vector<std::size_t> positions = vectorPositions(bytes);
+    std::size_t freeSlotsAt = positions[1] + 8;
+    std::size_t offsetsAt = positions[2] + 8;
+    ASSERT_LT(0u, readAt<std::uint64_t>(bytes, positions[1]));
+
+    ASSERT_THROW(load(writeAt<std::uint32_t>(bytes, freeSlotsAt, n)), std::runtime_error);
+    ASSERT_THROW(load(writeAt<std::uint32_t>(bytes, offsetsAt + 4 * n, 0xffffffffu)), std::runtime_error);
+    ASSERT_THROW(
+        load(writeAt<std::uint32_t>(bytes, offsetsAt + 4, readAt<std::uint32_t>(bytes, offsetsAt + 8) + 1)),
+        std::runtime_error);
+}
+
+
+TEST(PerfectHashSetTests, anyCorruptedByteIsRejectedOrLookedUpSafely)
+{
+    // a set built from a stream with one byte changed may give wrong
+    // answers, but if it's accepted at all, looking up in it must stay
+    // within its own memory, which ASan checks
+    std::vector<std::string> words = makeWords(50);
+    std::string bytes = save(PerfectHashSet{words});
+    for (std::size_t at = 0; at < bytes.size(); at++)
+    {
+        std::string corrupted = bytes;
+        corrupted[at] ^= 0x5a;
+        try
+        {
+            PerfectHashSet set = load(corrupted);
+            for (const std::string& word : words)
+            {
+                set.contains(word);
+                set.contains(word + "x");
+            }
+        }
+        catch (std::runtime_error&)
+        {
+        }
+    }
+}
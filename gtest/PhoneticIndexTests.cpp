@@ -0,0 +1,60 @@
+// PhoneticIndexTests.cpp
+//
+// ICS 46 Spring 2015
+// Project #3: Set the Controls for the Heart of the Sun
+//
+// Checks that PhoneticIndex gives words that sound alike the same key,
+// whatever their case, and that a lookup finds exactly the indexed words
+// that share a word's key, in ascending order and no more than its limit
+// of them.
+
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+#include "PhoneticIndex.hpp"
+
+
+namespace
+{
+    std::vector<std::string> soundAlikes(
+        const PhoneticIndex& index, const std::string& word, unsigned int limit)
+    {
+        std::vector<std::string> found;
+        unsigned int count = index.forEachSoundAlike(
+            word, limit,
+            [&](const char* characters, std::size_t length) { found.emplace_back(characters, length); });
+        EXPECT_EQ(found.size(), count);
+        return found;
+    }
+}
+
+
+TEST(PhoneticIndexTests, soundAlikeSpellingsShareKey)
+{
+    ASSERT_EQ(PhoneticIndex::encode("PHONETIC"), PhoneticIndex::encode("FONETIK"));
+    ASSERT_EQ(PhoneticIndex::encode("PHONETIC"), PhoneticIndex::encode("phonetic"));
+    ASSERT_EQ(PhoneticIndex::encode("NIGHT"), PhoneticIndex::encode("KNIGHT"));
+    ASSERT_NE(PhoneticIndex::encode("PHONETIC"), PhoneticIndex::encode("MAGNETIC"));
+}
+
+
+TEST(PhoneticIndexTests, keysAreCutOff)
+{
+    char key[PhoneticIndex::MAX_KEY_LENGTH];
+    unsigned int length = PhoneticIndex::encode("BDFGJKLMNPQRSTVXZBDFGJKLM", key);
+    ASSERT_EQ(PhoneticIndex::MAX_KEY_LENGTH, length);
+    ASSERT_EQ(std::string(key, length), PhoneticIndex::encode("BDFGJKLMNPQRSTVXZBDFGJKLM"));
+}
+
+
+TEST(PhoneticIndexTests, lookupFindsWordsWithSameKeyInOrder)
+{
+    PhoneticIndex index{{"PHONETIC", "MAGNETIC", "FONETIC", "PHONETIC", "KNIGHT", "NIGHT", "NITE"}};
+    ASSERT_EQ(6u, index.size());
+
+    ASSERT_EQ((std::vector<std::string>{"FONETIC", "PHONETIC"}), soundAlikes(index, "FONETIK", 10));
+    ASSERT_EQ((std::vector<std::string>{"FONETIC"}), soundAlikes(index, "FONETIK", 1));
+    ASSERT_EQ((std::vector<std::string>{"KNIGHT", "NIGHT", "NITE"}), soundAlikes(index, "nyte", 10));
+    ASSERT_TRUE(soundAlikes(index, "ZEBRA", 10).empty());
+    ASSERT_TRUE(soundAlikes(index, "FONETIK", 0).empty());
+}
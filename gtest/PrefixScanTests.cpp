@@ -0,0 +1,113 @@
+// PrefixScanTests.cpp
+//
+// ICS 46 Spring 2015
+// Project #3: Set the Controls for the Heart of the Sun
+//
+// Checks that forEachWithPrefix() visits exactly the elements that begin
+// with a prefix, in ascending order and no more than its limit of them,
+// in each of the ordered sets, including a BSTSet whose Splay mode has
+// left it as tall as a chain.
+
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+#include "AVLSet.hpp"
+#include "BSTSet.hpp"
+#include "SkipListSet.hpp"
+
+
+namespace
+{
+    // enough nodes that visiting them recursively would overflow the stack
+    const unsigned int CHAIN_LENGTH = 300000;
+
+
+    // adds the same words, in an order that's neither ascending nor
+    // descending, to any of the ordered sets
+    template <typename SetType>
+    void addWords(SetType& set)
+    {
+        for (const char* word : {"car", "cart", "apple", "carbon", "cat", "ca", "dog", "c", "cartoon", "b"})
+        {
+            set.add(word);
+        }
+    }
+
+
+    template <typename SetType>
+    std::vector<std::string> scan(const SetType& set, const std::string& prefix, unsigned int limit)
+    {
+        std::vector<std::string> found;
+        unsigned int count = set.forEachWithPrefix(
+            prefix, limit, [&](const std::string& element) { found.push_back(element); });
+        EXPECT_EQ(found.size(), count);
+        return found;
+    }
+
+
+    template <typename SetType>
+    void checkScans(const SetType& set)
+    {
+        ASSERT_EQ((std::vector<std::string>{"car", "carbon", "cart", "cartoon"}), scan(set, "car", 10));
+        ASSERT_EQ((std::vector<std::string>{"car", "carbon"}), scan(set, "car", 2));
+        ASSERT_EQ((std::vector<std::string>{"cart", "cartoon"}), scan(set, "cart", 10));
+        ASSERT_EQ((std::vector<std::string>{"c", "ca", "car", "carbon", "cart", "cartoon", "cat"}),
+            scan(set, "c", 10));
+        ASSERT_EQ((std::vector<std::string>{"dog"}), scan(set, "dog", 10));
+        ASSERT_TRUE(scan(set, "cab", 10).empty());
+        ASSERT_TRUE(scan(set, "z", 10).empty());
+        ASSERT_TRUE(scan(set, "car", 0).empty());
+        ASSERT_EQ(10u, scan(set, "", 20).size());
+    }
+}
+
+
+TEST(PrefixScanTests, bstSetScansPrefixesInOrder)
+{
+    BSTSet<std::string> set;
+    addWords(set);
+    checkScans(set);
+}
+
+
+TEST(PrefixScanTests, avlSetScansPrefixesInOrder)
+{
+    AVLSet<std::string> set;
+    addWords(set);
+    checkScans(set);
+}
+
+
+TEST(PrefixScanTests, skipListSetScansPrefixesInOrder)
+{
+    SkipListSet<std::string> set;
+    addWords(set);
+    checkScans(set);
+}
+
+
+TEST(PrefixScanTests, emptySetsFindNothing)
+{
+    ASSERT_TRUE(scan(BSTSet<std::string>{}, "a", 10).empty());
+    ASSERT_TRUE(scan(AVLSet<std::string>{}, "a", 10).empty());
+    ASSERT_TRUE(scan(SkipListSet<std::string>{}, "a", 10).empty());
+}
+
+
+TEST(PrefixScanTests, chainShapedBSTSetCanBeScanned)
+{
+    // words added in ascending order, so that splaying each one to the
+    // root leaves the tree a chain of left children
+    BSTSet<std::string> set;
+    set.setAdjustment(BSTAdjustment::Splay);
+    for (unsigned int i = 0; i < CHAIN_LENGTH; i++)
+    {
+        set.add("W" + std::to_string(100000000 + i));
+    }
+
+    ASSERT_EQ(
+        (std::vector<std::string>{"W100000100", "W100000101", "W100000102", "W100000103", "W100000104"}),
+        scan(set, "W1000001", 5));
+    ASSERT_EQ(100u, scan(set, "W1002999", 1000).size());
+    ASSERT_EQ(CHAIN_LENGTH, scan(set, "W", CHAIN_LENGTH + 1).size());
+}
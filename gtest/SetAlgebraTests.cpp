@@ -0,0 +1,57 @@
+// SetAlgebraTests.cpp
+//
+// ICS 46 Spring 2015
+// Project #3: Set the Controls for the Heart of the Sun
+//
+// Checks that differenceOf() works when the set being looked in is only
+// known as a Set, whose contains() is pure virtual, whether the set being
+// walked is a HashSet, probed a slice per thread, or any other.
+
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+#include "AVLSet.hpp"
+#include "HashSet.hpp"
+#include "SetAlgebra.hpp"
+
+
+namespace
+{
+    class SetAlgebraTests : public ::testing::Test
+    {
+    protected:
+        SetAlgebraTests()
+        {
+            for (unsigned int i = 0; i < 100; i++)
+            {
+                hashed.add("h" + std::to_string(i));
+                ordered.add((i % 2 == 0 ? "h" : "a") + std::to_string(i));
+            }
+        }
+
+        HashSet<std::string> hashed;
+        AVLSet<std::string> ordered;
+    };
+}
+
+
+TEST_F(SetAlgebraTests, hashSetCanBeProbedAgainstAbstractSet)
+{
+    const Set<std::string>& other = ordered;
+    unsigned int count = 0;
+    differenceOf(hashed, other, [&](const std::string&) { count++; }, 4);
+    ASSERT_EQ(50u, count);
+}
+
+
+TEST_F(SetAlgebraTests, orderedSetCanBeProbedAgainstAbstractSet)
+{
+    const Set<std::string>& other = hashed;
+    std::vector<std::string> found;
+    differenceOf(ordered, other, [&](const std::string& element) { found.push_back(element); }, 1);
+    ASSERT_EQ(50u, found.size());
+    for (const std::string& element : found)
+    {
+        ASSERT_EQ('a', element[0]);
+    }
+}
@@ -0,0 +1,178 @@
+// SetMoveTests.cpp
+//
+// ICS 46 Spring 2015
+// Project #3: Set the Controls for the Heart of the Sun
+//
+// Checks that moving and swapping a set hands over its nodes without
+// copying them, by comparing the addresses of its elements before and
+// after, and that copying one copies every node.
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <string>
+#include <utility>
+#include <vector>
+#include "AVLSet.hpp"
+#include "BSTSet.hpp"
+#include "HashSet.hpp"
+#include "SkipListSet.hpp"
+
+
+namespace
+{
+    const unsigned int WORD_COUNT = 200;
+
+
+    std::vector<std::string> makeWords(const std::string& prefix)
+    {
+        std::vector<std::string> words;
+        for (unsigned int i = 0; i < WORD_COUNT; i++)
+        {
+            words.push_back(prefix + std::to_string(i * 7919 % WORD_COUNT));
+        }
+        return words;
+    }
+
+
+    template <typename SetType>
+    void addWords(SetType& set, const std::vector<std::string>& words)
+    {
+        for (const std::string& word : words)
+        {
+            set.add(word);
+        }
+    }
+
+
+    // the addresses of the elements of a set, in the order it visits them
+    template <typename SetType>
+    std::vector<const std::string*> addressesOf(const SetType& set)
+    {
+        std::vector<const std::string*> addresses;
+        for (const std::string& element : set)
+        {
+            addresses.push_back(&element);
+        }
+        return addresses;
+    }
+
+
+    // BSTSets have no Iterator, but an empty prefix visits every element
+    std::vector<const std::string*> addressesOf(const BSTSet<std::string>& set)
+    {
+        std::vector<const std::string*> addresses;
+        set.forEachWithPrefix("", set.size(),
+            [&](const std::string& element)
+            {
+                addresses.push_back(&element);
+            });
+        return addresses;
+    }
+
+
+    template <typename SetType>
+    class SetMoveTests : public ::testing::Test
+    {
+    };
+
+
+    typedef ::testing::Types<
+        AVLSet<std::string>, BSTSet<std::string>, HashSet<std::string>, SkipListSet<std::string>>
+        SetTypes;
+
+    TYPED_TEST_CASE(SetMoveTests, SetTypes);
+}
+
+
+TYPED_TEST(SetMoveTests, moveConstructionKeepsTheNodes)
+{
+    TypeParam original;
+    addWords(original, makeWords("a"));
+    std::vector<const std::string*> before = addressesOf(original);
+
+    TypeParam moved{std::move(original)};
+
+    ASSERT_EQ(WORD_COUNT, moved.size());
+    ASSERT_EQ(before, addressesOf(moved));
+    ASSERT_EQ(0, original.size());
+}
+
+
+TYPED_TEST(SetMoveTests, moveAssignmentKeepsTheNodes)
+{
+    TypeParam original;
+    addWords(original, makeWords("a"));
+    std::vector<const std::string*> before = addressesOf(original);
+
+    TypeParam target;
+    addWords(target, makeWords("b"));
+    target = std::move(original);
+
+    ASSERT_EQ(WORD_COUNT, target.size());
+    ASSERT_EQ(before, addressesOf(target));
+}
+
+
+TYPED_TEST(SetMoveTests, swapExchangesTheNodes)
+{
+    TypeParam first;
+    TypeParam second;
+    addWords(first, makeWords("a"));
+    addWords(second, makeWords("b"));
+    second.add("extra");
+    std::vector<const std::string*> firstBefore = addressesOf(first);
+    std::vector<const std::string*> secondBefore = addressesOf(second);
+
+    swap(first, second);
+
+    ASSERT_EQ(secondBefore, addressesOf(first));
+    ASSERT_EQ(firstBefore, addressesOf(second));
+    ASSERT_TRUE(first.contains("extra"));
+    ASSERT_FALSE(second.contains("extra"));
+}
+
+
+TYPED_TEST(SetMoveTests, movedFromSetCanBeUsedAgain)
+{
+    TypeParam original;
+    addWords(original, makeWords("a"));
+    TypeParam moved{std::move(original)};
+
+    addWords(original, makeWords("c"));
+
+    ASSERT_EQ(WORD_COUNT, original.size());
+    ASSERT_TRUE(original.contains("c0"));
+    ASSERT_FALSE(original.contains("a0"));
+    ASSERT_TRUE(moved.contains("a0"));
+}
+
+
+TYPED_TEST(SetMoveTests, copiesShareNoNodes)
+{
+    TypeParam original;
+    addWords(original, makeWords("a"));
+    std::vector<const std::string*> originalAddresses = addressesOf(original);
+
+    TypeParam copy{original};
+    TypeParam assigned;
+    addWords(assigned, makeWords("b"));
+    assigned = original;
+
+    for (const TypeParam* set : {&copy, &assigned})
+    {
+        std::vector<const std::string*> addresses = addressesOf(*set);
+        ASSERT_EQ(originalAddresses.size(), addresses.size());
+        for (unsigned int i = 0; i < addresses.size(); i++)
+        {
+            ASSERT_EQ(*originalAddresses[i], *addresses[i]);
+            ASSERT_EQ(
+                originalAddresses.end(),
+                std::find(originalAddresses.begin(), originalAddresses.end(), addresses[i]));
+        }
+    }
+
+    copy.add("onlyInTheCopy");
+    ASSERT_TRUE(copy.contains("onlyInTheCopy"));
+    ASSERT_FALSE(original.contains("onlyInTheCopy"));
+    ASSERT_FALSE(assigned.contains("onlyInTheCopy"));
+}
@@ -0,0 +1,139 @@
+// ShardedHashSetTests.cpp
+//
+// ICS 46 Spring 2015
+// Project #3: Set the Controls for the Heart of the Sun
+//
+// Checks that a ShardedHashSet keeps every element added to it by several
+// threads at once, and that readers calling contains() alongside them
+// always find the elements already added, while every shard is resized
+// many times underneath them.  It's meant to be run under ASan or TSan
+// as well, which catch a reader walking a table after it's been freed.
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+#include "ShardedHashSet.hpp"
+
+
+namespace
+{
+    const unsigned int WRITER_COUNT = 2;
+    const unsigned int READER_COUNT = 2;
+
+    // few shards and many words, so that each shard grows from its
+    // default capacity through a dozen or so resizes
+    const unsigned int SHARD_COUNT = 4;
+    const unsigned int WORDS_PER_WRITER = 40000;
+
+
+    std::string wordFor(unsigned int writer, unsigned int i)
+    {
+        return "w" + std::to_string(writer) + "-" + std::to_string(i);
+    }
+}
+
+
+TEST(ShardedHashSetTests, concurrentAddsAndLookupsLoseNothing)
+{
+    ShardedHashSet<std::string> set{SHARD_COUNT};
+
+    // each writer publishes how many of its words it has added, so that
+    // readers know which ones must already be found
+    std::atomic<unsigned int> added[WRITER_COUNT];
+    for (std::atomic<unsigned int>& count : added)
+    {
+        count.store(0);
+    }
+    std::atomic<bool> writing{true};
+    std::atomic<unsigned int> missed{0};
+    std::atomic<unsigned int> falseHits{0};
+
+    std::vector<std::thread> threads;
+    for (unsigned int w = 0; w < WRITER_COUNT; w++)
+    {
+        threads.emplace_back(
+            [&, w]()
+            {
+                for (unsigned int i = 0; i < WORDS_PER_WRITER; i++)
+                {
+                    set.add(wordFor(w, i));
+                    added[w].store(i + 1, std::memory_order_release);
+                }
+            });
+    }
+    for (unsigned int r = 0; r < READER_COUNT; r++)
+    {
+        threads.emplace_back(
+            [&, r]()
+            {
+                unsigned int probe = r;
+                while (writing.load())
+                {
+                    unsigned int w = probe % WRITER_COUNT;
+                    unsigned int count = added[w].load(std::memory_order_acquire);
+                    if (count != 0)
+                    {
+                        // the newest word and an older one, both of which
+                        // were added before count was published
+                        if (!set.contains(wordFor(w, count - 1))
+                            || !set.contains(wordFor(w, probe % count)))
+                        {
+                            missed++;
+                        }
+                    }
+                    if (set.contains(wordFor(w, WORDS_PER_WRITER + probe % 100)))
+                    {
+                        falseHits++;
+                    }
+                    probe += 7;
+                }
+            });
+    }
+
+    for (unsigned int w = 0; w < WRITER_COUNT; w++)
+    {
+        threads[w].join();
+    }
+    writing.store(false);
+    for (unsigned int t = WRITER_COUNT; t < threads.size(); t++)
+    {
+        threads[t].join();
+    }
+
+    ASSERT_EQ(0u, missed.load());
+    ASSERT_EQ(0u, falseHits.load());
+    ASSERT_EQ(WRITER_COUNT * WORDS_PER_WRITER, set.size());
+    for (unsigned int w = 0; w < WRITER_COUNT; w++)
+    {
+        for (unsigned int i = 0; i < WORDS_PER_WRITER; i++)
+        {
+            ASSERT_TRUE(set.contains(wordFor(w, i)));
+        }
+    }
+}
+
+
+TEST(ShardedHashSetTests, concurrentAddsOfSameWordsKeepOneCopy)
+{
+    ShardedHashSet<std::string> set{SHARD_COUNT};
+    std::vector<std::thread> threads;
+    for (unsigned int t = 0; t < WRITER_COUNT + READER_COUNT; t++)
+    {
+        threads.emplace_back(
+            [&]()
+            {
+                for (unsigned int i = 0; i < WORDS_PER_WRITER / 4; i++)
+                {
+                    set.add(wordFor(0, i));
+                }
+            });
+    }
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+
+    ASSERT_EQ(WORDS_PER_WRITER / 4, set.size());
+}
@@ -0,0 +1,191 @@
+// SuggestionAllocationTests.cpp
+//
+// ICS 46 Spring 2015
+// Project #3: Set the Controls for the Heart of the Sun
+//
+// Checks that finding suggestions into a reused SuggestionBuffer does no
+// heap allocation in steady state.  The global operator new is replaced
+// here with one that counts its calls; each test checks its misspellings
+// once to warm the buffer up, then checks them again while counting, and
+// expects the count not to have moved.
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <vector>
+#include "BasicWordChecker.hpp"
+#include "HashSet.hpp"
+#include "SuggestionBuffer.hpp"
+#include "WordChecker.hpp"
+
+
+namespace
+{
+    std::atomic<unsigned long long> allocationCount{0};
+
+
+    // returns distinct five-letter uppercase words, so that the default
+    // alphabet's swaps and replacements find most of them again
+    std::vector<std::string> makeWords()
+    {
+        std::vector<std::string> words;
+        for (unsigned int i = 0; i < 2000; i++)
+        {
+            std::string word;
+            unsigned int n = i * 7919;
+            for (unsigned int j = 0; j < 5; j++)
+            {
+                word += static_cast<char>('A' + n % 26);
+                n /= 26;
+            }
+            words.push_back(word);
+        }
+        return words;
+    }
+
+
+    // returns a misspelling of each word, so that every strategy runs and
+    // finds something for most of them
+    std::vector<std::string> misspell(const std::vector<std::string>& words)
+    {
+        std::vector<std::string> misspellings;
+        for (const std::string& word : words)
+        {
+            std::string misspelled = word;
+            misspelled[misspelled.size() / 2] = '#';
+            misspellings.push_back(misspelled);
+        }
+        return misspellings;
+    }
+
+
+    HashSet<std::string> makeSet(const std::vector<std::string>& words)
+    {
+        HashSet<std::string> set;
+        for (const std::string& word : words)
+        {
+            set.add(word);
+        }
+        return set;
+    }
+
+
+    // checks every misspelling into the buffer, returning how many
+    // suggestions were found
+    template <typename CheckerType>
+    unsigned int checkAll(
+        const CheckerType& checker, const std::vector<std::string>& misspellings,
+        SuggestionBuffer& buffer)
+    {
+        unsigned int suggestions = 0;
+        for (const std::string& misspelled : misspellings)
+        {
+            checker.wordExists(misspelled);
+            checker.findSuggestions(misspelled, buffer);
+            suggestions += buffer.size();
+        }
+        return suggestions;
+    }
+}
+
+
+void* operator new(std::size_t size)
+{
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    void* p = std::malloc(size == 0 ? 1 : size);
+    if (p == NULL)
+    {
+        throw std::bad_alloc{};
+    }
+    return p;
+}
+
+
+// the nothrow form, which std::stable_sort uses for its buffer, has to
+// allocate the same way, since it's freed by the operator delete below
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    return std::malloc(size == 0 ? 1 : size);
+}
+
+
+void operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+
+void operator delete(void* p, const std::nothrow_t&) noexcept
+{
+    ::operator delete(p);
+}
+
+
+void operator delete(void* p, std::size_t) noexcept
+{
+    ::operator delete(p);
+}
+
+
+TEST(SuggestionAllocationTests, reusedBufferDoesNotAllocateInSteadyState)
+{
+    std::vector<std::string> words = makeWords();
+    std::vector<std::string> misspellings = misspell(words);
+    HashSet<std::string> set = makeSet(words);
+    BasicWordChecker<HashSet<std::string>> checker{set};
+    SuggestionBuffer buffer;
+
+    unsigned int warmed = checkAll(checker, misspellings, buffer);
+    ASSERT_LT(0u, warmed);
+
+    unsigned long long before = allocationCount.load();
+    unsigned int suggestions = checkAll(checker, misspellings, buffer);
+    unsigned long long allocations = allocationCount.load() - before;
+
+    ASSERT_EQ(warmed, suggestions);
+    ASSERT_EQ(0u, allocations);
+}
+
+
+TEST(SuggestionAllocationTests, wordCheckerDoesNotAllocateInSteadyState)
+{
+    std::vector<std::string> words = makeWords();
+    std::vector<std::string> misspellings = misspell(words);
+    HashSet<std::string> set = makeSet(words);
+    WordChecker checker{set};
+    SuggestionBuffer buffer;
+
+    // the warm-up also allocates this thread's latency counters
+    unsigned int warmed = checkAll(checker, misspellings, buffer);
+    ASSERT_LT(0u, warmed);
+
+    unsigned long long before = allocationCount.load();
+    unsigned int suggestions = checkAll(checker, misspellings, buffer);
+    unsigned long long allocations = allocationCount.load() - before;
+
+    ASSERT_EQ(warmed, suggestions);
+    ASSERT_EQ(0u, allocations);
+}
+
+
+TEST(SuggestionAllocationTests, returningVectorsDoesAllocate)
+{
+    std::vector<std::string> words = makeWords();
+    std::vector<std::string> misspellings = misspell(words);
+    HashSet<std::string> set = makeSet(words);
+    BasicWordChecker<HashSet<std::string>> checker{set};
+
+    unsigned long long before = allocationCount.load();
+    unsigned int suggestions = 0;
+    for (const std::string& misspelled : misspellings)
+    {
+        suggestions += checker.findSuggestions(misspelled).size();
+    }
+    unsigned long long allocations = allocationCount.load() - before;
+
+    ASSERT_LT(0u, suggestions);
+    ASSERT_LT(0u, allocations);
+}
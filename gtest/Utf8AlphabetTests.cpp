@@ -0,0 +1,198 @@
+// Utf8AlphabetTests.cpp
+//
+// ICS 46 Spring 2015
+// Project #3: Set the Controls for the Heart of the Sun
+//
+// Checks that a Utf8Alphabet gives exactly the characters that, put
+// between a prefix and a suffix, make one of the words it was gathered
+// from, in the same order forEachLetter() gives them, including malformed
+// bytes; and that its ASCII lookups, which go through a filter first,
+// find the same ones.
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+#include "Utf8Alphabet.hpp"
+
+
+namespace
+{
+    // a small alphabet, so that many words are one edit apart: two ASCII
+    // letters, characters of two, three and four bytes, and a byte that
+    // can't begin a character
+    const std::vector<std::string> CHARACTERS{
+        "a", "b", "\xc3\xa9", "\xc3\xbc", "\xe2\x82\xac", "\xf0\x9f\x98\x80", "\xff"};
+
+
+    std::string randomWord(std::mt19937& random)
+    {
+        std::string word;
+        for (unsigned int i = 1 + random() % 5; i > 0; i--)
+        {
+            word += CHARACTERS[random() % CHARACTERS.size()];
+        }
+        return word;
+    }
+
+
+    std::vector<std::string> lettersBetween(
+        const Utf8Alphabet& alphabet, const std::string& prefix, const std::string& suffix)
+    {
+        std::vector<std::string> found;
+        alphabet.forEachLetterBetween(
+            prefix.data(), prefix.size(), suffix.data(), suffix.size(),
+            [&](const char* characters, std::size_t length) { found.emplace_back(characters, length); });
+        return found;
+    }
+
+
+    std::vector<std::string> asciiLettersBetween(
+        const Utf8Alphabet& alphabet, const std::string& prefix, const std::string& suffix)
+    {
+        std::vector<std::string> found;
+        alphabet.forEachLetterBetweenAscii(
+            prefix.data(), prefix.size(), suffix.data(), suffix.size(),
+            [&](const char* characters, std::size_t length) { found.emplace_back(characters, length); });
+        return found;
+    }
+
+
+    // each of the alphabet's letters that makes one of the words between
+    // prefix and suffix, in the alphabet's order
+    std::vector<std::string> bruteForceLettersBetween(
+        const Utf8Alphabet& alphabet, const std::vector<std::string>& words,
+        const std::string& prefix, const std::string& suffix)
+    {
+        std::vector<std::string> found;
+        alphabet.forEachLetter(
+            [&](const char* characters, std::size_t length)
+            {
+                std::string candidate = prefix + std::string(characters, length) + suffix;
+                if (std::find(words.begin(), words.end(), candidate) != words.end())
+                {
+                    found.emplace_back(characters, length);
+                }
+            });
+        return found;
+    }
+
+
+    class Utf8AlphabetTests : public ::testing::Test
+    {
+    protected:
+        Utf8AlphabetTests()
+            : random{46}
+        {
+            for (unsigned int i = 0; i < 2000; i++)
+            {
+                words.push_back(randomWord(random));
+            }
+        }
+
+        std::mt19937 random;
+        std::vector<std::string> words;
+    };
+}
+
+
+TEST_F(Utf8AlphabetTests, sizeCountsNonAsciiCharacters)
+{
+    Utf8Alphabet alphabet{words};
+    ASSERT_EQ(5u, alphabet.size());
+}
+
+
+TEST_F(Utf8AlphabetTests, lettersBetweenMatchBruteForce)
+{
+    Utf8Alphabet alphabet{words};
+    std::vector<std::string> probes = words;
+    for (unsigned int i = 0; i < 500; i++)
+    {
+        probes.push_back(randomWord(random));
+    }
+
+    // every way of cutting each probe in two, and of taking one of its
+    // characters out, gives a prefix and a suffix
+    for (const std::string& probe : probes)
+    {
+        std::vector<unsigned int> starts;
+        unsigned int length = Utf8Alphabet::findCharacters(probe, starts);
+        for (unsigned int k = 0; k <= length; k++)
+        {
+            std::string prefix = probe.substr(0, starts[k]);
+            for (unsigned int end : {starts[k], starts[std::min(k + 1, length)]})
+            {
+                std::string suffix = probe.substr(end);
+                ASSERT_EQ(bruteForceLettersBetween(alphabet, words, prefix, suffix),
+                          lettersBetween(alphabet, prefix, suffix)) << probe << " " << k;
+            }
+        }
+    }
+}
+
+
+TEST_F(Utf8AlphabetTests, asciiLettersBetweenMatchBruteForce)
+{
+    Utf8Alphabet alphabet{words};
+
+    // the ASCII bytes on either side of each word's non-ASCII characters,
+    // and of random ASCII strings, which mostly make nothing
+    std::vector<std::pair<std::string, std::string>> surroundings;
+    for (const std::string& word : words)
+    {
+        std::vector<unsigned int> starts;
+        unsigned int length = Utf8Alphabet::findCharacters(word, starts);
+        for (unsigned int k = 0; k < length; k++)
+        {
+            std::string prefix = word.substr(0, starts[k]);
+            std::string suffix = word.substr(starts[k + 1]);
+            if (Utf8Alphabet::isAscii(prefix.data(), prefix.size())
+                && Utf8Alphabet::isAscii(suffix.data(), suffix.size()))
+            {
+                surroundings.emplace_back(prefix, suffix);
+            }
+        }
+    }
+    for (unsigned int i = 0; i < 2000; i++)
+    {
+        surroundings.emplace_back(std::string(random() % 4, 'a'), std::string(random() % 4, 'b'));
+    }
+
+    unsigned int foundCount = 0;
+    for (const std::pair<std::string, std::string>& around : surroundings)
+    {
+        std::vector<std::string> found = asciiLettersBetween(alphabet, around.first, around.second);
+        ASSERT_EQ(bruteForceLettersBetween(alphabet, words, around.first, around.second), found)
+            << around.first << " " << around.second;
+        foundCount += found.size();
+    }
+    ASSERT_LT(0u, foundCount);
+}
+
+
+TEST(Utf8AlphabetOrderTests, lettersBetweenComeInCodePointOrder)
+{
+    Utf8Alphabet alphabet{std::vector<std::string>{
+        "caf\xc3\xa9", "caf\xc3\xa8", "cafe", "caf\xe2\x82\xac", "na\xc3\xafve", "\xc3\xa9t\xc3\xa9"}};
+    ASSERT_EQ(4u, alphabet.size());
+    ASSERT_EQ((std::vector<std::string>{"\xc3\xa8", "\xc3\xa9", "\xe2\x82\xac"}),
+              lettersBetween(alphabet, "caf", ""));
+    ASSERT_EQ((std::vector<std::string>{"\xc3\xa8", "\xc3\xa9", "\xe2\x82\xac"}),
+              asciiLettersBetween(alphabet, "caf", ""));
+    ASSERT_EQ((std::vector<std::string>{"\xc3\xaf"}), asciiLettersBetween(alphabet, "na", "ve"));
+    ASSERT_EQ((std::vector<std::string>{"\xc3\xa9"}), lettersBetween(alphabet, "\xc3\xa9t", ""));
+    ASSERT_TRUE(lettersBetween(alphabet, "ca", "").empty());
+    ASSERT_TRUE(lettersBetween(alphabet, "", "caf").empty());
+}
+
+
+TEST(Utf8AlphabetOrderTests, asciiAlphabetFindsNothing)
+{
+    Utf8Alphabet alphabet{std::vector<std::string>{"cafe", "naive"}};
+    ASSERT_EQ(0u, alphabet.size());
+    ASSERT_TRUE(lettersBetween(alphabet, "caf", "").empty());
+    ASSERT_TRUE(asciiLettersBetween(alphabet, "caf", "").empty());
+}
@@ -0,0 +1,158 @@
+// WildcardIndexTests.cpp
+//
+// ICS 46 Spring 2015
+// Project #3: Set the Controls for the Heart of the Sun
+//
+// Checks that a WildcardIndex finds exactly the replacements and
+// insertions that a brute-force search of its word list finds, in the
+// same ascending order, including words with bytes of 0x80 and above.
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+#include "WildcardIndex.hpp"
+
+
+namespace
+{
+    // a small alphabet, so that many words are one edit apart, with bytes
+    // on both sides of 0x80
+    const std::string LETTERS{"abc\x80\xc3\xff"};
+
+
+    std::string randomWord(std::mt19937& random)
+    {
+        std::string word(1 + random() % 6, ' ');
+        for (char& c : word)
+        {
+            c = LETTERS[random() % LETTERS.size()];
+        }
+        return word;
+    }
+
+
+    // the distinct words, sorted, as the index keeps them
+    std::vector<std::string> sortedDistinct(std::vector<std::string> words)
+    {
+        std::sort(words.begin(), words.end());
+        words.erase(std::unique(words.begin(), words.end()), words.end());
+        return words;
+    }
+
+
+    std::vector<std::string> bruteForceReplacements(
+        const std::vector<std::string>& words, const std::string& word, std::size_t position)
+    {
+        std::vector<std::string> found;
+        for (const std::string& candidate : words)
+        {
+            if (candidate.size() == word.size()
+                && candidate.compare(0, position, word, 0, position) == 0
+                && candidate.compare(position + 1, std::string::npos, word, position + 1, std::string::npos) == 0)
+            {
+                found.push_back(candidate);
+            }
+        }
+        return found;
+    }
+
+
+    std::vector<std::string> bruteForceInsertions(
+        const std::vector<std::string>& words, const std::string& word, std::size_t position)
+    {
+        std::vector<std::string> found;
+        for (const std::string& candidate : words)
+        {
+            if (candidate.size() == word.size() + 1
+                && candidate.compare(0, position, word, 0, position) == 0
+                && candidate.compare(position + 1, std::string::npos, word, position, std::string::npos) == 0)
+            {
+                found.push_back(candidate);
+            }
+        }
+        return found;
+    }
+
+
+    class WildcardIndexTests : public ::testing::Test
+    {
+    protected:
+        WildcardIndexTests()
+            : random{46}
+        {
+            for (unsigned int i = 0; i < 3000; i++)
+            {
+                words.push_back(randomWord(random));
+            }
+            distinct = sortedDistinct(words);
+        }
+
+        std::vector<std::string> probes()
+        {
+            std::vector<std::string> result = distinct;
+            for (unsigned int i = 0; i < 1000; i++)
+            {
+                result.push_back(randomWord(random));
+            }
+            return result;
+        }
+
+        std::mt19937 random;
+        std::vector<std::string> words;
+        std::vector<std::string> distinct;
+    };
+}
+
+
+TEST_F(WildcardIndexTests, sizeCountsDistinctWords)
+{
+    WildcardIndex index{words};
+    ASSERT_EQ(distinct.size(), index.size());
+}
+
+
+TEST_F(WildcardIndexTests, replacementsMatchBruteForce)
+{
+    WildcardIndex index{words};
+    for (const std::string& word : probes())
+    {
+        for (std::size_t position = 0; position < word.size(); position++)
+        {
+            std::vector<std::string> found;
+            unsigned int count = index.forEachReplacement(
+                word, position,
+                [&](const char* characters, std::size_t length) { found.emplace_back(characters, length); });
+            ASSERT_EQ(found.size(), count);
+            ASSERT_EQ(bruteForceReplacements(distinct, word, position), found) << word << " " << position;
+        }
+    }
+}
+
+
+TEST_F(WildcardIndexTests, insertionsMatchBruteForce)
+{
+    WildcardIndex index{words};
+    for (const std::string& word : probes())
+    {
+        for (std::size_t position = 0; position <= word.size(); position++)
+        {
+            std::vector<std::string> found;
+            unsigned int count = index.forEachInsertion(
+                word, position,
+                [&](const char* characters, std::size_t length) { found.emplace_back(characters, length); });
+            ASSERT_EQ(found.size(), count);
+            ASSERT_EQ(bruteForceInsertions(distinct, word, position), found) << word << " " << position;
+        }
+    }
+}
+
+
+TEST(WildcardIndexEmptyTests, emptyIndexFindsNothing)
+{
+    WildcardIndex index{std::vector<std::string>{}};
+    ASSERT_EQ(0u, index.size());
+    ASSERT_EQ(0u, index.forEachReplacement("cat", 1, [](const char*, std::size_t) {}));
+    ASSERT_EQ(0u, index.forEachInsertion("cat", 3, [](const char*, std::size_t) {}));
+}